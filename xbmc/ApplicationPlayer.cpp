@@ -867,6 +867,16 @@ bool CApplicationPlayer::IsRenderingVideo()
     return false;
 }
 
+bool CApplicationPlayer::GetRenderTimings(std::vector<CRenderTimings::SFrameTiming>& frames,
+                                          CRenderTimings::SStatistics& statistics)
+{
+  std::shared_ptr<IPlayer> player = GetInternal();
+  if (player)
+    return player->GetRenderTimings(frames, statistics);
+  else
+    return false;
+}
+
 bool CApplicationPlayer::IsRenderingGuiLayer()
 {
   std::shared_ptr<IPlayer> player = GetInternal();
@@ -55,6 +55,8 @@ public:
   float GetRenderAspectRatio();
   void TriggerUpdateResolution();
   bool IsRenderingVideo();
+  bool GetRenderTimings(std::vector<CRenderTimings::SFrameTiming>& frames,
+                        CRenderTimings::SStatistics& statistics);
   bool IsRenderingGuiLayer();
   bool IsRenderingVideoLayer();
   bool Supports(EINTERLACEMETHOD method);
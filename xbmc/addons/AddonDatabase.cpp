@@ -14,6 +14,7 @@
 #include "addons/addoninfo/AddonInfoBuilder.h"
 #include "dbwrappers/dataset.h"
 #include "filesystem/SpecialProtocol.h"
+#include "utils/Digest.h"
 #include "utils/JSONVariantParser.h"
 #include "utils/JSONVariantWriter.h"
 #include "utils/StringUtils.h"
@@ -22,9 +23,11 @@
 
 #include <algorithm>
 #include <iterator>
+#include <map>
 #include <utility>
 
 using namespace ADDON;
+using KODI::UTILITY::CDigest;
 
 static std::string SerializeMetadata(const IAddon& addon)
 {
@@ -73,6 +76,19 @@ static std::string SerializeMetadata(const IAddon& addon)
   return json;
 }
 
+static std::string RowDigest(const std::string& metadata, const std::string& name,
+                             const std::string& summary, const std::string& description,
+                             const std::string& news)
+{
+  CDigest digest{CDigest::Type::MD5};
+  for (const std::string* value : {&metadata, &name, &summary, &description, &news})
+  {
+    digest.Update(*value);
+    digest.Update("\0", 1);
+  }
+  return digest.Finalize();
+}
+
 static void DeserializeMetadata(const std::string& document, CAddonInfoBuilder::CFromDB& builder)
 {
   CVariant variant;
@@ -695,21 +711,116 @@ bool CAddonDatabase::UpdateRepositoryContent(const std::string& repository, cons
     if (!m_pDS)
       return false;
 
-    DeleteRepository(repository);
-
     int idRepo = SetLastChecked(repository, version, CDateTime::GetCurrentDateTime().GetAsDBDateTime());
     if (idRepo < 0)
       return false;
     assert(idRepo > 0);
 
+    // Only touch the rows that changed since the last update instead of
+    // rewriting the whole repository, large repositories rarely change much.
+    struct ExistingRow
+    {
+      int id;
+      std::string digest;
+      bool keep;
+    };
+    std::map<std::pair<std::string, std::string>, ExistingRow> existing;
+    std::vector<int> duplicates;
+
+    m_pDS->query(PrepareSQL("SELECT addons.id, addons.addonID, addons.version, addons.metadata, "
+                            "addons.name, addons.summary, addons.description, addons.news "
+                            "FROM addons JOIN addonlinkrepo ON addons.id=addonlinkrepo.idAddon "
+                            "WHERE addonlinkrepo.idRepo=%i", idRepo));
+    while (!m_pDS->eof())
+    {
+      const std::string digest = RowDigest(m_pDS->fv(3).get_asString(), m_pDS->fv(4).get_asString(),
+                                           m_pDS->fv(5).get_asString(), m_pDS->fv(6).get_asString(),
+                                           m_pDS->fv(7).get_asString());
+      const auto key = std::make_pair(m_pDS->fv(1).get_asString(), m_pDS->fv(2).get_asString());
+      const auto it = existing.find(key);
+      if (it != existing.end())
+        duplicates.push_back(it->second.id);
+      existing[key] = ExistingRow{m_pDS->fv(0).get_asInt(), digest, false};
+      m_pDS->next();
+    }
+    m_pDS->close();
+
+    size_t added = 0;
+    size_t updated = 0;
+    size_t removed = 0;
+
+    const auto updateRow = [&](ExistingRow& row, const IAddon& addon, const std::string& metadata,
+                               const std::string& digest) {
+      m_pDS->exec(PrepareSQL("UPDATE addons SET metadata='%s', version='%s', name='%s', "
+                             "summary='%s', description='%s', news='%s' WHERE id=%i",
+                             metadata.c_str(),
+                             addon.Version().asString().c_str(),
+                             addon.Name().c_str(),
+                             addon.Summary().c_str(),
+                             addon.Description().c_str(),
+                             addon.ChangeLog().c_str(),
+                             row.id));
+      row.digest = digest;
+      row.keep = true;
+      updated++;
+    };
+
     m_pDB->start_transaction();
     m_pDS->exec(PrepareSQL("UPDATE repo SET checksum='%s' WHERE id='%d'", checksum.c_str(), idRepo));
+
+    // versions already stored are kept, and only rewritten if their content changed
+    std::vector<AddonPtr> newVersions;
     for (const auto& addon : addons)
     {
+      auto it = existing.find(std::make_pair(addon->ID(), addon->Version().asString()));
+      if (it == existing.end())
+      {
+        newVersions.push_back(addon);
+        continue;
+      }
+
+      const std::string metadata = SerializeMetadata(*addon);
+      const std::string digest = RowDigest(metadata, addon->Name(), addon->Summary(),
+                                           addon->Description(), addon->ChangeLog());
+      it->second.keep = true;
+      if (it->second.digest != digest)
+        updateRow(it->second, *addon, metadata, digest);
+    }
+
+    // a new version takes over the row of a version of the same add-on that is no longer listed,
+    // so an add-on update is a single UPDATE and keeps its id
+    for (const auto& addon : newVersions)
+    {
+      const auto key = std::make_pair(addon->ID(), addon->Version().asString());
+      const std::string metadata = SerializeMetadata(*addon);
+      const std::string digest = RowDigest(metadata, addon->Name(), addon->Summary(),
+                                           addon->Description(), addon->ChangeLog());
+
+      auto it = existing.find(key);
+      if (it != existing.end())
+      {
+        // listed twice in the index
+        if (it->second.digest != digest)
+          updateRow(it->second, *addon, metadata, digest);
+        continue;
+      }
+
+      it = existing.lower_bound(std::make_pair(addon->ID(), std::string()));
+      while (it != existing.end() && it->first.first == addon->ID() && it->second.keep)
+        ++it;
+      if (it != existing.end() && it->first.first == addon->ID())
+      {
+        ExistingRow row = it->second;
+        existing.erase(it);
+        updateRow(row, *addon, metadata, digest);
+        existing[key] = row;
+        continue;
+      }
+
       m_pDS->exec(PrepareSQL(
           "INSERT INTO addons (id, metadata, addonID, version, name, summary, description, news) "
           "VALUES (NULL, '%s', '%s', '%s', '%s','%s', '%s','%s')",
-          SerializeMetadata(*addon).c_str(),
+          metadata.c_str(),
           addon->ID().c_str(),
           addon->Version().asString().c_str(),
           addon->Name().c_str(),
@@ -726,9 +837,27 @@ bool CAddonDatabase::UpdateRepositoryContent(const std::string& repository, cons
       }
 
       m_pDS->exec(PrepareSQL("INSERT INTO addonlinkrepo (idRepo, idAddon) VALUES (%i, %i)", idRepo, idAddon));
+      existing[key] = ExistingRow{idAddon, digest, true};
+      added++;
+    }
+
+    for (const auto& row : existing)
+    {
+      if (!row.second.keep)
+        duplicates.push_back(row.second.id);
     }
 
+    for (int idAddon : duplicates)
+    {
+      m_pDS->exec(PrepareSQL("DELETE FROM addons WHERE id=%i", idAddon));
+      m_pDS->exec(PrepareSQL("DELETE FROM addonlinkrepo WHERE idRepo=%i AND idAddon=%i", idRepo, idAddon));
+    }
+    removed = duplicates.size();
+
     m_pDB->commit_transaction();
+
+    CLog::Log(LOGDEBUG, "CAddonDatabase::{}: repo '{}' {} added, {} updated, {} removed",
+              __FUNCTION__, repository, added, updated, removed);
     return true;
   }
   catch (...)
@@ -17,6 +17,7 @@
 #include "filesystem/Directory.h"
 #include "filesystem/File.h"
 #include "filesystem/SpecialProtocol.h"
+#include "threads/SystemClock.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
 #include "utils/XMLUtils.h"
@@ -112,8 +113,14 @@ bool CAddonMgr::Init()
   if (!m_database.Open())
     CLog::Log(LOGFATAL, "ADDONS: Failed to open database");
 
+  const auto start = XbmcThreads::SystemClockMillis();
+
   FindAddons();
 
+  CLog::Log(LOGDEBUG, "CAddonMgr::{}: found {} add-ons in {} ms ({} cached, {} parsed)", __FUNCTION__,
+            m_installedAddons.size(), XbmcThreads::SystemClockMillis() - start,
+            m_addonInfoCache.GetHits(), m_addonInfoCache.GetMisses());
+
   //Ensure required add-ons are installed and enabled
   for (const auto& id : m_systemAddons)
   {
@@ -402,6 +409,7 @@ bool CAddonMgr::FindAddons()
   FindAddons(installedAddons, "special://xbmcbin/addons");
   FindAddons(installedAddons, "special://xbmc/addons");
   FindAddons(installedAddons, "special://home/addons");
+  m_addonInfoCache.Save();
 
   std::set<std::string> installed;
   for (const auto& addon : installedAddons)
@@ -812,7 +820,7 @@ void CAddonMgr::FindAddons(ADDON_INFO_LIST& addonmap, const std::string& path)
       std::string path = items[i]->GetPath();
       if (XFILE::CFile::Exists(path + "addon.xml"))
       {
-        AddonInfoPtr addonInfo = CAddonInfoBuilder::Generate(path);
+        AddonInfoPtr addonInfo = m_addonInfoCache.Generate(path);
         if (addonInfo)
         {
           const auto& it = addonmap.find(addonInfo->ID());
@@ -11,6 +11,7 @@
 #include "Addon.h"
 #include "AddonDatabase.h"
 #include "Repository.h"
+#include "addoninfo/AddonInfoCache.h"
 #include "threads/CriticalSection.h"
 #include "utils/EventStream.h"
 
@@ -258,6 +259,7 @@ namespace ADDON
     std::set<std::string> m_systemAddons;
     std::set<std::string> m_optionalAddons;
     ADDON_INFO_LIST m_installedAddons;
+    CAddonInfoCache m_addonInfoCache{"special://temp/addoninfo.cache"};
   };
 
 }; /* namespace ADDON */
@@ -55,6 +55,7 @@ typedef std::map<std::string, std::string> InfoMap;
 typedef std::map<std::string, std::string> ArtMap;
 
 class CAddonInfoBuilder;
+class CAddonInfoCache;
 
 class CAddonInfo
 {
@@ -121,6 +122,7 @@ public:
 
 private:
   friend class CAddonInfoBuilder;
+  friend class CAddonInfoCache;
 
   std::string m_id;
   TYPE m_mainType = ADDON_UNKNOWN;
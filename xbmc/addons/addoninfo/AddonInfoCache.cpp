@@ -0,0 +1,384 @@
+/*
+ *  Copyright (C) 2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "AddonInfoCache.h"
+
+#include "CompileInfo.h"
+#include "addons/addoninfo/AddonInfoBuilder.h"
+#include "addons/addoninfo/AddonType.h"
+#include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
+#include "threads/SingleLock.h"
+#include "utils/Archive.h"
+#include "utils/URIUtils.h"
+#include "utils/log.h"
+
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+const std::string CACHE_MAGIC = "KodiAddonInfoCache";
+// Increase whenever the layout of the archived add-on information changes
+constexpr int CACHE_VERSION = 2;
+// Upper bound for the element counts within an add-on, far above what any manifest has
+constexpr unsigned int MAX_COUNT = 10000;
+// Every cache entry takes at least this many bytes, which bounds the entry count by the file size
+constexpr unsigned int MIN_ENTRY_SIZE = 64;
+
+std::string GetBuildId()
+{
+  return std::string(CCompileInfo::GetSCMID()) + " " + CCompileInfo::GetBuildDate();
+}
+
+// a corrupt count would make loading allocate and loop for ages before the trailer tells
+unsigned int ReadCount(CArchive& ar, unsigned int maxCount)
+{
+  unsigned int count;
+  ar >> count;
+  if (count > maxCount)
+    throw std::out_of_range("Count too large");
+  return count;
+}
+
+template<class MAP>
+void ArchiveStringMap(CArchive& ar, MAP& map)
+{
+  if (ar.IsStoring())
+  {
+    ar << static_cast<unsigned int>(map.size());
+    for (const auto& it : map)
+      ar << it.first << it.second;
+  }
+  else
+  {
+    const unsigned int count = ReadCount(ar, MAX_COUNT);
+    map.clear();
+    for (unsigned int i = 0; i < count; ++i)
+    {
+      std::string key, value;
+      ar >> key >> value;
+      map.emplace(std::move(key), std::move(value));
+    }
+  }
+}
+
+void ArchiveVersion(CArchive& ar, ADDON::AddonVersion& version)
+{
+  if (ar.IsStoring())
+  {
+    ar << version.asString();
+  }
+  else
+  {
+    std::string str;
+    ar >> str;
+    version = ADDON::AddonVersion(str);
+  }
+}
+}
+
+namespace ADDON
+{
+
+CAddonInfoCache::CAddonInfoCache(std::string cacheFile) : m_cacheFile(std::move(cacheFile))
+{
+}
+
+AddonInfoPtr CAddonInfoCache::Generate(const std::string& addonPath)
+{
+  struct __stat64 st;
+  if (XFILE::CFile::Stat(URIUtils::AddFileToFolder(addonPath, "addon.xml"), &st) != 0)
+    return nullptr;
+
+  // key by real path, the cached information contains paths derived from it
+  const std::string key = CSpecialProtocol::TranslatePath(addonPath);
+
+  CSingleLock lock(m_critSection);
+
+  if (!m_loaded)
+    Load();
+
+  CacheEntry& entry = m_entries[key];
+  entry.used = true;
+
+  if (entry.info && entry.mtime == st.st_mtime && entry.size == st.st_size)
+  {
+    m_hits++;
+    // callers attach install data to the returned info, so never hand out the cached one
+    return std::make_shared<CAddonInfo>(*entry.info);
+  }
+
+  m_misses++;
+  m_changed = true;
+
+  AddonInfoPtr addonInfo = CAddonInfoBuilder::Generate(addonPath);
+  if (!addonInfo)
+  {
+    m_entries.erase(key);
+    return nullptr;
+  }
+
+  entry.mtime = st.st_mtime;
+  entry.size = st.st_size;
+  entry.info = std::make_shared<CAddonInfo>(*addonInfo);
+
+  return addonInfo;
+}
+
+void CAddonInfoCache::Load()
+{
+  m_loaded = true;
+
+  XFILE::CFile file;
+  if (!file.Open(m_cacheFile))
+    return;
+
+  try
+  {
+    CArchive ar(&file, CArchive::load);
+
+    std::string magic, buildId;
+    int version;
+    ar >> magic >> version >> buildId;
+    if (magic != CACHE_MAGIC || version != CACHE_VERSION || buildId != GetBuildId())
+    {
+      CLog::Log(LOGDEBUG, "CAddonInfoCache::{}: ignoring outdated cache '{}'", __FUNCTION__, m_cacheFile);
+      return;
+    }
+
+    std::map<std::string, CacheEntry> entries;
+    const unsigned int count =
+        ReadCount(ar, static_cast<unsigned int>(file.GetLength() / MIN_ENTRY_SIZE));
+    for (unsigned int i = 0; i < count; ++i)
+    {
+      std::string path;
+      CacheEntry entry;
+      entry.info = std::make_shared<CAddonInfo>();
+      ar >> path >> entry.mtime >> entry.size;
+      Archive(ar, *entry.info);
+      entries.emplace(std::move(path), std::move(entry));
+    }
+
+    // reads past the end of a truncated file return zeros, only the trailer tells it's complete
+    std::string trailer;
+    unsigned int trailerCount;
+    ar >> trailer >> trailerCount;
+    if (trailer != CACHE_MAGIC || trailerCount != count)
+    {
+      CLog::Log(LOGERROR, "CAddonInfoCache::{}: incomplete cache '{}'", __FUNCTION__, m_cacheFile);
+      return;
+    }
+
+    m_entries = std::move(entries);
+  }
+  catch (const std::exception&)
+  {
+    CLog::Log(LOGERROR, "CAddonInfoCache::{}: corrupt cache '{}'", __FUNCTION__, m_cacheFile);
+    m_entries.clear();
+  }
+}
+
+void CAddonInfoCache::Save()
+{
+  CSingleLock lock(m_critSection);
+
+  for (auto it = m_entries.begin(); it != m_entries.end();)
+  {
+    if (!it->second.used)
+    {
+      it = m_entries.erase(it);
+      m_changed = true;
+    }
+    else
+    {
+      it->second.used = false;
+      ++it;
+    }
+  }
+
+  if (!m_changed)
+    return;
+
+  // write a new file and replace the old one with it, so an interrupted write never leaves
+  // a partial cache behind
+  const std::string tempFile = m_cacheFile + ".tmp";
+  XFILE::CFile file;
+  if (!file.OpenForWrite(tempFile, true))
+  {
+    CLog::Log(LOGERROR, "CAddonInfoCache::{}: unable to write '{}'", __FUNCTION__, tempFile);
+    return;
+  }
+
+  CArchive ar(&file, CArchive::store);
+  ar << CACHE_MAGIC << CACHE_VERSION << GetBuildId();
+  ar << static_cast<unsigned int>(m_entries.size());
+  for (auto& it : m_entries)
+  {
+    ar << it.first << it.second.mtime << it.second.size;
+    Archive(ar, *it.second.info);
+  }
+  ar << CACHE_MAGIC << static_cast<unsigned int>(m_entries.size());
+  ar.Close();
+  file.Close();
+
+  // renaming doesn't replace an existing file on every platform
+  if (!XFILE::CFile::Rename(tempFile, m_cacheFile) &&
+      !(XFILE::CFile::Delete(m_cacheFile) && XFILE::CFile::Rename(tempFile, m_cacheFile)))
+  {
+    CLog::Log(LOGERROR, "CAddonInfoCache::{}: unable to replace '{}'", __FUNCTION__, m_cacheFile);
+    XFILE::CFile::Delete(tempFile);
+    return;
+  }
+
+  m_changed = false;
+}
+
+void CAddonInfoCache::Archive(CArchive& ar, CAddonInfo& info)
+{
+  // install data (dates, origin) comes from the database and isn't cached
+  if (ar.IsStoring())
+  {
+    ar << info.m_id;
+    ar << static_cast<int>(info.m_mainType);
+    ar << static_cast<unsigned int>(info.m_types.size());
+    for (auto& type : info.m_types)
+      Archive(ar, type);
+    ar << static_cast<unsigned int>(info.m_dependencies.size());
+    for (const auto& dependency : info.m_dependencies)
+    {
+      ar << dependency.id << dependency.versionMin.asString() << dependency.version.asString();
+      ar << dependency.optional;
+    }
+  }
+  else
+  {
+    int mainType;
+    ar >> info.m_id;
+    ar >> mainType;
+    info.m_mainType = static_cast<TYPE>(mainType);
+    unsigned int count = ReadCount(ar, MAX_COUNT);
+    info.m_types.clear();
+    for (unsigned int i = 0; i < count; ++i)
+    {
+      CAddonType type;
+      Archive(ar, type);
+      info.m_types.push_back(std::move(type));
+    }
+    count = ReadCount(ar, MAX_COUNT);
+    info.m_dependencies.clear();
+    for (unsigned int i = 0; i < count; ++i)
+    {
+      std::string id, versionMin, version;
+      bool optional;
+      ar >> id >> versionMin >> version >> optional;
+      info.m_dependencies.emplace_back(id, AddonVersion(versionMin), AddonVersion(version), optional);
+    }
+  }
+
+  ArchiveVersion(ar, info.m_version);
+  ArchiveVersion(ar, info.m_minversion);
+  ArchiveStringMap(ar, info.m_summary);
+  ArchiveStringMap(ar, info.m_description);
+  ArchiveStringMap(ar, info.m_changelog);
+  ArchiveStringMap(ar, info.m_disclaimer);
+  ArchiveStringMap(ar, info.m_art);
+  ArchiveStringMap(ar, info.m_extrainfo);
+
+  if (ar.IsStoring())
+  {
+    ar << info.m_name << info.m_license << info.m_author << info.m_source << info.m_website;
+    ar << info.m_forum << info.m_email << info.m_path << info.m_icon << info.m_screenshots;
+    ar << info.m_broken << info.m_packageSize << info.m_libname << info.m_platforms;
+  }
+  else
+  {
+    ar >> info.m_name >> info.m_license >> info.m_author >> info.m_source >> info.m_website;
+    ar >> info.m_forum >> info.m_email >> info.m_path >> info.m_icon >> info.m_screenshots;
+    ar >> info.m_broken >> info.m_packageSize >> info.m_libname >> info.m_platforms;
+  }
+}
+
+void CAddonInfoCache::Archive(CArchive& ar, CAddonType& type)
+{
+  if (ar.IsStoring())
+  {
+    ar << static_cast<int>(type.m_type) << type.m_path << type.m_libname;
+    ar << static_cast<unsigned int>(type.m_providedSubContent.size());
+    for (const auto& content : type.m_providedSubContent)
+      ar << static_cast<int>(content);
+  }
+  else
+  {
+    int value;
+    ar >> value >> type.m_path >> type.m_libname;
+    type.m_type = static_cast<TYPE>(value);
+    const unsigned int count = ReadCount(ar, MAX_COUNT);
+    type.m_providedSubContent.clear();
+    for (unsigned int i = 0; i < count; ++i)
+    {
+      ar >> value;
+      type.m_providedSubContent.insert(static_cast<TYPE>(value));
+    }
+  }
+
+  Archive(ar, static_cast<CAddonExtensions&>(type));
+}
+
+void CAddonInfoCache::Archive(CArchive& ar, CAddonExtensions& extensions)
+{
+  if (ar.IsStoring())
+  {
+    ar << extensions.m_point;
+    ar << static_cast<unsigned int>(extensions.m_values.size());
+    for (const auto& values : extensions.m_values)
+    {
+      ar << values.first << static_cast<unsigned int>(values.second.size());
+      for (const auto& value : values.second)
+        ar << value.first << value.second.str;
+    }
+    ar << static_cast<unsigned int>(extensions.m_children.size());
+    for (auto& child : extensions.m_children)
+    {
+      ar << child.first;
+      Archive(ar, child.second);
+    }
+  }
+  else
+  {
+    ar >> extensions.m_point;
+    unsigned int count = ReadCount(ar, MAX_COUNT);
+    extensions.m_values.clear();
+    for (unsigned int i = 0; i < count; ++i)
+    {
+      std::string id;
+      ar >> id;
+      const unsigned int valueCount = ReadCount(ar, MAX_COUNT);
+      EXT_VALUE values;
+      for (unsigned int j = 0; j < valueCount; ++j)
+      {
+        std::string name, value;
+        ar >> name >> value;
+        values.emplace_back(name, SExtValue(value));
+      }
+      extensions.m_values.emplace_back(id, CExtValues(values));
+    }
+    count = ReadCount(ar, MAX_COUNT);
+    extensions.m_children.clear();
+    for (unsigned int i = 0; i < count; ++i)
+    {
+      std::string id;
+      ar >> id;
+      CAddonExtensions child;
+      Archive(ar, child);
+      extensions.m_children.emplace_back(id, std::move(child));
+    }
+  }
+}
+
+} /* namespace ADDON */
@@ -0,0 +1,82 @@
+/*
+ *  Copyright (C) 2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "addons/addoninfo/AddonInfo.h"
+#include "threads/CriticalSection.h"
+
+#include <map>
+#include <string>
+
+class CArchive;
+
+namespace ADDON
+{
+
+class CAddonExtensions;
+class CAddonType;
+
+/*!
+ * @brief Binary cache of add-on information parsed from installed addon.xml
+ * files.
+ *
+ * Entries are keyed by add-on path and validated against modification time
+ * and size of the addon.xml, so a changed manifest is always parsed again.
+ * The whole cache is invalidated by a different format version or Kodi build.
+ */
+class CAddonInfoCache
+{
+public:
+  explicit CAddonInfoCache(std::string cacheFile);
+
+  /*!
+   * @brief Get the add-on information for the add-on installed at addonPath.
+   *
+   * Returns a copy of the cached information if the addon.xml is unchanged,
+   * otherwise it is parsed with CAddonInfoBuilder and the result cached.
+   *
+   * @param addonPath path of the add-on directory
+   * @return the add-on information or nullptr if the add-on is invalid
+   */
+  AddonInfoPtr Generate(const std::string& addonPath);
+
+  /*!
+   * @brief Write the cache to disk if it changed. Entries not requested since
+   * the previous call are dropped.
+   */
+  void Save();
+
+  unsigned int GetHits() const { return m_hits; }
+  unsigned int GetMisses() const { return m_misses; }
+
+private:
+  struct CacheEntry
+  {
+    int64_t mtime = 0;
+    int64_t size = 0;
+    AddonInfoPtr info;
+    bool used = false;
+  };
+
+  void Load();
+
+  static void Archive(CArchive& ar, CAddonInfo& info);
+  static void Archive(CArchive& ar, CAddonType& type);
+  static void Archive(CArchive& ar, CAddonExtensions& extensions);
+
+  const std::string m_cacheFile;
+  CCriticalSection m_critSection;
+  std::map<std::string, CacheEntry> m_entries;
+  bool m_loaded = false;
+  bool m_changed = false;
+  unsigned int m_hits = 0;
+  unsigned int m_misses = 0;
+};
+
+} /* namespace ADDON */
@@ -72,6 +72,7 @@ typedef enum
 } TYPE;
 
 class CAddonInfoBuilder;
+class CAddonInfoCache;
 
 class CAddonType : public CAddonExtensions
 {
@@ -99,6 +100,7 @@ public:
 
 private:
   friend class CAddonInfoBuilder;
+  friend class CAddonInfoCache;
 
   void SetProvides(const std::string& content);
 
@@ -44,15 +44,35 @@ protected:
     database.UpdateRepositoryContent("repository.b", AddonVersion("1.0.0"), "test", addons);
   }
 
-  void CreateAddon(VECADDONS& addons, std::string id, std::string version)
+  void CreateAddon(VECADDONS& addons, std::string id, std::string version, std::string name = "")
   {
     CAddonInfoBuilder::CFromDB builder;
     builder.SetId(id);
     builder.SetVersion(AddonVersion(version));
+    builder.SetName(name);
     AddonPtr addon = CAddonBuilder::Generate(builder.get(), ADDON_UNKNOWN);
     addons.push_back(addon);
   }
 
+  std::string GetRowId(const std::string& id)
+  {
+    return database.GetSingleValue("addons", "id", "addonID='" + id + "'");
+  }
+
+  // count the rows rewritten by the following repository updates
+  void CountUpdates()
+  {
+    database.ExecuteQuery("CREATE TEMP TABLE IF NOT EXISTS updates (idAddon INTEGER)");
+    database.ExecuteQuery("DELETE FROM updates");
+    database.ExecuteQuery("CREATE TEMP TRIGGER IF NOT EXISTS addons_update AFTER UPDATE ON addons "
+                          "BEGIN INSERT INTO updates (idAddon) VALUES (old.id); END");
+  }
+
+  std::string GetUpdateCount()
+  {
+    return database.GetSingleValue("SELECT COUNT(*) FROM updates");
+  }
+
   void TearDown() override
   {
     database.Close();
@@ -76,3 +96,76 @@ TEST_F(AddonDatabaseTest, TestFindByNonExistingId)
   EXPECT_TRUE(database.FindByAddonId("does.not.exist", addons));
   EXPECT_EQ(0U, addons.size());
 }
+
+TEST_F(AddonDatabaseTest, TestUpdateRepositoryContentReplacesRemovedAddons)
+{
+  VECADDONS addons;
+  CreateAddon(addons, "foo.bar", "1.0.0");
+  CreateAddon(addons, "foo.qux", "2.0.0");
+  EXPECT_TRUE(database.UpdateRepositoryContent("repository.a", AddonVersion("1.0.0"), "test2", addons));
+
+  addons.clear();
+  CreateAddon(addons, "foo.qux", "2.0.0");
+  CreateAddon(addons, "foo.qux", "2.1.0");
+  EXPECT_TRUE(database.UpdateRepositoryContent("repository.a", AddonVersion("1.0.0"), "test3", addons));
+
+  addons.clear();
+  EXPECT_TRUE(database.FindByAddonId("foo.bar", addons));
+  EXPECT_EQ(0U, addons.size());
+
+  addons.clear();
+  EXPECT_TRUE(database.FindByAddonId("foo.qux", addons));
+  EXPECT_EQ(2U, addons.size());
+
+  addons.clear();
+  EXPECT_TRUE(database.FindByAddonId("foo.baz", addons));
+  EXPECT_EQ(1U, addons.size());
+}
+
+TEST_F(AddonDatabaseTest, TestUpdateRepositoryContentKeepsUnchangedAddons)
+{
+  const std::string id = GetRowId("foo.bar");
+  ASSERT_FALSE(id.empty());
+  CountUpdates();
+
+  VECADDONS addons;
+  CreateAddon(addons, "foo.bar", "1.0.0");
+  EXPECT_TRUE(database.UpdateRepositoryContent("repository.a", AddonVersion("1.0.0"), "test2", addons));
+
+  EXPECT_EQ(id, GetRowId("foo.bar"));
+  EXPECT_EQ("0", GetUpdateCount());
+}
+
+TEST_F(AddonDatabaseTest, TestUpdateRepositoryContentUpdatesChangedAddons)
+{
+  const std::string id = GetRowId("foo.bar");
+  ASSERT_FALSE(id.empty());
+  CountUpdates();
+
+  // name and metadata
+  VECADDONS addons;
+  CreateAddon(addons, "foo.bar", "1.0.0", "Foo Bar");
+  EXPECT_TRUE(database.UpdateRepositoryContent("repository.a", AddonVersion("1.0.0"), "test2", addons));
+
+  EXPECT_EQ(id, GetRowId("foo.bar"));
+  EXPECT_EQ("1", GetUpdateCount());
+
+  addons.clear();
+  EXPECT_TRUE(database.FindByAddonId("foo.bar", addons));
+  ASSERT_EQ(1U, addons.size());
+  EXPECT_EQ("Foo Bar", addons.at(0)->Name());
+
+  // version
+  addons.clear();
+  CreateAddon(addons, "foo.bar", "1.1.0", "Foo Bar");
+  EXPECT_TRUE(database.UpdateRepositoryContent("repository.a", AddonVersion("1.0.0"), "test3", addons));
+
+  EXPECT_EQ(id, GetRowId("foo.bar"));
+  EXPECT_EQ("2", GetUpdateCount());
+
+  addons.clear();
+  EXPECT_TRUE(database.FindByAddonId("foo.bar", addons));
+  ASSERT_EQ(1U, addons.size());
+  EXPECT_EQ("1.1.0", addons.at(0)->Version().asString());
+  EXPECT_EQ("Foo Bar", addons.at(0)->Name());
+}
@@ -0,0 +1,193 @@
+/*
+ *  Copyright (C) 2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "addons/addoninfo/AddonInfoCache.h"
+#include "addons/addoninfo/AddonType.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+
+#include <cstring>
+
+#include <gtest/gtest.h>
+
+using namespace ADDON;
+
+namespace
+{
+const std::string addonXML = R"xml(<?xml version="1.0" encoding="UTF-8"?>
+<addon id="metadata.cache.test"
+       name="The Cache Test Addon"
+       version="1.2.3"
+       provider-name="Team Kodi">
+  <requires>
+    <import addon="xbmc.metadata" version="2.1.0"/>
+    <import addon="plugin.video.youtube" minversion="4.4.0" version="4.4.10" optional="true"/>
+  </requires>
+  <extension point="xbmc.metadata.scraper.movies"
+             language="en"
+             library="cachetest.xml"/>
+  <extension point="kodi.addon.metadata">
+    <summary lang="en">Summary bla bla bla</summary>
+    <description lang="en">Description bla bla bla</description>
+    <platform>all</platform>
+    <language>marsian</language>
+    <license>GPL v2.0</license>
+  </extension>
+</addon>
+)xml";
+
+const std::string testPath = "special://temp/addoninfocache/";
+const std::string addonPath = testPath + "metadata.cache.test/";
+const std::string cacheFile = testPath + "addoninfo.cache";
+}
+
+class TestAddonInfoCache : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    XFILE::CDirectory::RemoveRecursive(testPath);
+    ASSERT_TRUE(XFILE::CDirectory::Create(testPath));
+    ASSERT_TRUE(XFILE::CDirectory::Create(addonPath));
+
+    XFILE::CFile file;
+    ASSERT_TRUE(file.OpenForWrite(addonPath + "addon.xml", true));
+    ASSERT_EQ(static_cast<ssize_t>(addonXML.size()), file.Write(addonXML.c_str(), addonXML.size()));
+  }
+
+  void TearDown() override
+  {
+    XFILE::CDirectory::RemoveRecursive(testPath);
+  }
+};
+
+TEST_F(TestAddonInfoCache, ReturnsCachedInfoAfterReload)
+{
+  {
+    CAddonInfoCache cache(cacheFile);
+    AddonInfoPtr addon = cache.Generate(addonPath);
+    ASSERT_NE(nullptr, addon);
+    EXPECT_EQ(0u, cache.GetHits());
+    EXPECT_EQ(1u, cache.GetMisses());
+    cache.Save();
+  }
+
+  CAddonInfoCache cache(cacheFile);
+  AddonInfoPtr addon = cache.Generate(addonPath);
+  ASSERT_NE(nullptr, addon);
+  EXPECT_EQ(1u, cache.GetHits());
+  EXPECT_EQ(0u, cache.GetMisses());
+
+  EXPECT_EQ(addon->ID(), "metadata.cache.test");
+  EXPECT_EQ(addon->Name(), "The Cache Test Addon");
+  EXPECT_EQ(addon->Version().asString(), "1.2.3");
+  EXPECT_EQ(addon->Summary(), "Summary bla bla bla");
+  EXPECT_EQ(addon->License(), "GPL v2.0");
+
+  EXPECT_EQ(addon->MainType(), ADDON_SCRAPER_MOVIES);
+  ASSERT_NE(nullptr, addon->Type(ADDON_SCRAPER_MOVIES));
+  EXPECT_EQ(addon->Type(ADDON_SCRAPER_MOVIES)->LibName(), "cachetest.xml");
+  EXPECT_EQ(addon->Type(ADDON_SCRAPER_MOVIES)->GetValue("@language").asString(), "en");
+
+  const std::vector<DependencyInfo>& dependencies = addon->GetDependencies();
+  ASSERT_EQ(dependencies.size(), 2u);
+  EXPECT_EQ(dependencies[1].id, "plugin.video.youtube");
+  EXPECT_EQ(dependencies[1].optional, true);
+  EXPECT_EQ(dependencies[1].versionMin.asString(), "4.4.0");
+  EXPECT_EQ(dependencies[1].version.asString(), "4.4.10");
+
+  auto info = addon->ExtraInfo().find("language");
+  ASSERT_NE(info, addon->ExtraInfo().end());
+  EXPECT_EQ(info->second, "marsian");
+}
+
+TEST_F(TestAddonInfoCache, ParsesAgainWhenManifestChanged)
+{
+  {
+    CAddonInfoCache cache(cacheFile);
+    ASSERT_NE(nullptr, cache.Generate(addonPath));
+    cache.Save();
+  }
+
+  std::string changedXML = addonXML;
+  changedXML.replace(changedXML.find("1.2.3"), 5, "1.2.40");
+  XFILE::CFile file;
+  ASSERT_TRUE(file.OpenForWrite(addonPath + "addon.xml", true));
+  file.Write(changedXML.c_str(), changedXML.size());
+  file.Close();
+
+  CAddonInfoCache cache(cacheFile);
+  AddonInfoPtr addon = cache.Generate(addonPath);
+  ASSERT_NE(nullptr, addon);
+  EXPECT_EQ(0u, cache.GetHits());
+  EXPECT_EQ(addon->Version().asString(), "1.2.40");
+}
+
+TEST_F(TestAddonInfoCache, IgnoresTruncatedCache)
+{
+  {
+    CAddonInfoCache cache(cacheFile);
+    ASSERT_NE(nullptr, cache.Generate(addonPath));
+    cache.Save();
+  }
+  EXPECT_FALSE(XFILE::CFile::Exists(cacheFile + ".tmp"));
+
+  XFILE::auto_buffer data;
+  XFILE::CFile file;
+  ASSERT_GT(file.LoadFile(cacheFile, data), 0);
+
+  // cut off within the trailer and within the entry
+  for (const size_t size : {data.size() - 6, data.size() / 2})
+  {
+    ASSERT_TRUE(file.OpenForWrite(cacheFile, true));
+    ASSERT_EQ(static_cast<ssize_t>(size), file.Write(data.get(), size));
+    file.Close();
+
+    CAddonInfoCache cache(cacheFile);
+    AddonInfoPtr addon = cache.Generate(addonPath);
+    ASSERT_NE(nullptr, addon);
+    EXPECT_EQ(0u, cache.GetHits());
+    EXPECT_EQ(1u, cache.GetMisses());
+    EXPECT_EQ(addon->Name(), "The Cache Test Addon");
+    EXPECT_EQ(addon->Version().asString(), "1.2.3");
+  }
+}
+
+TEST_F(TestAddonInfoCache, IgnoresCorruptCount)
+{
+  {
+    CAddonInfoCache cache(cacheFile);
+    ASSERT_NE(nullptr, cache.Generate(addonPath));
+    cache.Save();
+  }
+
+  XFILE::auto_buffer data;
+  XFILE::CFile file;
+  ASSERT_GT(file.LoadFile(cacheFile, data), 0);
+
+  // the entry count follows the magic, the version and the build id
+  uint32_t size;
+  memcpy(&size, data.get(), sizeof(size));
+  size_t offset = sizeof(size) + size + sizeof(int);
+  memcpy(&size, data.get() + offset, sizeof(size));
+  offset += sizeof(size) + size;
+  ASSERT_LT(offset + sizeof(size), data.size());
+
+  const uint32_t count = 0xFFFFFFF0;
+  memcpy(data.get() + offset, &count, sizeof(count));
+  ASSERT_TRUE(file.OpenForWrite(cacheFile, true));
+  ASSERT_EQ(static_cast<ssize_t>(data.size()), file.Write(data.get(), data.size()));
+  file.Close();
+
+  CAddonInfoCache cache(cacheFile);
+  AddonInfoPtr addon = cache.Generate(addonPath);
+  ASSERT_NE(nullptr, addon);
+  EXPECT_EQ(0u, cache.GetHits());
+  EXPECT_EQ(1u, cache.GetMisses());
+  EXPECT_EQ(addon->Version().asString(), "1.2.3");
+}
@@ -10,6 +10,7 @@
 
 #include "IPlayerCallback.h"
 #include "Interface/StreamInfo.h"
+#include "VideoRenderers/RenderTimings.h"
 #include "VideoSettings.h"
 
 #include <memory>
@@ -213,6 +214,12 @@ public:
   virtual void TriggerUpdateResolution() {};
   virtual bool IsRenderingVideo() { return false; };
 
+  /*!
+   \brief timing records of the most recently rendered frames, oldest first
+   */
+  virtual bool GetRenderTimings(std::vector<CRenderTimings::SFrameTiming>& frames,
+                                CRenderTimings::SStatistics& statistics) { return false; }
+
   virtual bool Supports(EINTERLACEMETHOD method) { return false; };
   virtual EINTERLACEMETHOD GetDeinterlacingMethodDefault() { return EINTERLACEMETHOD::VS_INTERLACEMETHOD_NONE; }
   virtual bool Supports(ESCALINGMETHOD method) { return false; };
@@ -58,6 +58,8 @@ void VideoPicture::Reset()
   iHeight = 0;
   iDisplayWidth = 0;
   iDisplayHeight = 0;
+
+  decoded = 0;
 }
 
 VideoPicture& VideoPicture::CopyRef(const VideoPicture &pic)
@@ -73,6 +73,8 @@ public:
   unsigned int iDisplayWidth;           //< width of the picture without black bars
   unsigned int iDisplayHeight;          //< height of the picture without black bars
 
+  int64_t decoded = 0;                  //< host counter when the decoder returned the picture
+
 private:
   VideoPicture(VideoPicture const&);
   VideoPicture& operator=(VideoPicture const&);
@@ -21,6 +21,7 @@
 #include "utils/log.h"
 #include "cores/VideoPlayer/VideoRenderers/RenderManager.h"
 #include "utils/StringUtils.h"
+#include "utils/TimeUtils.h"
 #include <memory>
 
 extern "C" {
@@ -36,6 +37,7 @@ extern "C" {
 #define RINT(x) ((x) >= 0 ? ((int)((x) + 0.5)) : ((int)((x) - 0.5)))
 #else
 #include <math.h>
+#include <time.h>
 #include "platform/posix/XTimeUtils.h"
 #define RINT lrint
 #endif
@@ -313,6 +315,61 @@ CDVDVideoCodecFFmpeg::~CDVDVideoCodecFFmpeg()
   Dispose();
 }
 
+namespace
+{
+// Every frame thread adds a frame of delay and a frame worth of memory. The
+// usual 1.5 threads per core keep the cores busy while threads wait for the
+// reference frames of each other, but beyond a point set by the picture size
+// more threads only add delay. The limit only applies to many core systems.
+// The count is not adapted to the measured headroom while playing: that needs
+// reopening the codec, which loses the references until the next keyframe.
+int GetDecodeThreadCount(const CDVDStreamInfo& hints)
+{
+  const int cpuCount = CServiceBroker::GetCPUInfo()->GetCPUCount();
+  const int pixels = hints.width * hints.height;
+
+  int maxThreads = 16;
+  if (pixels > 0 && pixels <= 1024 * 576)
+    maxThreads = 6;
+  else if (pixels > 0 && pixels <= 1920 * 1088 && hints.codec != AV_CODEC_ID_HEVC &&
+           hints.codec != AV_CODEC_ID_VP9 && hints.codec != AV_CODEC_ID_AV1)
+    maxThreads = 8;
+
+  return std::max(1, std::min(cpuCount * 3 / 2, maxThreads));
+}
+
+// CPU time used by the process in nanoseconds, which includes the frame threads of the decoder
+int64_t GetProcessCpuTime()
+{
+#if defined(TARGET_WINDOWS)
+  FILETIME creationTime, exitTime, kernelTime, userTime;
+  if (!GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime))
+    return 0;
+
+  ULARGE_INTEGER kernel, user;
+  kernel.LowPart = kernelTime.dwLowDateTime;
+  kernel.HighPart = kernelTime.dwHighDateTime;
+  user.LowPart = userTime.dwLowDateTime;
+  user.HighPart = userTime.dwHighDateTime;
+  return static_cast<int64_t>(kernel.QuadPart + user.QuadPart) * 100;
+#else
+  timespec time;
+  if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time) != 0)
+    return 0;
+
+  return static_cast<int64_t>(time.tv_sec) * 1000000000 + time.tv_nsec;
+#endif
+}
+
+// interval for updating the decoder headroom
+constexpr int64_t DECODE_STATS_INTERVAL_MS = 2000;
+
+// decoded frames queued for the filter thread, and filtered frames waiting for the player
+constexpr size_t FILTER_QUEUE_FRAMES = 4;
+// how long the decoder waits for the filter thread before giving up on a frame
+constexpr unsigned int FILTER_WAIT_MS = 500;
+}
+
 bool CDVDVideoCodecFFmpeg::Open(CDVDStreamInfo &hints, CDVDCodecOptions &options)
 {
   if (hints.cryptoSession)
@@ -364,8 +421,7 @@ bool CDVDVideoCodecFFmpeg::Open(CDVDStreamInfo &hints, CDVDCodecOptions &options
     }
     else
     {
-      int num_threads = CServiceBroker::GetCPUInfo()->GetCPUCount() * 3 / 2;
-      num_threads = std::max(1, std::min(num_threads, 16));
+      int num_threads = GetDecodeThreadCount(hints);
       m_pCodecContext->thread_count = num_threads;
       m_pCodecContext->thread_safe_callbacks = 1;
       m_decoderState = STATE_SW_MULTI;
@@ -450,6 +506,7 @@ void CDVDVideoCodecFFmpeg::Dispose()
   avcodec_free_context(&m_pCodecContext);
   SAFE_RELEASE(m_pHardware);
 
+  m_filterThread.reset();
   FilterClose();
 }
 
@@ -566,6 +623,8 @@ bool CDVDVideoCodecFFmpeg::AddData(const DemuxPacket &packet)
   avpkt.side_data_elems = packet.iSideDataElems;
 
   int ret = avcodec_send_packet(m_pCodecContext, &avpkt);
+  if (!m_pHardware)
+    UpdateDecodeStats(false);
 
   // try again
   if (ret == AVERROR(EAGAIN))
@@ -626,6 +685,15 @@ CDVDVideoCodec::VCReturn CDVDVideoCodecFFmpeg::GetPicture(VideoPicture* pVideoPi
     else
       return ret;
   }
+  else if (m_filterThread)
+  {
+    if (m_filterThread->GetFrame(m_pFrame))
+    {
+      if (!SetPictureParams(pVideoPicture))
+        return VC_ERROR;
+      return VC_PICTURE;
+    }
+  }
   else if (m_pFilterGraph && !m_filterEof)
   {
     CDVDVideoCodec::VCReturn ret = FilterProcess(nullptr);
@@ -654,6 +722,8 @@ CDVDVideoCodec::VCReturn CDVDVideoCodecFFmpeg::GetPicture(VideoPicture* pVideoPi
   }
 
   int ret = avcodec_receive_frame(m_pCodecContext, m_pDecodedFrame);
+  if (!m_pHardware)
+    UpdateDecodeStats(ret == 0);
 
   if (m_decoderState == STATE_HW_FAILED && !m_pHardware)
     return VC_REOPEN;
@@ -684,6 +754,23 @@ CDVDVideoCodec::VCReturn CDVDVideoCodecFFmpeg::GetPicture(VideoPicture* pVideoPi
         return VC_EOF;
       }
     }
+    else if (m_filterThread && m_filterThread->IsStarted())
+    {
+      m_filterThread->AddFrame(nullptr, 0);
+      if (m_filterThread->GetFrame(m_pFrame, FILTER_WAIT_MS))
+      {
+        if (!SetPictureParams(pVideoPicture))
+          return VC_ERROR;
+        else
+          return VC_PICTURE;
+      }
+      else
+      {
+        m_eof = true;
+        CLog::Log(LOGDEBUG, "CDVDVideoCodecFFmpeg::GetPicture - eof filter thread");
+        return VC_EOF;
+      }
+    }
     else if (m_pFilterGraph && !m_filterEof)
     {
       int ret = FilterProcess(nullptr);
@@ -823,7 +910,20 @@ CDVDVideoCodec::VCReturn CDVDVideoCodecFFmpeg::GetPicture(VideoPicture* pVideoPi
         FilterClose();
     }
 
-    if (m_pFilterGraph && !m_filterEof)
+    if (m_filterThread && m_filterThread->IsStarted())
+    {
+      // the frame is filtered while the next one is decoded, it is returned by one of the
+      // following calls
+      if (!m_filterThread->AddFrame(m_pDecodedFrame, FILTER_WAIT_MS))
+      {
+        av_frame_unref(m_pDecodedFrame);
+        CLog::Log(LOGERROR, "CDVDVideoCodecFFmpeg::GetPicture - filter thread does not take frames");
+        return VC_ERROR;
+      }
+      if (!m_filterThread->GetFrame(m_pFrame))
+        return VC_NONE;
+    }
+    else if (m_pFilterGraph && !m_filterEof)
     {
       CDVDVideoCodec::VCReturn ret = FilterProcess(m_pDecodedFrame);
       if (ret != VC_PICTURE)
@@ -868,6 +968,64 @@ bool CDVDVideoCodecFFmpeg::SetPictureParams(VideoPicture* pVideoPicture)
   return true;
 }
 
+void CDVDVideoCodecFFmpeg::UpdateDecodeStats(bool frame)
+{
+  if (frame)
+    m_decodeFrames++;
+
+  const int64_t now = CurrentHostCounter();
+  if (m_decodeStatsStart == 0)
+  {
+    m_decodeStatsStart = now;
+    m_decodeCpuStart = GetProcessCpuTime();
+    return;
+  }
+
+  const int64_t frequency = CurrentHostFrequency();
+  if ((now - m_decodeStatsStart) * 1000 < DECODE_STATS_INTERVAL_MS * frequency)
+    return;
+
+  const int64_t cpuTime = GetProcessCpuTime();
+  const int64_t decodeCpuTime = cpuTime - m_decodeCpuStart;
+
+  // filtering on its own thread runs in parallel on another core
+  int threads = std::max(1, m_pCodecContext->thread_count);
+  if (m_filterThread)
+  {
+    m_filterThread->TakeStats(m_filterTime, m_filterFrames);
+    threads++;
+  }
+  threads = std::min(threads, CServiceBroker::GetCPUInfo()->GetCPUCount());
+
+  double fps = 0.0;
+  if (m_hints.fpsrate > 0 && m_hints.fpsscale > 0)
+    fps = static_cast<double>(m_hints.fpsrate) / m_hints.fpsscale;
+  else
+    fps = m_processInfo.GetVideoFps();
+
+  // With frame threading, the time spent in the decoder calls is mostly waiting for the frame
+  // threads, so the cost of a frame is taken from the CPU time instead. Spread over the cores the
+  // threads can use, it gives the frames the decoder could deliver per second, relative to the
+  // frames the stream needs. The rest of the process takes a share of the CPU time as well, so
+  // this is a lower bound.
+  if (fps > 0.0 && m_decodeFrames > 0 && decodeCpuTime > 0)
+  {
+    const double decodeFps = m_decodeFrames * 1000000000.0 * threads / decodeCpuTime;
+    m_processInfo.SetVideoDecoderHeadroom(static_cast<float>(decodeFps / fps));
+  }
+
+  if (m_filterFrames > 0)
+    m_processInfo.SetVideoFilterTime(static_cast<float>(m_filterTime * 1000.0 / frequency / m_filterFrames));
+  else
+    m_processInfo.SetVideoFilterTime(0.0f);
+
+  m_decodeFrames = 0;
+  m_filterTime = 0;
+  m_filterFrames = 0;
+  m_decodeStatsStart = now;
+  m_decodeCpuStart = cpuTime;
+}
+
 void CDVDVideoCodecFFmpeg::Reset()
 {
   m_started = false;
@@ -885,8 +1043,15 @@ void CDVDVideoCodecFFmpeg::Reset()
     m_pHardware->Reset();
 
   m_filters = "";
+  if (m_filterThread)
+    m_filterThread->Reset();
   FilterClose();
   m_dropCtrl.Reset(false);
+
+  m_decodeFrames = 0;
+  m_filterTime = 0;
+  m_filterFrames = 0;
+  m_decodeStatsStart = 0;
 }
 
 void CDVDVideoCodecFFmpeg::Reopen()
@@ -1169,6 +1334,15 @@ int CDVDVideoCodecFFmpeg::FilterOpen(const std::string& filters, bool scale)
   }
 
   m_filterEof = false;
+
+  // filter on a thread of its own, pipelined after the decoder, when there is a core for it
+  if (CServiceBroker::GetCPUInfo()->GetCPUCount() > 1)
+  {
+    if (!m_filterThread)
+      m_filterThread = std::make_unique<CVideoFilterThread>(FILTER_QUEUE_FRAMES);
+    m_filterThread->Start(m_pFilterIn, m_pFilterOut);
+  }
+
   return result;
 }
 
@@ -1176,6 +1350,10 @@ void CDVDVideoCodecFFmpeg::FilterClose()
 {
   if (m_pFilterGraph)
   {
+    // the queued frames still go through the old graph
+    if (m_filterThread)
+      m_filterThread->Stop();
+
     CLog::Log(LOGDEBUG, LOGVIDEO, "CDVDVideoCodecFFmpeg::FilterClose - Freeing filter graph");
     avfilter_graph_free(&m_pFilterGraph);
 
@@ -1186,6 +1364,17 @@ void CDVDVideoCodecFFmpeg::FilterClose()
 }
 
 CDVDVideoCodec::VCReturn CDVDVideoCodecFFmpeg::FilterProcess(AVFrame* frame)
+{
+  const int64_t start = CurrentHostCounter();
+  CDVDVideoCodec::VCReturn ret = FilterProcessFrame(frame);
+  m_filterTime += CurrentHostCounter() - start;
+  if (ret == VC_PICTURE)
+    m_filterFrames++;
+
+  return ret;
+}
+
+CDVDVideoCodec::VCReturn CDVDVideoCodecFFmpeg::FilterProcessFrame(AVFrame* frame)
 {
   int result;
 
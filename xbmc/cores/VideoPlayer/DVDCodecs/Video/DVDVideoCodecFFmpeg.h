@@ -12,6 +12,8 @@
 #include "cores/VideoPlayer/DVDStreamInfo.h"
 #include "DVDVideoCodec.h"
 #include "DVDVideoPPFFmpeg.h"
+#include "VideoFilterThread.h"
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -52,12 +54,14 @@ protected:
   int  FilterOpen(const std::string& filters, bool scale);
   void FilterClose();
   CDVDVideoCodec::VCReturn FilterProcess(AVFrame* frame);
+  CDVDVideoCodec::VCReturn FilterProcessFrame(AVFrame* frame);
   void SetFilters();
   void UpdateName();
   bool SetPictureParams(VideoPicture* pVideoPicture);
 
   bool HasHardware() { return m_pHardware != nullptr; };
   void SetHardware(IHardwareDecoder *hardware);
+  void UpdateDecodeStats(bool frame);
 
   AVFrame* m_pFrame = nullptr;;
   AVFrame* m_pDecodedFrame = nullptr;;
@@ -99,6 +103,15 @@ protected:
   CDVDStreamInfo m_hints;
   CDVDCodecOptions m_options;
 
+  // cost of software decoding, to report headroom over the stream frame rate
+  int64_t m_decodeStatsStart = 0;
+  int64_t m_decodeCpuStart = 0; // process CPU time in ns at m_decodeStatsStart
+  int m_decodeFrames = 0;
+  int64_t m_filterTime = 0;
+  int m_filterFrames = 0;
+
+  std::unique_ptr<CVideoFilterThread> m_filterThread; // runs m_pFilterGraph on multi-core systems
+
   struct CDropControl
   {
     CDropControl();
@@ -0,0 +1,270 @@
+/*
+ *  Copyright (C) 2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "VideoFilterThread.h"
+
+#include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "utils/TimeUtils.h"
+#include "utils/log.h"
+
+extern "C" {
+#include <libavfilter/buffersink.h>
+#include <libavfilter/buffersrc.h>
+}
+
+namespace
+{
+// how long Stop() waits for the queued frames to be filtered
+constexpr unsigned int STOP_TIMEOUT_MS = 1000;
+}
+
+CVideoFilterThread::CVideoFilterThread(size_t maxFrames)
+  : CThread("VideoFilter"), m_maxFrames(maxFrames)
+{
+}
+
+CVideoFilterThread::~CVideoFilterThread()
+{
+  Reset();
+}
+
+void CVideoFilterThread::Start(AVFilterContext* filterIn, AVFilterContext* filterOut)
+{
+  if (IsStarted())
+    Stop();
+
+  {
+    CSingleLock lock(m_critSection);
+    m_filterIn = filterIn;
+    m_filterOut = filterOut;
+    m_eofQueued = false;
+    m_eof = false;
+    m_failed = false;
+  }
+  Create(false);
+}
+
+void CVideoFilterThread::Stop()
+{
+  if (!IsStarted())
+    return;
+
+  // the frames already taken from the decoder are filtered, even if nobody takes them meanwhile
+  {
+    CSingleLock lock(m_critSection);
+    m_stopping = true;
+    m_inputEvent.Set();
+  }
+
+  XbmcThreads::EndTime timeout(STOP_TIMEOUT_MS);
+  while (!timeout.IsTimePast())
+  {
+    {
+      CSingleLock lock(m_critSection);
+      if (m_failed || (m_input.empty() && !m_busy))
+        break;
+      m_outputEvent.Reset();
+    }
+    m_outputEvent.WaitMSec(timeout.MillisLeft());
+  }
+
+  StopThread(true);
+
+  CSingleLock lock(m_critSection);
+  for (AVFrame* frame : m_input)
+    av_frame_free(&frame);
+  m_input.clear();
+  m_filterIn = nullptr;
+  m_filterOut = nullptr;
+  m_stopping = false;
+}
+
+void CVideoFilterThread::Reset()
+{
+  if (IsStarted())
+  {
+    StopThread(true);
+    m_filterIn = nullptr;
+    m_filterOut = nullptr;
+  }
+
+  ClearQueues();
+}
+
+bool CVideoFilterThread::AddFrame(AVFrame* frame, unsigned int timeoutMillis)
+{
+  XbmcThreads::EndTime timeout(timeoutMillis);
+  CSingleLock lock(m_critSection);
+
+  if (!frame)
+  {
+    if (!m_eofQueued)
+    {
+      m_eofQueued = true;
+      m_input.push_back(nullptr);
+      m_inputEvent.Set();
+    }
+    return true;
+  }
+
+  while (m_input.size() >= m_maxFrames && !m_failed)
+  {
+    if (timeout.IsTimePast())
+      return false;
+
+    m_outputEvent.Reset();
+    lock.Leave();
+    m_outputEvent.WaitMSec(timeout.MillisLeft());
+    lock.Enter();
+  }
+
+  if (m_failed)
+    return false;
+
+  AVFrame* queued = av_frame_alloc();
+  if (!queued)
+    return false;
+
+  av_frame_move_ref(queued, frame);
+  m_input.push_back(queued);
+  m_inputEvent.Set();
+  return true;
+}
+
+bool CVideoFilterThread::GetFrame(AVFrame* frame, unsigned int timeoutMillis)
+{
+  XbmcThreads::EndTime timeout(timeoutMillis);
+  CSingleLock lock(m_critSection);
+
+  while (m_output.empty())
+  {
+    if (timeout.IsTimePast() || m_eof || m_failed)
+      return false;
+
+    m_outputEvent.Reset();
+    lock.Leave();
+    m_outputEvent.WaitMSec(timeout.MillisLeft());
+    lock.Enter();
+  }
+
+  AVFrame* filtered = m_output.front();
+  m_output.pop_front();
+  av_frame_unref(frame);
+  av_frame_move_ref(frame, filtered);
+  av_frame_free(&filtered);
+
+  // there is room for the filter again
+  m_inputEvent.Set();
+  m_outputEvent.Set();
+  return true;
+}
+
+bool CVideoFilterThread::IsEof()
+{
+  CSingleLock lock(m_critSection);
+  return m_eof && m_output.empty();
+}
+
+bool CVideoFilterThread::HasFailed()
+{
+  CSingleLock lock(m_critSection);
+  return m_failed;
+}
+
+void CVideoFilterThread::TakeStats(int64_t& time, int& frames)
+{
+  CSingleLock lock(m_critSection);
+  time = m_filterTime;
+  frames = m_filterFrames;
+  m_filterTime = 0;
+  m_filterFrames = 0;
+}
+
+void CVideoFilterThread::Process()
+{
+  while (!m_bStop)
+  {
+    AVFrame* frame;
+    {
+      CSingleLock lock(m_critSection);
+      // a full output only holds the filter back while the decoder can still queue frames
+      const bool outputFull = m_output.size() >= m_maxFrames && m_input.size() < m_maxFrames;
+      if (m_input.empty() || (outputFull && !m_stopping) || m_failed)
+      {
+        m_inputEvent.Reset();
+        lock.Leave();
+        AbortableWait(m_inputEvent);
+        continue;
+      }
+
+      frame = m_input.front();
+      m_input.pop_front();
+      m_busy = true;
+    }
+
+    const int64_t start = CurrentHostCounter();
+    std::deque<AVFrame*> filtered;
+    bool eof = false;
+    bool failed = false;
+
+    int result = av_buffersrc_add_frame(m_filterIn, frame);
+    av_frame_free(&frame);
+    if (result < 0)
+    {
+      CLog::Log(LOGERROR, "CVideoFilterThread::%s - av_buffersrc_add_frame", __FUNCTION__);
+      failed = true;
+    }
+
+    while (!failed)
+    {
+      AVFrame* out = av_frame_alloc();
+      result = out ? av_buffersink_get_frame(m_filterOut, out) : AVERROR(ENOMEM);
+      if (result < 0)
+      {
+        av_frame_free(&out);
+        if (result == AVERROR_EOF)
+          eof = true;
+        else if (result != AVERROR(EAGAIN))
+        {
+          CLog::Log(LOGERROR, "CVideoFilterThread::%s - av_buffersink_get_frame", __FUNCTION__);
+          failed = true;
+        }
+        break;
+      }
+      filtered.push_back(out);
+    }
+
+    CSingleLock lock(m_critSection);
+    m_filterTime += CurrentHostCounter() - start;
+    m_filterFrames += static_cast<int>(filtered.size());
+    m_output.insert(m_output.end(), filtered.begin(), filtered.end());
+    m_eof = m_eof || eof;
+    m_failed = m_failed || failed;
+    m_busy = false;
+    m_outputEvent.Set();
+  }
+}
+
+void CVideoFilterThread::ClearQueues()
+{
+  CSingleLock lock(m_critSection);
+  for (AVFrame* frame : m_input)
+    av_frame_free(&frame);
+  m_input.clear();
+  for (AVFrame* frame : m_output)
+    av_frame_free(&frame);
+  m_output.clear();
+  m_busy = false;
+  m_stopping = false;
+  m_eofQueued = false;
+  m_eof = false;
+  m_failed = false;
+  m_filterTime = 0;
+  m_filterFrames = 0;
+}
@@ -0,0 +1,104 @@
+/*
+ *  Copyright (C) 2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "threads/Thread.h"
+
+#include <deque>
+
+extern "C" {
+#include <libavfilter/avfilter.h>
+#include <libavutil/frame.h>
+}
+
+/*!
+ * @brief Runs an ffmpeg filter graph on its own thread, pipelined after the decoder.
+ *
+ * Decoded frames are queued with AddFrame() and the filtered frames are taken with GetFrame().
+ * Both queues are bounded, AddFrame() blocks the decoder while the filter falls behind. The graph
+ * is owned by the caller and must not be touched between Start() and Stop().
+ */
+class CVideoFilterThread : private CThread
+{
+public:
+  explicit CVideoFilterThread(size_t maxFrames);
+  ~CVideoFilterThread() override;
+
+  /*!
+   * @brief Start filtering with the given buffer source and sink of a configured graph.
+   */
+  void Start(AVFilterContext* filterIn, AVFilterContext* filterOut);
+
+  /*!
+   * @brief Filter the frames queued so far and stop. Filtered frames can still be taken.
+   */
+  void Stop();
+
+  /*!
+   * @brief Stop and drop all queued frames.
+   */
+  void Reset();
+
+  bool IsStarted() const { return m_filterIn != nullptr; }
+
+  /*!
+   * @brief Queue a frame for filtering, nullptr marks the end of the stream.
+   * @param frame the frame, its reference is moved
+   * @param timeoutMillis how long to wait for the filter to make room
+   * @return false if the frame could not be queued
+   */
+  bool AddFrame(AVFrame* frame, unsigned int timeoutMillis);
+
+  /*!
+   * @brief Take the next filtered frame, optionally waiting for one.
+   * @param frame receives the reference of the filtered frame
+   * @return false if no frame is ready
+   */
+  bool GetFrame(AVFrame* frame, unsigned int timeoutMillis = 0);
+
+  /*!
+   * @brief Whether the end of the stream passed the filter and all frames were taken.
+   */
+  bool IsEof();
+
+  /*!
+   * @brief Whether the filter failed, queued frames are not filtered anymore.
+   */
+  bool HasFailed();
+
+  /*!
+   * @brief Take the time spent filtering and the number of frames filtered since the last call.
+   */
+  void TakeStats(int64_t& time, int& frames);
+
+protected:
+  void Process() override;
+
+private:
+  void ClearQueues();
+
+  const size_t m_maxFrames;
+  AVFilterContext* m_filterIn = nullptr;
+  AVFilterContext* m_filterOut = nullptr;
+
+  CCriticalSection m_critSection;
+  CEvent m_inputEvent; /*!< set when frames were queued or the thread has to stop */
+  CEvent m_outputEvent; /*!< set when frames were filtered or taken */
+  std::deque<AVFrame*> m_input; /*!< nullptr marks the end of the stream */
+  std::deque<AVFrame*> m_output;
+  bool m_busy = false;
+  bool m_stopping = false; /*!< filter the queued frames regardless of the output limit */
+  bool m_eofQueued = false;
+  bool m_eof = false;
+  bool m_failed = false;
+  int64_t m_filterTime = 0;
+  int m_filterFrames = 0;
+};
@@ -8,6 +8,7 @@
 
 #include "DVDDemuxFFmpeg.h"
 
+#include <map>
 #include <sstream>
 #include <utility>
 
@@ -163,6 +164,34 @@ static int64_t dvd_file_seek(void* h, int64_t pos, int whence)
     return pInputStream->Seek(pos, whence & ~AVSEEK_FORCE);
 }
 
+// formats detected for realtime streams, used to skip probing when such a stream is opened again.
+// keyed by the full url, as its options may select a different stream
+static CCriticalSection s_formatHintsSection;
+static std::map<std::string, std::string> s_formatHints;
+
+static std::string GetFormatHint(const std::string& strFile)
+{
+  CSingleLock lock(s_formatHintsSection);
+  const auto it = s_formatHints.find(strFile);
+  return it != s_formatHints.end() ? it->second : std::string();
+}
+
+static void SetFormatHint(const std::string& strFile, const std::string& format)
+{
+  CSingleLock lock(s_formatHintsSection);
+  if (format.empty())
+  {
+    s_formatHints.erase(strFile);
+    return;
+  }
+
+  if (s_formatHints.size() >= 256)
+    s_formatHints.clear();
+
+  // the name of a demuxer can be a list of formats, av_find_input_format() takes only one
+  s_formatHints[strFile] = format.substr(0, format.find(','));
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -318,6 +347,23 @@ bool CDVDDemuxFFmpeg::Open(std::shared_ptr<CDVDInputStream> pInput, bool streami
     if (StringUtils::StartsWith(content, "audio/l16"))
       iformat = av_find_input_format("s16be");
 
+    // reuse the format detected at the last open of a realtime stream, e.g. when switching back
+    // and forth between live tv channels, probing takes a noticeable share of the switch time
+    const bool useFormatHint = m_pInput->IsRealtime() &&
+        CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_bPVRPredictiveZap;
+    bool formatHinted = false;
+    if (iformat == nullptr && useFormatHint)
+    {
+      const std::string formatHint = GetFormatHint(strFile);
+      if (!formatHint.empty())
+      {
+        iformat = av_find_input_format(formatHint.c_str());
+        formatHinted = iformat != nullptr;
+        if (formatHinted)
+          CLog::Log(LOGDEBUG, "%s - skipped probing, using previously detected format [%s]", __FUNCTION__, formatHint.c_str());
+      }
+    }
+
     if (iformat == nullptr)
     {
       // let ffmpeg decide which demuxer we have to open
@@ -441,12 +487,27 @@ bool CDVDDemuxFFmpeg::Open(std::shared_ptr<CDVDInputStream> pInput, bool streami
 
     if (avformat_open_input(&m_pFormatContext, strFile.c_str(), iformat, &options) < 0)
     {
+      av_dict_free(&options);
+      if (formatHinted)
+      {
+        // the stream may have changed its format, forget it and start over with probing
+        CLog::Log(LOGDEBUG, "%s - previously detected format [%s] failed, probing again", __FUNCTION__, iformat->name);
+        SetFormatHint(strFile, "");
+        Dispose();
+        if (pInput->Seek(0, SEEK_POSSIBLE) != 0)
+          pInput->Seek(0, SEEK_SET);
+        return Open(pInput, streaminfo, fileinfo);
+      }
+
       CLog::Log(LOGERROR, "%s - Error, could not open file %s", __FUNCTION__, CURL::GetRedacted(strFile).c_str());
       Dispose();
-      av_dict_free(&options);
       return false;
     }
     av_dict_free(&options);
+
+    // wav needs the spdif and dts checks above, so it is always probed
+    if (useFormatHint && iformat->name && strcmp(iformat->name, "wav") != 0)
+      SetFormatHint(strFile, iformat->name);
   }
 
   // Avoid detecting framerate if advancedsettings.xml says so
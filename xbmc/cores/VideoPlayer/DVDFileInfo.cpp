@@ -41,6 +41,7 @@
 #include "Util.h"
 #include "utils/LangCodeExpander.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <memory>
 
@@ -86,6 +87,200 @@ int DegreeToOrientation(int degrees)
   }
 }
 
+namespace
+{
+CDVDDemux* OpenDemuxer(const std::shared_ptr<CDVDInputStream>& pInputStream)
+{
+  CDVDDemux *pDemuxer = NULL;
+
+  try
+  {
+    pDemuxer = CDVDFactoryDemuxer::CreateDemuxer(pInputStream, true);
+    if(!pDemuxer)
+      CLog::Log(LOGERROR, "%s - Error creating demuxer", __FUNCTION__);
+  }
+  catch(...)
+  {
+    CLog::Log(LOGERROR, "%s - Exception thrown when opening demuxer", __FUNCTION__);
+    if (pDemuxer)
+      delete pDemuxer;
+
+    pDemuxer = NULL;
+  }
+
+  return pDemuxer;
+}
+
+/*!
+ * Enable the first video stream of the demuxer and disable all others
+ * \return the unique id of the video stream or -1 if there is none
+ */
+int SelectVideoStream(CDVDDemux* pDemuxer, int64_t& demuxerId)
+{
+  int nVideoStream = -1;
+  for (CDemuxStream* pStream : pDemuxer->GetStreams())
+  {
+    if (pStream)
+    {
+      // ignore if it's a picture attachment (e.g. jpeg artwork)
+      if (pStream->type == STREAM_VIDEO && !(pStream->flags & AV_DISPOSITION_ATTACHED_PIC))
+      {
+        nVideoStream = pStream->uniqueId;
+        demuxerId = pStream->demuxerId;
+      }
+      else
+        pDemuxer->EnableStream(pStream->demuxerId, pStream->uniqueId, false);
+    }
+  }
+  return nVideoStream;
+}
+
+// Batch extraction decodes forward to a position instead of seeking, if it is closer to the last
+// picture than the longest distance a seek landed before its position, i.e. about a GOP.
+constexpr int64_t MIN_FORWARD_DECODE_MS = 1000;
+constexpr int64_t MAX_FORWARD_DECODE_MS = 10000;
+
+/*!
+ * Decode from the current position of the demuxer until a picture at or after minPts
+ */
+bool DecodePicture(CDVDDemux* pDemuxer,
+                   CDVDVideoCodec* pVideoCodec,
+                   int nVideoStream,
+                   double minPts,
+                   int maxPackets,
+                   VideoPicture& picture,
+                   int& packetsTried)
+{
+  CDVDVideoCodec::VCReturn iDecoderState = CDVDVideoCodec::VC_NONE;
+
+  int abort_index = maxPackets;
+  do
+  {
+    DemuxPacket* pPacket = pDemuxer->Read();
+    packetsTried++;
+
+    if (!pPacket)
+      break;
+
+    if (pPacket->iStreamId != nVideoStream)
+    {
+      CDVDDemuxUtils::FreeDemuxPacket(pPacket);
+      continue;
+    }
+
+    pVideoCodec->AddData(*pPacket);
+    CDVDDemuxUtils::FreeDemuxPacket(pPacket);
+
+    iDecoderState = CDVDVideoCodec::VC_NONE;
+    while (iDecoderState == CDVDVideoCodec::VC_NONE)
+    {
+      iDecoderState = pVideoCodec->GetPicture(&picture);
+    }
+
+    if (iDecoderState == CDVDVideoCodec::VC_PICTURE)
+    {
+      if (!(picture.iFlags & DVP_FLAG_DROPPED) &&
+          (minPts == DVD_NOPTS_VALUE || picture.pts == DVD_NOPTS_VALUE || picture.pts >= minPts))
+        return true;
+    }
+
+  } while (abort_index--);
+
+  return false;
+}
+
+/*!
+ * Seek to the keyframe before pos and decode the first picture from there
+ */
+bool DecodePictureAt(CDVDDemux* pDemuxer,
+                     CDVDVideoCodec* pVideoCodec,
+                     int nVideoStream,
+                     int64_t pos,
+                     VideoPicture& picture,
+                     int& packetsTried,
+                     const std::string& redactPath)
+{
+  int nTotalLen = pDemuxer->GetStreamLength();
+  int64_t nSeekTo = (pos == -1) ? nTotalLen / 3 : pos;
+
+  CLog::Log(LOGDEBUG, "%s - seeking to pos %lldms (total: %dms) in %s", __FUNCTION__, nSeekTo, nTotalLen, redactPath.c_str());
+  if (!pDemuxer->SeekTime(static_cast<double>(nSeekTo), true))
+    return false;
+
+  // num streams * 160 frames, should get a valid frame, if not abort.
+  if (DecodePicture(pDemuxer, pVideoCodec, nVideoStream, DVD_NOPTS_VALUE,
+                    pDemuxer->GetNrOfStreams() * 160, picture, packetsTried))
+    return true;
+
+  CLog::Log(LOGDEBUG,"%s - decode failed in %s after %d packets.", __FUNCTION__, redactPath.c_str(), packetsTried);
+  return false;
+}
+
+/*!
+ * Scale the picture to thumb size and store it in the texture cache. The scaling context
+ * is created on demand and reused for subsequent pictures of the same geometry.
+ */
+bool CachePicture(const VideoPicture& picture,
+                  const CDVDStreamInfo& hint,
+                  SwsContext*& context,
+                  CTextureDetails& details)
+{
+  unsigned int nWidth = std::min(picture.iDisplayWidth, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_imageRes);
+  double aspect = (double)picture.iDisplayWidth / (double)picture.iDisplayHeight;
+  if(hint.forced_aspect && hint.aspect != 0)
+    aspect = hint.aspect;
+  unsigned int nHeight = (unsigned int)((double)nWidth / aspect);
+
+  context = sws_getCachedContext(context, picture.iWidth, picture.iHeight, AV_PIX_FMT_YUV420P,
+                                 nWidth, nHeight, AV_PIX_FMT_BGRA, SWS_FAST_BILINEAR, NULL,
+                                 NULL, NULL);
+  if (!context)
+    return false;
+
+  uint8_t *pOutBuf = (uint8_t*)av_malloc(nWidth * nHeight * 4);
+  uint8_t *planes[YuvImage::MAX_PLANES];
+  int stride[YuvImage::MAX_PLANES];
+  picture.videoBuffer->GetPlanes(planes);
+  picture.videoBuffer->GetStrides(stride);
+  uint8_t *src[4]= { planes[0], planes[1], planes[2], 0 };
+  int srcStride[] = { stride[0], stride[1], stride[2], 0 };
+  uint8_t *dst[] = { pOutBuf, 0, 0, 0 };
+  int dstStride[] = { (int)nWidth*4, 0, 0, 0 };
+  int orientation = DegreeToOrientation(hint.orientation);
+  sws_scale(context, src, srcStride, 0, picture.iHeight, dst, dstStride);
+
+  details.width = nWidth;
+  details.height = nHeight;
+  CPicture::CacheTexture(pOutBuf, nWidth, nHeight, nWidth * 4, orientation, nWidth, nHeight, CTextureCache::GetCachedPath(details.file));
+  av_free(pOutBuf);
+  return true;
+}
+
+CDVDVideoCodec* CreateThumbCodec(CDVDDemux* pDemuxer,
+                                 int64_t demuxerId,
+                                 int nVideoStream,
+                                 CProcessInfo& processInfo,
+                                 CDVDStreamInfo& hint)
+{
+  std::vector<AVPixelFormat> pixFmts;
+  pixFmts.push_back(AV_PIX_FMT_YUV420P);
+  processInfo.SetPixFormats(pixFmts);
+
+  hint.Assign(*pDemuxer->GetStream(demuxerId, nVideoStream), true);
+  hint.codecOptions = CODEC_FORCE_SOFTWARE;
+
+  return CDVDFactoryCodec::CreateVideoCodec(hint, processInfo);
+}
+
+void MarkThumbFailed(const CTextureDetails& details)
+{
+  // create an empty cache file so that extraction isn't retried
+  XFILE::CFile file;
+  if(file.OpenForWrite(CTextureCache::GetCachedPath(details.file)))
+    file.Close();
+}
+} // namespace
+
 bool CDVDFileInfo::ExtractThumb(const CFileItem& fileItem,
                                 CTextureDetails &details,
                                 CStreamDetails *pStreamDetails,
@@ -109,25 +304,9 @@ bool CDVDFileInfo::ExtractThumb(const CFileItem& fileItem,
     return false;
   }
 
-  CDVDDemux *pDemuxer = NULL;
-
-  try
-  {
-    pDemuxer = CDVDFactoryDemuxer::CreateDemuxer(pInputStream, true);
-    if(!pDemuxer)
-    {
-      CLog::Log(LOGERROR, "%s - Error creating demuxer", __FUNCTION__);
-      return false;
-    }
-  }
-  catch(...)
-  {
-    CLog::Log(LOGERROR, "%s - Exception thrown when opening demuxer", __FUNCTION__);
-    if (pDemuxer)
-      delete pDemuxer;
-
+  CDVDDemux *pDemuxer = OpenDemuxer(pInputStream);
+  if (!pDemuxer)
     return false;
-  }
 
   if (pStreamDetails)
   {
@@ -164,140 +343,166 @@ bool CDVDFileInfo::ExtractThumb(const CFileItem& fileItem,
     }
   }
 
-  int nVideoStream = -1;
   int64_t demuxerId = -1;
-  for (CDemuxStream* pStream : pDemuxer->GetStreams())
+  int nVideoStream = SelectVideoStream(pDemuxer, demuxerId);
+
+  bool bOk = false;
+  int packetsTried = 0;
+
+  if (nVideoStream != -1)
   {
-    if (pStream)
+    std::unique_ptr<CProcessInfo> pProcessInfo(CProcessInfo::CreateInstance());
+    CDVDStreamInfo hint;
+    CDVDVideoCodec *pVideoCodec = CreateThumbCodec(pDemuxer, demuxerId, nVideoStream, *pProcessInfo, hint);
+
+    if (pVideoCodec)
     {
-      // ignore if it's a picture attachment (e.g. jpeg artwork)
-      if (pStream->type == STREAM_VIDEO && !(pStream->flags & AV_DISPOSITION_ATTACHED_PIC))
+      VideoPicture picture = {};
+      if (DecodePictureAt(pDemuxer, pVideoCodec, nVideoStream, pos, picture, packetsTried, redactPath))
       {
-        nVideoStream = pStream->uniqueId;
-        demuxerId = pStream->demuxerId;
+        SwsContext *context = NULL;
+        bOk = CachePicture(picture, hint, context, details);
+        sws_freeContext(context);
       }
-      else
-        pDemuxer->EnableStream(pStream->demuxerId, pStream->uniqueId, false);
+      delete pVideoCodec;
     }
   }
 
-  bool bOk = false;
-  int packetsTried = 0;
+  if (pDemuxer)
+    delete pDemuxer;
 
-  if (nVideoStream != -1)
-  {
-    CDVDVideoCodec *pVideoCodec;
-    std::unique_ptr<CProcessInfo> pProcessInfo(CProcessInfo::CreateInstance());
-    std::vector<AVPixelFormat> pixFmts;
-    pixFmts.push_back(AV_PIX_FMT_YUV420P);
-    pProcessInfo->SetPixFormats(pixFmts);
+  if(!bOk)
+    MarkThumbFailed(details);
 
-    CDVDStreamInfo hint(*pDemuxer->GetStream(demuxerId, nVideoStream), true);
-    hint.codecOptions = CODEC_FORCE_SOFTWARE;
+  unsigned int nTotalTime = XbmcThreads::SystemClockMillis() - nTime;
+  CLog::Log(LOGDEBUG,"%s - measured %u ms to extract thumb from file <%s> in %d packets. ", __FUNCTION__, nTotalTime, redactPath.c_str(), packetsTried);
+  return bOk;
+}
 
-    pVideoCodec = CDVDFactoryCodec::CreateVideoCodec(hint, *pProcessInfo);
+unsigned int CDVDFileInfo::ExtractThumbs(const CFileItem& fileItem, std::vector<ThumbRequest>& requests)
+{
+  const std::string redactPath = CURL::GetRedacted(fileItem.GetPath());
+  unsigned int nTime = XbmcThreads::SystemClockMillis();
 
-    if (pVideoCodec)
-    {
-      int nTotalLen = pDemuxer->GetStreamLength();
-      int64_t nSeekTo = (pos == -1) ? nTotalLen / 3 : pos;
+  for (auto& request : requests)
+    request.extracted = false;
 
-      CLog::Log(LOGDEBUG, "%s - seeking to pos %lldms (total: %dms) in %s", __FUNCTION__, nSeekTo, nTotalLen, redactPath.c_str());
-      if (pDemuxer->SeekTime(static_cast<double>(nSeekTo), true))
-      {
-        CDVDVideoCodec::VCReturn iDecoderState = CDVDVideoCodec::VC_NONE;
-        VideoPicture picture = {};
+  CFileItem item(fileItem);
+  item.SetMimeTypeForInternetFile();
+  auto pInputStream = CDVDFactoryInputStream::CreateInputStream(NULL, item);
+  if (!pInputStream)
+  {
+    CLog::Log(LOGERROR, "InputStream: Error creating stream for %s", redactPath.c_str());
+    return 0;
+  }
 
-        // num streams * 160 frames, should get a valid frame, if not abort.
-        int abort_index = pDemuxer->GetNrOfStreams() * 160;
-        do
-        {
-          DemuxPacket* pPacket = pDemuxer->Read();
-          packetsTried++;
+  if (!pInputStream->Open())
+  {
+    CLog::Log(LOGERROR, "InputStream: Error opening, %s", redactPath.c_str());
+    return 0;
+  }
 
-          if (!pPacket)
-            break;
+  std::unique_ptr<CDVDDemux> pDemuxer(OpenDemuxer(pInputStream));
+  if (!pDemuxer)
+    return 0;
 
-          if (pPacket->iStreamId != nVideoStream)
-          {
-            CDVDDemuxUtils::FreeDemuxPacket(pPacket);
-            continue;
-          }
+  int64_t demuxerId = -1;
+  int nVideoStream = SelectVideoStream(pDemuxer.get(), demuxerId);
 
-          pVideoCodec->AddData(*pPacket);
-          CDVDDemuxUtils::FreeDemuxPacket(pPacket);
+  unsigned int extracted = 0;
+  int packetsTried = 0;
+  int seeks = 0;
+  int forwards = 0;
 
-          iDecoderState = CDVDVideoCodec::VC_NONE;
-          while (iDecoderState == CDVDVideoCodec::VC_NONE)
-          {
-            iDecoderState = pVideoCodec->GetPicture(&picture);
-          }
+  if (nVideoStream != -1)
+  {
+    std::unique_ptr<CProcessInfo> pProcessInfo(CProcessInfo::CreateInstance());
+    CDVDStreamInfo hint;
+    std::unique_ptr<CDVDVideoCodec> pVideoCodec(
+        CreateThumbCodec(pDemuxer.get(), demuxerId, nVideoStream, *pProcessInfo, hint));
 
-          if (iDecoderState == CDVDVideoCodec::VC_PICTURE)
+    if (pVideoCodec)
+    {
+      // visit the positions in a single forward pass through the file
+      std::vector<ThumbRequest*> sorted;
+      for (auto& request : requests)
+        sorted.push_back(&request);
+      std::sort(sorted.begin(), sorted.end(), [](const ThumbRequest* a, const ThumbRequest* b) {
+        return a->pos < b->pos;
+      });
+
+      SwsContext *context = NULL;
+      VideoPicture picture = {};
+      bool havePicture = false;
+      int64_t forwardLimit = MIN_FORWARD_DECODE_MS;
+      for (ThumbRequest* request : sorted)
+      {
+        const int64_t pictureMs = havePicture && picture.pts != DVD_NOPTS_VALUE
+                                      ? static_cast<int64_t>(picture.pts * 1000 / DVD_TIME_BASE)
+                                      : -1;
+        bool decoded = false;
+
+        // positions within about a GOP of the last picture are reached by decoding forward,
+        // which saves the seek and the decoder flush
+        if (pictureMs >= 0 && request->pos >= 0 && request->pos - pictureMs <= forwardLimit)
+        {
+          if (request->pos <= pictureMs)
+            decoded = true;
+          else
           {
-            if(!(picture.iFlags & DVP_FLAG_DROPPED))
-              break;
+            // num streams * 160 frames plus up to 60 frames per second to decode
+            const int maxPackets = pDemuxer->GetNrOfStreams() *
+                                   (160 + static_cast<int>((request->pos - pictureMs) * 60 / 1000));
+            decoded = DecodePicture(pDemuxer.get(), pVideoCodec.get(), nVideoStream,
+                                    static_cast<double>(request->pos) * DVD_TIME_BASE / 1000,
+                                    maxPackets, picture, packetsTried);
           }
+          if (decoded)
+            forwards++;
+        }
 
-        } while (abort_index--);
-
-        if (iDecoderState == CDVDVideoCodec::VC_PICTURE && !(picture.iFlags & DVP_FLAG_DROPPED))
+        if (!decoded)
         {
+          if (havePicture)
+            pVideoCodec->Reset();
+
+          decoded = DecodePictureAt(pDemuxer.get(), pVideoCodec.get(), nVideoStream,
+                                    request->pos, picture, packetsTried, redactPath);
+          seeks++;
+
+          // a seek lands on the keyframe before the position, how far before tells the GOP length
+          if (decoded && request->pos >= 0 && picture.pts != DVD_NOPTS_VALUE)
           {
-            unsigned int nWidth = std::min(picture.iDisplayWidth, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_imageRes);
-            double aspect = (double)picture.iDisplayWidth / (double)picture.iDisplayHeight;
-            if(hint.forced_aspect && hint.aspect != 0)
-              aspect = hint.aspect;
-            unsigned int nHeight = (unsigned int)((double)nWidth / aspect);
-
-            uint8_t *pOutBuf = (uint8_t*)av_malloc(nWidth * nHeight * 4);
-            struct SwsContext *context = sws_getContext(picture.iWidth, picture.iHeight,
-                  AV_PIX_FMT_YUV420P, nWidth, nHeight, AV_PIX_FMT_BGRA, SWS_FAST_BILINEAR, NULL, NULL, NULL);
-
-            if (context)
-            {
-              uint8_t *planes[YuvImage::MAX_PLANES];
-              int stride[YuvImage::MAX_PLANES];
-              picture.videoBuffer->GetPlanes(planes);
-              picture.videoBuffer->GetStrides(stride);
-              uint8_t *src[4]= { planes[0], planes[1], planes[2], 0 };
-              int srcStride[] = { stride[0], stride[1], stride[2], 0 };
-              uint8_t *dst[] = { pOutBuf, 0, 0, 0 };
-              int dstStride[] = { (int)nWidth*4, 0, 0, 0 };
-              int orientation = DegreeToOrientation(hint.orientation);
-              sws_scale(context, src, srcStride, 0, picture.iHeight, dst, dstStride);
-              sws_freeContext(context);
-
-              details.width = nWidth;
-              details.height = nHeight;
-              CPicture::CacheTexture(pOutBuf, nWidth, nHeight, nWidth * 4, orientation, nWidth, nHeight, CTextureCache::GetCachedPath(details.file));
-              bOk = true;
-            }
-            av_free(pOutBuf);
+            const int64_t landedMs = static_cast<int64_t>(picture.pts * 1000 / DVD_TIME_BASE);
+            forwardLimit = std::min(std::max(forwardLimit, request->pos - landedMs),
+                                    MAX_FORWARD_DECODE_MS);
           }
         }
-        else
+
+        havePicture = decoded;
+        if (decoded && CachePicture(picture, hint, context, request->details))
         {
-          CLog::Log(LOGDEBUG,"%s - decode failed in %s after %d packets.", __FUNCTION__, redactPath.c_str(), packetsTried);
+          request->extracted = true;
+          extracted++;
         }
       }
-      delete pVideoCodec;
+      sws_freeContext(context);
     }
   }
 
-  if (pDemuxer)
-    delete pDemuxer;
-
-  if(!bOk)
+  for (const auto& request : requests)
   {
-    XFILE::CFile file;
-    if(file.OpenForWrite(CTextureCache::GetCachedPath(details.file)))
-      file.Close();
+    if (!request.extracted)
+      MarkThumbFailed(request.details);
   }
 
   unsigned int nTotalTime = XbmcThreads::SystemClockMillis() - nTime;
-  CLog::Log(LOGDEBUG,"%s - measured %u ms to extract thumb from file <%s> in %d packets. ", __FUNCTION__, nTotalTime, redactPath.c_str(), packetsTried);
-  return bOk;
+  CLog::Log(LOGDEBUG,
+            "%s - measured %u ms to extract %u of %u thumbs from file <%s> in %d packets, "
+            "%d seeks, %d decoded forward.",
+            __FUNCTION__, nTotalTime, extracted, static_cast<unsigned int>(requests.size()),
+            redactPath.c_str(), packetsTried, seeks, forwards);
+  return extracted;
 }
 
 /**
@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include "TextureCacheJob.h"
+
 #include <memory>
 #include <string>
 #include <vector>
@@ -17,7 +19,6 @@ class CDVDDemux;
 class CStreamDetails;
 class CStreamDetailSubtitle;
 class CDVDInputStream;
-class CTextureDetails;
 
 class CDVDFileInfo
 {
@@ -28,6 +29,22 @@ public:
                            CStreamDetails *pStreamDetails,
                            int64_t pos);
 
+  struct ThumbRequest
+  {
+    int64_t pos = -1; ///< position in ms to extract the thumb from
+    CTextureDetails details; ///< texture to create, details.file has to be set
+    bool extracted = false; ///< set when the thumb was extracted successfully
+  };
+
+  /** \brief Extract thumbnail images at several positions of the media referenced by fileItem.
+  *   The media and the decoder are opened only once and the positions are visited in a single
+  *   forward pass. A position within about a GOP of the previous picture is reached by decoding
+  *   forward to it, otherwise it seeks and decodes the first picture after the preceding keyframe.
+  *   \param[in,out] requests The positions to extract thumbs from.
+  *   \return The number of extracted thumbs.
+  */
+  static unsigned int ExtractThumbs(const CFileItem& fileItem, std::vector<ThumbRequest>& requests);
+
   // Probe the files streams and store the info in the VideoInfoTag
   static bool GetFileStreamDetails(CFileItem *pItem);
   static bool DemuxerToStreamDetails(std::shared_ptr<CDVDInputStream> pInputStream, CDVDDemux *pDemux, CStreamDetails &details, const std::string &path = "");
@@ -9,11 +9,17 @@
 #include "InputStreamPVRChannel.h"
 
 #include "ServiceBroker.h"
+#include "TimeshiftBuffer.h"
 #include "pvr/PVRManager.h"
 #include "pvr/addons/PVRClient.h"
 #include "pvr/channels/PVRChannelGroupsContainer.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
+#include "utils/StringUtils.h"
 #include "utils/log.h"
 
+#include <algorithm>
+
 using namespace PVR;
 
 CInputStreamPVRChannel::CInputStreamPVRChannel(IVideoPlayer* pPlayer, const CFileItem& fileitem)
@@ -48,13 +54,55 @@ bool CInputStreamPVRChannel::OpenPVRStream()
   {
     m_bDemuxActive = m_client->GetClientCapabilities().HandlesDemuxing();
     CLog::Log(LOGDEBUG, "CInputStreamPVRChannel - %s - opened channel stream %s", __FUNCTION__, m_item.GetPath().c_str());
+
+    if (!m_bDemuxActive)
+      OpenTimeshiftBuffer();
+
     return true;
   }
   return false;
 }
 
+void CInputStreamPVRChannel::OpenTimeshiftBuffer()
+{
+  const std::shared_ptr<CAdvancedSettings> settings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+  if (settings->m_iPVRTimeshiftBufferSize <= 0)
+    return;
+
+  // only buffer streams the backend can neither pause nor seek itself
+  bool bCanPause = false;
+  bool bCanSeek = false;
+  m_client->CanPauseStream(bCanPause);
+  m_client->CanSeekStream(bCanSeek);
+  if (bCanPause || bCanSeek)
+    return;
+
+  const size_t memorySize = static_cast<size_t>(std::min(settings->m_iPVRTimeshiftBufferMemory, settings->m_iPVRTimeshiftBufferSize)) * 1024 * 1024;
+  // the file can be larger than the address space of 32 bit systems
+  const int64_t fileSize = static_cast<int64_t>(settings->m_iPVRTimeshiftBufferSize) * 1024 * 1024;
+  const std::string file = "special://temp/pvrtimeshift-" + StringUtils::CreateUUID() + ".ts";
+
+  const std::shared_ptr<CPVRClient> client = m_client;
+  m_timeshiftBuffer.reset(new CTimeshiftBuffer(
+      [client](uint8_t* buf, int size) {
+        int ret = -1;
+        client->ReadLiveStream(buf, size, ret);
+        return ret;
+      },
+      memorySize, fileSize, file));
+
+  if (!m_timeshiftBuffer->Open())
+  {
+    CLog::Log(LOGERROR, "CInputStreamPVRChannel - %s - unable to open timeshift buffer, reading stream directly", __FUNCTION__);
+    m_timeshiftBuffer.reset();
+  }
+}
+
 void CInputStreamPVRChannel::ClosePVRStream()
 {
+  // stop reading from the client before closing the stream
+  m_timeshiftBuffer.reset();
+
   if (m_client && (m_client->CloseLiveStream() == PVR_ERROR_NO_ERROR))
   {
     m_bDemuxActive = false;
@@ -64,6 +112,9 @@ void CInputStreamPVRChannel::ClosePVRStream()
 
 int CInputStreamPVRChannel::ReadPVRStream(uint8_t* buf, int buf_size)
 {
+  if (m_timeshiftBuffer)
+    return m_timeshiftBuffer->Read(buf, buf_size);
+
   int ret = -1;
 
   if (m_client)
@@ -74,6 +125,9 @@ int CInputStreamPVRChannel::ReadPVRStream(uint8_t* buf, int buf_size)
 
 int64_t CInputStreamPVRChannel::SeekPVRStream(int64_t offset, int whence)
 {
+  if (m_timeshiftBuffer)
+    return m_timeshiftBuffer->Seek(offset, whence);
+
   int64_t ret = -1;
 
   if (m_client)
@@ -84,6 +138,9 @@ int64_t CInputStreamPVRChannel::SeekPVRStream(int64_t offset, int whence)
 
 int64_t CInputStreamPVRChannel::GetPVRStreamLength()
 {
+  if (m_timeshiftBuffer)
+    return m_timeshiftBuffer->GetLength();
+
   int64_t ret = -1;
 
   if (m_client)
@@ -102,6 +159,9 @@ CDVDInputStream::ENextStream CInputStreamPVRChannel::NextPVRStream()
 
 bool CInputStreamPVRChannel::CanPausePVRStream()
 {
+  if (m_timeshiftBuffer)
+    return true;
+
   bool ret = false;
 
   if (m_client)
@@ -112,6 +172,9 @@ bool CInputStreamPVRChannel::CanPausePVRStream()
 
 bool CInputStreamPVRChannel::CanSeekPVRStream()
 {
+  if (m_timeshiftBuffer)
+    return true;
+
   bool ret = false;
 
   if (m_client)
@@ -10,6 +10,10 @@
 
 #include "InputStreamPVRBase.h"
 
+#include <memory>
+
+class CTimeshiftBuffer;
+
 class CInputStreamPVRChannel : public CInputStreamPVRBase
 {
 public:
@@ -29,5 +33,8 @@ protected:
   bool CanSeekPVRStream() override;
 
 private:
+  void OpenTimeshiftBuffer();
+
   bool m_bDemuxActive;
+  std::unique_ptr<CTimeshiftBuffer> m_timeshiftBuffer;
 };
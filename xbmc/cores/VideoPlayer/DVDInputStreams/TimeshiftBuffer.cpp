@@ -0,0 +1,289 @@
+/*
+ *  Copyright (C) 2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "TimeshiftBuffer.h"
+
+#include "URL.h"
+#include "filesystem/File.h"
+#include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+
+namespace
+{
+// amount of data requested from the source at once
+constexpr int CHUNK_SIZE = 64 * 1024;
+
+// time to wait for new data, before reporting the end of the stream
+constexpr unsigned int READ_TIMEOUT = 10000;
+} // unnamed namespace
+
+CTimeshiftBuffer::CTimeshiftBuffer(const ReadFunction& source,
+                                   size_t memorySize,
+                                   int64_t fileSize,
+                                   const std::string& file)
+  : CThread("TimeshiftBuffer"),
+    m_source(source),
+    m_memorySize(std::max<size_t>(memorySize, CHUNK_SIZE)),
+    m_fileSize(fileSize > static_cast<int64_t>(m_memorySize) ? fileSize : 0),
+    m_file(file)
+{
+}
+
+CTimeshiftBuffer::~CTimeshiftBuffer()
+{
+  Close();
+}
+
+bool CTimeshiftBuffer::Open()
+{
+  m_memory.resize(m_memorySize);
+
+  if (m_fileSize > 0)
+  {
+    m_writeFile.reset(new XFILE::CFile);
+    m_readFile.reset(new XFILE::CFile);
+
+    // preallocate the file, so writing does not have to grow it
+    if (!m_writeFile->OpenForWrite(m_file, true) ||
+        m_writeFile->Truncate(m_fileSize) != 0 ||
+        !m_readFile->Open(m_file, XFILE::READ_NO_CACHE))
+    {
+      CLog::Log(LOGERROR, "CTimeshiftBuffer::%s - unable to create spill file %s", __FUNCTION__,
+                CURL::GetRedacted(m_file).c_str());
+      m_writeFile.reset();
+      m_readFile.reset();
+      XFILE::CFile::Delete(m_file);
+      return false;
+    }
+  }
+
+  CLog::Log(LOGDEBUG,
+            "CTimeshiftBuffer::%s - buffering %zu bytes in memory, %" PRId64 " bytes on disk",
+            __FUNCTION__, m_memorySize, m_fileSize);
+
+  Create();
+  return true;
+}
+
+void CTimeshiftBuffer::Close()
+{
+  StopThread();
+
+  if (m_writeFile)
+  {
+    m_writeFile->Close();
+    m_readFile->Close();
+    m_writeFile.reset();
+    m_readFile.reset();
+    XFILE::CFile::Delete(m_file);
+  }
+
+  m_memory.clear();
+  m_memory.shrink_to_fit();
+}
+
+void CTimeshiftBuffer::Process()
+{
+  const int64_t capacity = m_fileSize > 0 ? m_fileSize : static_cast<int64_t>(m_memorySize);
+  std::vector<uint8_t> chunk(CHUNK_SIZE);
+
+  while (!m_bStop)
+  {
+    const int size = m_source(chunk.data(), CHUNK_SIZE);
+    if (size < 0)
+    {
+      CLog::Log(LOGERROR, "CTimeshiftBuffer::%s - error reading from source", __FUNCTION__);
+      break;
+    }
+    else if (size == 0)
+    {
+      Sleep(10);
+      continue;
+    }
+
+    int64_t end = 0;
+    {
+      // the oldest data is overwritten now, it must not be read anymore
+      CSingleLock lock(m_critSection);
+      end = m_end;
+      m_begin = std::max(m_begin, end + size - capacity);
+    }
+
+    if (m_writeFile && !WriteFile(end, chunk.data(), size))
+    {
+      CLog::Log(LOGERROR, "CTimeshiftBuffer::%s - error writing to spill file", __FUNCTION__);
+      break;
+    }
+
+    {
+      CSingleLock lock(m_critSection);
+      WriteMemory(end, chunk.data(), size);
+      m_end += size;
+    }
+    m_dataEvent.Set();
+  }
+
+  CSingleLock lock(m_critSection);
+  m_sourceFailed = !m_bStop;
+  m_dataEvent.Set();
+}
+
+int CTimeshiftBuffer::Read(uint8_t* buf, int size)
+{
+  if (size <= 0)
+    return 0;
+
+  XbmcThreads::EndTime timeout(READ_TIMEOUT);
+
+  CSingleLock lock(m_critSection);
+  while (true)
+  {
+    if (m_position >= m_end)
+    {
+      if (m_sourceFailed)
+        return -1;
+      if (timeout.IsTimePast())
+        return 0;
+
+      lock.Leave();
+      m_dataEvent.WaitMSec(100);
+      lock.Enter();
+      continue;
+    }
+
+    if (m_position < m_begin)
+    {
+      CLog::Log(LOGDEBUG, "CTimeshiftBuffer::%s - buffer overrun, skipping %" PRId64 " bytes",
+                __FUNCTION__, m_begin - m_position);
+      m_position = m_begin;
+    }
+
+    const int64_t position = m_position;
+    const size_t count = static_cast<size_t>(std::min<int64_t>(size, m_end - position));
+
+    const int64_t memoryBegin = std::max<int64_t>(m_end - static_cast<int64_t>(m_memorySize), 0);
+    if (position >= memoryBegin)
+    {
+      ReadMemory(position, buf, count);
+      m_position += count;
+      return static_cast<int>(count);
+    }
+
+    // older data is read from the spill file, which is written without holding the lock
+    lock.Leave();
+    const bool success = ReadFile(position, buf, count);
+    lock.Enter();
+
+    if (!success)
+      return -1;
+
+    // if the data was overwritten while reading, read again from the new begin
+    if (position >= m_begin)
+    {
+      m_position = position + count;
+      return static_cast<int>(count);
+    }
+  }
+}
+
+int64_t CTimeshiftBuffer::Seek(int64_t offset, int whence)
+{
+  CSingleLock lock(m_critSection);
+
+  int64_t position = 0;
+  switch (whence)
+  {
+    case SEEK_SET:
+      position = offset;
+      break;
+    case SEEK_CUR:
+      position = m_position + offset;
+      break;
+    case SEEK_END:
+      position = m_end + offset;
+      break;
+    default:
+      return -1;
+  }
+
+  if (position < m_begin || position > m_end)
+    return -1;
+
+  m_position = position;
+  return m_position;
+}
+
+int64_t CTimeshiftBuffer::GetLength() const
+{
+  CSingleLock lock(m_critSection);
+  return m_end;
+}
+
+int64_t CTimeshiftBuffer::GetBegin() const
+{
+  CSingleLock lock(m_critSection);
+  return m_begin;
+}
+
+void CTimeshiftBuffer::WriteMemory(int64_t position, const uint8_t* buf, size_t size)
+{
+  const size_t offset = static_cast<size_t>(position % static_cast<int64_t>(m_memorySize));
+  const size_t first = std::min(size, m_memorySize - offset);
+  memcpy(m_memory.data() + offset, buf, first);
+  memcpy(m_memory.data(), buf + first, size - first);
+}
+
+void CTimeshiftBuffer::ReadMemory(int64_t position, uint8_t* buf, size_t size) const
+{
+  const size_t offset = static_cast<size_t>(position % static_cast<int64_t>(m_memorySize));
+  const size_t first = std::min(size, m_memorySize - offset);
+  memcpy(buf, m_memory.data() + offset, first);
+  memcpy(buf + first, m_memory.data(), size - first);
+}
+
+bool CTimeshiftBuffer::WriteFile(int64_t position, const uint8_t* buf, size_t size)
+{
+  while (size > 0)
+  {
+    const int64_t offset = position % m_fileSize;
+    const size_t count = static_cast<size_t>(std::min<int64_t>(size, m_fileSize - offset));
+    if (m_writeFile->Seek(offset, SEEK_SET) != offset ||
+        m_writeFile->Write(buf, count) != static_cast<ssize_t>(count))
+      return false;
+
+    position += count;
+    buf += count;
+    size -= count;
+  }
+  return true;
+}
+
+bool CTimeshiftBuffer::ReadFile(int64_t position, uint8_t* buf, size_t size)
+{
+  while (size > 0)
+  {
+    const int64_t offset = position % m_fileSize;
+    const size_t count = static_cast<size_t>(std::min<int64_t>(size, m_fileSize - offset));
+    if (m_readFile->Seek(offset, SEEK_SET) != offset)
+      return false;
+
+    const ssize_t read = m_readFile->Read(buf, count);
+    if (read <= 0)
+      return false;
+
+    position += read;
+    buf += read;
+    size -= read;
+  }
+  return true;
+}
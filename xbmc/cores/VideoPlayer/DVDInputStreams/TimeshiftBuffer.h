@@ -0,0 +1,116 @@
+/*
+ *  Copyright (C) 2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "threads/Thread.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace XFILE
+{
+class CFile;
+}
+
+/*!
+ * \brief Timeshift buffer for live streams whose source can neither pause nor seek.
+ *
+ * A thread keeps reading from the source into a ring buffer in memory. If a spill file is given,
+ * all data is also written to it, used as a preallocated ring of its own, so the timeshift window
+ * can be much larger than the memory used. Reads are served from memory if possible and from the
+ * file otherwise. Positions are byte offsets from the start of the stream, so seeking within the
+ * window needs no search.
+ */
+class CTimeshiftBuffer : private CThread
+{
+public:
+  using ReadFunction = std::function<int(uint8_t* buf, int size)>;
+
+  /*!
+   * \brief Create a new buffer.
+   * \param source Reads from the live stream, returns the number of bytes read, 0 if no data is
+   * available at the moment and a negative value on error.
+   * \param memorySize Size of the ring buffer in memory, in bytes.
+   * \param fileSize Size of the spill file, in bytes. If it is not larger than the memory size,
+   * no file is used.
+   * \param file Path of the spill file.
+   */
+  CTimeshiftBuffer(const ReadFunction& source,
+                   size_t memorySize,
+                   int64_t fileSize,
+                   const std::string& file);
+  ~CTimeshiftBuffer() override;
+
+  /*!
+   * \brief Create the spill file and start reading from the source.
+   * \return True on success, false otherwise.
+   */
+  bool Open();
+
+  /*!
+   * \brief Stop reading from the source and delete the spill file.
+   */
+  void Close();
+
+  /*!
+   * \brief Read from the current position. Waits for the source if all data was read.
+   * \return The number of bytes read, 0 if the source delivered no data for too long and a
+   * negative value on error.
+   */
+  int Read(uint8_t* buf, int size);
+
+  /*!
+   * \brief Seek within the buffered data.
+   * \return The new position or -1 if the position is not buffered.
+   */
+  int64_t Seek(int64_t offset, int whence);
+
+  /*!
+   * \brief Get the number of bytes received from the source so far.
+   */
+  int64_t GetLength() const;
+
+  /*!
+   * \brief Get the position of the oldest byte still buffered.
+   */
+  int64_t GetBegin() const;
+
+protected:
+  void Process() override;
+
+private:
+  CTimeshiftBuffer(const CTimeshiftBuffer&) = delete;
+  CTimeshiftBuffer& operator=(const CTimeshiftBuffer&) = delete;
+
+  void WriteMemory(int64_t position, const uint8_t* buf, size_t size);
+  void ReadMemory(int64_t position, uint8_t* buf, size_t size) const;
+  bool WriteFile(int64_t position, const uint8_t* buf, size_t size);
+  bool ReadFile(int64_t position, uint8_t* buf, size_t size);
+
+  const ReadFunction m_source;
+  const size_t m_memorySize;
+  const int64_t m_fileSize;
+  const std::string m_file;
+
+  std::vector<uint8_t> m_memory;
+  std::unique_ptr<XFILE::CFile> m_writeFile; //!< only used by the reading thread
+  std::unique_ptr<XFILE::CFile> m_readFile; //!< only used by the consumer
+
+  mutable CCriticalSection m_critSection;
+  CEvent m_dataEvent;
+  int64_t m_end = 0; //!< number of bytes received from the source
+  int64_t m_begin = 0; //!< position of the oldest byte still buffered
+  int64_t m_position = 0; //!< read position of the consumer
+  bool m_sourceFailed = false;
+};
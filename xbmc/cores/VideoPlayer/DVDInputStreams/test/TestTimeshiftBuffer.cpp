@@ -0,0 +1,169 @@
+/*
+ *  Copyright (C) 2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/DVDInputStreams/TimeshiftBuffer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdio.h>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+const std::string spillFile = "special://temp/timeshiftbuffer-test.ts";
+
+constexpr int KB = 1024;
+constexpr int MB = 1024 * 1024;
+
+uint8_t ByteAt(int64_t position)
+{
+  return static_cast<uint8_t>(position * 7 + 3 + (position >> 16));
+}
+
+bool CheckData(const uint8_t* buf, int size, int64_t position)
+{
+  for (int i = 0; i < size; ++i)
+  {
+    if (buf[i] != ByteAt(position + i))
+      return false;
+  }
+  return true;
+}
+
+// live source delivering a known pattern in odd sized chunks, until the limit is reached
+class CTestSource
+{
+public:
+  explicit CTestSource(int64_t limit) : m_limit(limit) {}
+
+  int Read(uint8_t* buf, int size)
+  {
+    const int64_t produced = m_produced;
+    if (produced >= m_limit)
+      return 0;
+
+    const int count = static_cast<int>(std::min<int64_t>(size - 100, m_limit - produced));
+    for (int i = 0; i < count; ++i)
+      buf[i] = ByteAt(produced + i);
+    m_produced += count;
+    return count;
+  }
+
+private:
+  const int64_t m_limit;
+  std::atomic<int64_t> m_produced{0};
+};
+
+class TestTimeshiftBuffer : public ::testing::Test
+{
+protected:
+  void Open(int64_t limit, size_t memorySize, int64_t fileSize)
+  {
+    m_source = std::make_shared<CTestSource>(limit);
+    const std::shared_ptr<CTestSource> source = m_source;
+    m_buffer.reset(new CTimeshiftBuffer(
+        [source](uint8_t* buf, int size) { return source->Read(buf, size); }, memorySize,
+        fileSize, spillFile));
+    ASSERT_TRUE(m_buffer->Open());
+  }
+
+  void WaitForSource(int64_t length)
+  {
+    while (m_buffer->GetLength() < length)
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+
+  // read until size bytes were read, checking the data on the way
+  void ReadAndCheck(int64_t position, int64_t size)
+  {
+    uint8_t buf[10000];
+    int64_t total = 0;
+    while (total < size)
+    {
+      const int count = static_cast<int>(std::min<int64_t>(sizeof(buf), size - total));
+      const int read = m_buffer->Read(buf, count);
+      ASSERT_GT(read, 0);
+      ASSERT_TRUE(CheckData(buf, read, position + total));
+      total += read;
+    }
+  }
+
+  void TearDown() override { m_buffer.reset(); }
+
+  std::shared_ptr<CTestSource> m_source;
+  std::unique_ptr<CTimeshiftBuffer> m_buffer;
+};
+} // unnamed namespace
+
+TEST_F(TestTimeshiftBuffer, MemoryWrapsAround)
+{
+  Open(MB, 256 * KB, 0);
+  WaitForSource(MB);
+
+  // only the last memory size bytes are kept
+  EXPECT_EQ(MB - 256 * KB, m_buffer->GetBegin());
+
+  // a range that wraps around the end of the ring
+  const int64_t position = m_buffer->Seek(MB - 256 * KB + 1000, SEEK_SET);
+  ASSERT_EQ(MB - 256 * KB + 1000, position);
+  ReadAndCheck(position, 256 * KB - 1000);
+}
+
+TEST_F(TestTimeshiftBuffer, ReadsSpilledDataFromFile)
+{
+  Open(3 * MB, 256 * KB, MB);
+  WaitForSource(3 * MB);
+  EXPECT_EQ(2 * MB, m_buffer->GetBegin());
+
+  // older than the memory ring, served from the file
+  int64_t position = m_buffer->Seek(2 * MB + 12345, SEEK_SET);
+  ASSERT_EQ(2 * MB + 12345, position);
+  ReadAndCheck(position, 10000);
+
+  // the whole window, wrapping around the end of the file and into memory
+  position = m_buffer->Seek(-MB + 1, SEEK_END);
+  ASSERT_EQ(2 * MB + 1, position);
+  ReadAndCheck(position, MB - 1);
+}
+
+TEST_F(TestTimeshiftBuffer, SkipsOverwrittenData)
+{
+  Open(3 * MB, 256 * KB, MB);
+  WaitForSource(3 * MB);
+
+  // the read position 0 was overwritten while paused, reading continues at the oldest data
+  uint8_t buf[10000];
+  const int read = m_buffer->Read(buf, sizeof(buf));
+  ASSERT_GT(read, 0);
+  const int64_t position = m_buffer->Seek(0, SEEK_CUR) - read;
+  EXPECT_EQ(m_buffer->GetBegin(), position);
+  EXPECT_TRUE(CheckData(buf, read, position));
+}
+
+TEST_F(TestTimeshiftBuffer, SeekStaysWithinBuffer)
+{
+  Open(3 * MB, 256 * KB, MB);
+  WaitForSource(3 * MB);
+
+  EXPECT_EQ(-1, m_buffer->Seek(100, SEEK_SET));
+  EXPECT_EQ(-1, m_buffer->Seek(2 * MB - 1, SEEK_SET));
+  EXPECT_EQ(-1, m_buffer->Seek(1, SEEK_END));
+  EXPECT_EQ(2 * MB, m_buffer->Seek(2 * MB, SEEK_SET));
+  EXPECT_EQ(3 * MB, m_buffer->Seek(0, SEEK_END));
+  EXPECT_EQ(3 * MB - 1000, m_buffer->Seek(-1000, SEEK_CUR));
+
+  // the last bytes, served from memory
+  uint8_t buf[10000];
+  EXPECT_EQ(1000, m_buffer->Read(buf, sizeof(buf)));
+  EXPECT_TRUE(CheckData(buf, 1000, 3 * MB - 1000));
+}
@@ -72,6 +72,8 @@ void CProcessInfo::ResetVideoCodecInfo()
   m_videoFPS = 0.0;
   m_videoDAR = 0.0;
   m_videoIsInterlaced = false;
+  m_videoDecoderHeadroom = 0.0f;
+  m_videoFilterTime = 0.0f;
   m_deintMethods.clear();
   m_deintMethods.push_back(EINTERLACEMETHOD::VS_INTERLACEMETHOD_NONE);
   m_deintMethodDefault = EINTERLACEMETHOD::VS_INTERLACEMETHOD_NONE;
@@ -233,6 +235,34 @@ bool CProcessInfo::GetVideoInterlaced()
   return m_videoIsInterlaced;
 }
 
+void CProcessInfo::SetVideoDecoderHeadroom(float headroom)
+{
+  CSingleLock lock(m_videoCodecSection);
+
+  m_videoDecoderHeadroom = headroom;
+}
+
+float CProcessInfo::GetVideoDecoderHeadroom()
+{
+  CSingleLock lock(m_videoCodecSection);
+
+  return m_videoDecoderHeadroom;
+}
+
+void CProcessInfo::SetVideoFilterTime(float ms)
+{
+  CSingleLock lock(m_videoCodecSection);
+
+  m_videoFilterTime = ms;
+}
+
+float CProcessInfo::GetVideoFilterTime()
+{
+  CSingleLock lock(m_videoCodecSection);
+
+  return m_videoFilterTime;
+}
+
 EINTERLACEMETHOD CProcessInfo::GetFallbackDeintMethod()
 {
   return VS_INTERLACEMETHOD_DEINTERLACE;
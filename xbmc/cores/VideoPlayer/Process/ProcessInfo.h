@@ -50,6 +50,10 @@ public:
   float GetVideoDAR();
   void SetVideoInterlaced(bool interlaced);
   bool GetVideoInterlaced();
+  void SetVideoDecoderHeadroom(float headroom);
+  float GetVideoDecoderHeadroom();
+  void SetVideoFilterTime(float ms);
+  float GetVideoFilterTime();
   virtual EINTERLACEMETHOD GetFallbackDeintMethod();
   virtual void SetSwDeinterlacingMethods();
   void UpdateDeinterlacingMethods(std::list<EINTERLACEMETHOD> &methods);
@@ -127,6 +131,8 @@ protected:
   float m_videoFPS;
   float m_videoDAR;
   bool m_videoIsInterlaced;
+  float m_videoDecoderHeadroom; // decode speed relative to the stream frame rate, 0 if unknown
+  float m_videoFilterTime; // average ms per frame spent in software filters (deinterlacing)
   std::list<EINTERLACEMETHOD> m_deintMethods;
   EINTERLACEMETHOD m_deintMethodDefault;
   CCriticalSection m_videoCodecSection;
@@ -9,9 +9,165 @@
 #include "VideoBuffer.h"
 
 #include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "utils/log.h"
 
 #include <string.h>
 
+namespace
+{
+// cached memory not asked for within this time is freed
+constexpr unsigned int IDLE_TIMEOUT_MS = 10000;
+// upper limit of cached memory, enough for a 4k queue of 10 bit frames
+constexpr uint64_t MAX_CACHED_BYTES = 512 * 1024 * 1024;
+// interval of idle trimming while pictures are decoded
+constexpr unsigned int TRIM_INTERVAL_MS = 1000;
+
+// round up to one of 8 size classes per power of two, wastes at most 12.5%
+int GetSizeClass(int size)
+{
+  int step = 4096;
+  while (step * 16 <= size)
+    step <<= 1;
+  return (size + step - 1) / step * step;
+}
+}
+
+//-----------------------------------------------------------------------------
+// CVideoBufferMemoryPool
+//-----------------------------------------------------------------------------
+
+CVideoBufferMemoryPool& CVideoBufferMemoryPool::GetInstance()
+{
+  static CVideoBufferMemoryPool pool;
+  return pool;
+}
+
+CVideoBufferMemoryPool::~CVideoBufferMemoryPool()
+{
+  FreeAll();
+}
+
+void CVideoBufferMemoryPool::AddClient()
+{
+  CSingleLock lock(m_critSection);
+  m_clients++;
+}
+
+void CVideoBufferMemoryPool::RemoveClient()
+{
+  CSingleLock lock(m_critSection);
+  if (--m_clients == 0)
+    FreeAll();
+}
+
+void CVideoBufferMemoryPool::FreeAll()
+{
+  for (auto& sizeClass : m_free)
+  {
+    for (auto& block : sizeClass.second)
+    {
+      delete[] block.data;
+      m_stats.trimmedBytes += sizeClass.first;
+    }
+  }
+  m_free.clear();
+  m_stats.cachedBytes = 0;
+}
+
+uint8_t* CVideoBufferMemoryPool::Allocate(int size, int& allocatedSize)
+{
+  allocatedSize = GetSizeClass(size);
+
+  CSingleLock lock(m_critSection);
+
+  Trim(XbmcThreads::SystemClockMillis());
+
+  auto it = m_free.find(allocatedSize);
+  if (it != m_free.end() && !it->second.empty())
+  {
+    // most recently freed block is most likely still in cache
+    uint8_t* data = it->second.back().data;
+    it->second.pop_back();
+    m_stats.cachedBytes -= allocatedSize;
+    m_stats.reuses++;
+    return data;
+  }
+
+  m_stats.allocations++;
+  m_stats.bytesAllocated += allocatedSize;
+  return new uint8_t[allocatedSize];
+}
+
+void CVideoBufferMemoryPool::Free(uint8_t* data, int allocatedSize)
+{
+  if (!data)
+    return;
+
+  CSingleLock lock(m_critSection);
+
+  if (m_clients == 0)
+  {
+    delete[] data;
+    return;
+  }
+
+  const unsigned int now = XbmcThreads::SystemClockMillis();
+  m_free[allocatedSize].push_back({data, now});
+  m_stats.cachedBytes += allocatedSize;
+
+  Trim(now);
+}
+
+void CVideoBufferMemoryPool::TrimIdle()
+{
+  const unsigned int now = XbmcThreads::SystemClockMillis();
+  if (now - m_lastTrim < TRIM_INTERVAL_MS)
+    return;
+
+  CSingleLock lock(m_critSection);
+  m_lastTrim = now;
+  Trim(now);
+}
+
+void CVideoBufferMemoryPool::Trim(unsigned int now)
+{
+  // blocks are queued in the order they were freed, oldest first
+  while (!m_free.empty())
+  {
+    auto oldest = m_free.end();
+    for (auto it = m_free.begin(); it != m_free.end();)
+    {
+      if (it->second.empty())
+      {
+        it = m_free.erase(it);
+        continue;
+      }
+      if (oldest == m_free.end() || it->second.front().freed < oldest->second.front().freed)
+        oldest = it;
+      ++it;
+    }
+
+    if (oldest == m_free.end())
+      break;
+
+    if (now - oldest->second.front().freed < IDLE_TIMEOUT_MS &&
+        m_stats.cachedBytes <= MAX_CACHED_BYTES)
+      break;
+
+    delete[] oldest->second.front().data;
+    oldest->second.pop_front();
+    m_stats.cachedBytes -= oldest->first;
+    m_stats.trimmedBytes += oldest->first;
+  }
+}
+
+CVideoBufferMemoryPool::SStatistics CVideoBufferMemoryPool::GetStatistics()
+{
+  CSingleLock lock(m_critSection);
+  return m_stats;
+}
+
 //-----------------------------------------------------------------------------
 // CVideoBuffer
 //-----------------------------------------------------------------------------
@@ -31,6 +187,10 @@ void CVideoBuffer::Acquire(std::shared_ptr<IVideoBufferPool> pool)
 {
   m_refCount++;
   m_pool = pool;
+
+  // every pool hands out its pictures here, which makes it the steady state
+  // hook for giving back cached memory of previous streams
+  CVideoBufferMemoryPool::GetInstance().TrimIdle();
 }
 
 void CVideoBuffer::Release()
@@ -181,7 +341,7 @@ CVideoBufferSysMem::CVideoBufferSysMem(IVideoBufferPool &pool, int id, AVPixelFo
 
 CVideoBufferSysMem::~CVideoBufferSysMem()
 {
-  delete[] m_data;
+  CVideoBufferMemoryPool::GetInstance().Free(m_data, m_allocatedSize);
 }
 
 uint8_t* CVideoBufferSysMem::GetMemPtr()
@@ -267,7 +427,7 @@ void CVideoBufferSysMem::SetDimensions(int width, int height, const int (&stride
 
 bool CVideoBufferSysMem::Alloc()
 {
-  m_data = new uint8_t[m_size];
+  m_data = CVideoBufferMemoryPool::GetInstance().Allocate(m_size, m_allocatedSize);
   return true;
 }
 
@@ -378,6 +538,12 @@ CVideoBufferManager::CVideoBufferManager()
 {
   CSingleLock lock(m_critSection);
   RegisterPoolFactory("SysMem", &CVideoBufferPoolSysMem::CreatePool);
+  CVideoBufferMemoryPool::GetInstance().AddClient();
+}
+
+CVideoBufferManager::~CVideoBufferManager()
+{
+  CVideoBufferMemoryPool::GetInstance().RemoveClient();
 }
 
 void CVideoBufferManager::RegisterPool(std::shared_ptr<IVideoBufferPool> pool)
@@ -405,6 +571,15 @@ void CVideoBufferManager::ReleasePools()
   {
     pool->Discard(this, &CVideoBufferManager::ReadyForDisposal);
   }
+
+  CVideoBufferMemoryPool::GetInstance().TrimIdle();
+  const CVideoBufferMemoryPool::SStatistics stats =
+      CVideoBufferMemoryPool::GetInstance().GetStatistics();
+  CLog::Log(LOGDEBUG,
+            "CVideoBufferManager::{} - picture memory: {} allocations ({} MiB), {} reuses, "
+            "{} MiB cached, {} MiB trimmed",
+            __FUNCTION__, stats.allocations, stats.bytesAllocated >> 20, stats.reuses,
+            stats.cachedBytes >> 20, stats.trimmedBytes >> 20);
 }
 
 void CVideoBufferManager::ReleasePool(IVideoBufferPool *pool)
@@ -39,6 +39,67 @@ struct YuvImage
 //
 //-----------------------------------------------------------------------------
 
+/**
+ * Process wide cache of picture memory. Frames of a stream tend to have the
+ * same size, so memory freed when a codec is closed (stream change, channel
+ * switch) is kept in size classes and handed out again to the next one.
+ * Memory not asked for within a while, or once no video buffer manager is
+ * left, is given back to the system.
+ *
+ * Frames of CVideoBufferPoolFFmpeg are not allocated here. Their memory comes
+ * from the buffer pool of the libavcodec context, which applies the alignment
+ * and padding rules of the codec and is freed together with the context.
+ * Those frames still drive the trimming of this cache, see TrimIdle().
+ */
+class CVideoBufferMemoryPool
+{
+public:
+  struct SStatistics
+  {
+    uint64_t allocations = 0; // served from the heap
+    uint64_t reuses = 0; // served from the cache
+    uint64_t bytesAllocated = 0; // total bytes taken from the heap
+    uint64_t cachedBytes = 0;
+    uint64_t trimmedBytes = 0;
+  };
+
+  static CVideoBufferMemoryPool& GetInstance();
+
+  // memory is only cached while there are clients
+  void AddClient();
+  void RemoveClient();
+
+  uint8_t* Allocate(int size, int& allocatedSize);
+  void Free(uint8_t* data, int allocatedSize);
+  SStatistics GetStatistics();
+
+  // free memory that wasn't asked for within a while. called whenever a pool
+  // hands out a picture, so it only checks the cache once per second
+  void TrimIdle();
+
+private:
+  CVideoBufferMemoryPool() = default;
+  ~CVideoBufferMemoryPool();
+  void Trim(unsigned int now);
+  void FreeAll();
+
+  struct Block
+  {
+    uint8_t* data;
+    unsigned int freed;
+  };
+
+  CCriticalSection m_critSection;
+  std::map<int, std::deque<Block>> m_free;
+  SStatistics m_stats;
+  int m_clients = 0;
+  std::atomic<unsigned int> m_lastTrim{0};
+};
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+
 #define BUFFER_STATE_DECODER 0x01;
 #define BUFFER_STATE_RENDER  0x02;
 
@@ -127,6 +188,7 @@ protected:
   int m_width = 0;
   int m_height = 0;
   int m_size = 0;
+  int m_allocatedSize = 0;
   uint8_t *m_data = nullptr;
   YuvImage m_image;
 };
@@ -173,6 +235,7 @@ class CVideoBufferManager
 {
 public:
   CVideoBufferManager();
+  ~CVideoBufferManager();
   void RegisterPool(std::shared_ptr<IVideoBufferPool> pool);
   void RegisterPoolFactory(std::string id, CreatePoolFunc createFunc);
   void ReleasePools();
@@ -670,6 +670,7 @@ bool CVideoPlayer::OpenFile(const CFileItem& file, const CPlayerOptions &options
 
   m_item = file;
   m_playerOptions = options;
+  m_openFileTime = XbmcThreads::SystemClockMillis();
   // Try to resolve the correct mime type
   m_item.SetMimeTypeForInternetFile();
 
@@ -2492,6 +2493,7 @@ void CVideoPlayer::HandleMessages()
 
       m_item = msg.GetItem();
       m_playerOptions = msg.GetOptions();
+      m_openFileTime = XbmcThreads::SystemClockMillis();
 
       m_processInfo->SetPlayTimes(0,0,0,0);
 
@@ -2883,6 +2885,14 @@ void CVideoPlayer::HandleMessages()
         m_CurrentVideo.starttime = msg.timestamp;
       }
       CLog::Log(LOGDEBUG, "CVideoPlayer::HandleMessages - player started %d", msg.player);
+
+      if (m_openFileTime != 0 &&
+          (msg.player == VideoPlayer_VIDEO || (msg.player == VideoPlayer_AUDIO && m_CurrentVideo.id < 0)))
+      {
+        CLog::Log(LOGDEBUG, "CVideoPlayer::HandleMessages - first frame %u ms after open",
+                  XbmcThreads::SystemClockMillis() - m_openFileTime);
+        m_openFileTime = 0;
+      }
     }
     else if (pMsg->IsType(CDVDMsg::PLAYER_REPORT_STATE))
     {
@@ -4775,6 +4785,15 @@ bool CVideoPlayer::IsRenderingVideo()
   return m_renderManager.IsConfigured();
 }
 
+bool CVideoPlayer::GetRenderTimings(std::vector<CRenderTimings::SFrameTiming>& frames,
+                                    CRenderTimings::SStatistics& statistics)
+{
+  const CRenderTimings& timings = m_renderManager.GetTimings();
+  frames = timings.GetFrames();
+  statistics = timings.GetStatistics();
+  return true;
+}
+
 bool CVideoPlayer::Supports(EINTERLACEMETHOD method)
 {
   if (!m_processInfo)
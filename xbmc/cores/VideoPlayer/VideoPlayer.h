@@ -314,6 +314,8 @@ public:
   float GetRenderAspectRatio() override;
   void TriggerUpdateResolution() override;
   bool IsRenderingVideo() override;
+  bool GetRenderTimings(std::vector<CRenderTimings::SFrameTiming>& frames,
+                        CRenderTimings::SStatistics& statistics) override;
   bool Supports(EINTERLACEMETHOD method) override;
   EINTERLACEMETHOD GetDeinterlacingMethodDefault() override;
   bool Supports(ESCALINGMETHOD method) override;
@@ -441,6 +443,7 @@ protected:
 
   CFileItem m_item;
   CPlayerOptions m_playerOptions;
+  unsigned int m_openFileTime = 0; // time the current item was opened, reset at first frame
   bool m_bAbortRequest;
   bool m_error;
   bool m_bCloseRequest;
@@ -17,6 +17,7 @@
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
 #include "utils/MathUtils.h"
+#include "utils/TimeUtils.h"
 #include "utils/log.h"
 #include "windowing/GraphicContext.h"
 #include "windowing/WinSystem.h"
@@ -658,6 +659,8 @@ bool CVideoPlayerVideo::ProcessDecoderOutput(double &frametime, double &pts)
   {
     bool hasTimestamp = true;
 
+    m_picture.decoded = CurrentHostCounter();
+
     m_picture.iDuration = frametime;
 
     // validate picture timing,
@@ -939,6 +942,14 @@ std::string CVideoPlayerVideo::GetPlayerInfo()
   s << ", drop:" << m_iDroppedFrames;
   s << ", skip:" << m_renderManager.GetSkippedFrames();
 
+  float headroom = m_processInfo.GetVideoDecoderHeadroom();
+  if (headroom > 0.0f)
+    s << ", hr:" << std::fixed << std::setprecision(1) << headroom << "x";
+
+  float filterTime = m_processInfo.GetVideoFilterTime();
+  if (filterTime > 0.0f)
+    s << ", flt:" << std::fixed << std::setprecision(1) << filterTime << "ms";
+
   int pc = m_ptsTracker.GetPatternLength();
   if (pc > 0)
     s << ", pc:" << pc;
@@ -1666,6 +1666,14 @@ bool CLinuxRendererGL::RenderCapture(CRenderCapture* capture)
   if (!m_bValidated)
     return false;
 
+  // pictures in system memory are scaled on the CPU unless they are cropped or rotated
+  CPictureBuffer& buf = m_buffers[m_iYV12RenderBuffer];
+  if (buf.videoBuffer && m_renderOrientation == 0 &&
+      m_sourceRect == CRect(0.0f, 0.0f, m_sourceWidth, m_sourceHeight) &&
+      capture->CaptureSoftware(*buf.videoBuffer, m_sourceWidth, m_sourceHeight, buf.m_srcColSpace,
+                               buf.m_srcFullRange))
+    return true;
+
   // save current video rect
   CRect saveSize = m_destRect;
 
@@ -1177,6 +1177,14 @@ bool CLinuxRendererGLES::RenderCapture(CRenderCapture* capture)
     return false;
   }
 
+  // pictures in system memory are scaled on the CPU unless they are cropped or rotated
+  CPictureBuffer& buf = m_buffers[m_iYV12RenderBuffer];
+  if (buf.videoBuffer && m_renderOrientation == 0 &&
+      m_sourceRect == CRect(0.0f, 0.0f, m_sourceWidth, m_sourceHeight) &&
+      capture->CaptureSoftware(*buf.videoBuffer, m_sourceWidth, m_sourceHeight, buf.m_srcColSpace,
+                               buf.m_srcFullRange))
+    return true;
+
   // save current video rect
   CRect saveSize = m_destRect;
   saveRotatedCoords(); // backup current m_rotatedDestCoords
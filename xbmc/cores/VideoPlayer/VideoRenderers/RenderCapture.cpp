@@ -8,6 +8,8 @@
 
 #include "RenderCapture.h"
 #include "ServiceBroker.h"
+#include "SoftwareConverter.h"
+#include "cores/VideoPlayer/Process/VideoBuffer.h"
 #include "utils/log.h"
 #include "windowing/WinSystem.h"
 #include "settings/AdvancedSettings.h"
@@ -22,6 +24,7 @@
 
 extern "C" {
 #include <libavutil/mem.h>
+#include <libavutil/pixdesc.h>
 }
 
 CRenderCaptureBase::CRenderCaptureBase()
@@ -39,6 +42,41 @@ CRenderCaptureBase::CRenderCaptureBase()
 
 CRenderCaptureBase::~CRenderCaptureBase() = default;
 
+bool CRenderCaptureBase::CaptureSoftware(CVideoBuffer& buffer, int width, int height, AVColorSpace colorSpace, bool fullRange)
+{
+  uint8_t* planes[YuvImage::MAX_PLANES] = {};
+  int strides[YuvImage::MAX_PLANES] = {};
+  buffer.GetPlanes(planes);
+  buffer.GetStrides(strides);
+
+  const AVPixelFormat format = buffer.GetFormat();
+  if (!planes[0] || av_pix_fmt_count_planes(format) > YuvImage::MAX_PLANES ||
+      !sws_isSupportedInput(format) || m_width == 0 || m_height == 0)
+    return false;
+
+  if (!m_converter)
+    m_converter = std::make_unique<CSoftwareConverter>();
+
+  if (!m_converter->Configure(width, height, format, m_width, m_height, AV_PIX_FMT_BGRA,
+                              colorSpace, fullRange))
+    return false;
+
+  if (m_bufferSize != m_width * m_height * 4)
+  {
+    delete[] m_pixels;
+    m_bufferSize = m_width * m_height * 4;
+    m_pixels = new uint8_t[m_bufferSize];
+  }
+
+  uint8_t* dst[YuvImage::MAX_PLANES] = {m_pixels};
+  int dstStrides[YuvImage::MAX_PLANES] = {static_cast<int>(m_width * 4)};
+  if (!m_converter->Convert(planes, strides, dst, dstStrides))
+    return false;
+
+  SetState(CAPTURESTATE_DONE);
+  return true;
+}
+
 bool CRenderCaptureBase::UseOcclusionQuery()
 {
   if (m_flags & CAPTUREFLAG_IMMEDIATELY)
@@ -92,6 +130,7 @@ void CRenderCaptureDispmanX::ReadOut()
 CRenderCaptureGL::CRenderCaptureGL()
 {
   m_pbo   = 0;
+  m_pboSize = 0;
   m_query = 0;
   m_occlusionQuerySupported = false;
 }
@@ -184,10 +223,15 @@ void CRenderCaptureGL::BeginRender()
 
     //allocate data on the pbo and pixel buffer
     glBindBuffer(GL_PIXEL_PACK_BUFFER, m_pbo);
+    if (m_pboSize != m_width * m_height * 4)
+    {
+      m_pboSize = m_width * m_height * 4;
+      glBufferData(GL_PIXEL_PACK_BUFFER, m_pboSize, 0, GL_STREAM_READ);
+    }
+    // the pixel buffer may have been allocated by a capture in system memory already
     if (m_bufferSize != m_width * m_height * 4)
     {
       m_bufferSize = m_width * m_height * 4;
-      glBufferData(GL_PIXEL_PACK_BUFFER, m_bufferSize, 0, GL_STREAM_READ);
       delete[] m_pixels;
       m_pixels = new uint8_t[m_bufferSize];
     }
@@ -15,6 +15,14 @@
 
 #include "threads/Event.h"
 
+#include <memory>
+
+extern "C" {
+#include <libavutil/pixfmt.h>
+}
+
+class CSoftwareConverter;
+class CVideoBuffer;
 
 enum ECAPTURESTATE
 {
@@ -82,6 +90,13 @@ class CRenderCaptureBase
     */
     bool  IsAsync() { return m_asyncSupported; }
 
+    /* \brief Called by the renderer to capture a picture in system memory on the CPU, which saves
+       rendering it and reading it back from the GPU. The capture is done right away.
+       \return false if the picture is not in system memory or can't be converted, it has to be
+       rendered then
+    */
+    bool CaptureSoftware(CVideoBuffer& buffer, int width, int height, AVColorSpace colorSpace, bool fullRange);
+
   protected:
     bool UseOcclusionQuery();
 
@@ -98,6 +113,8 @@ class CRenderCaptureBase
     //this is set after the first render
     bool m_asyncSupported;
     bool m_asyncChecked;
+
+    std::unique_ptr<CSoftwareConverter> m_converter;
 };
 
 #if defined(TARGET_RASPBERRY_PI)
@@ -146,6 +163,7 @@ class CRenderCaptureGL : public CRenderCaptureBase
   private:
     void   PboToBuffer();
     GLuint m_pbo;
+    unsigned int m_pboSize;
     GLuint m_query;
     bool   m_occlusionQuerySupported;
 };
@@ -216,6 +216,7 @@ bool CRenderManager::Configure()
     m_presentsourcePast = -1;
     for (int i=1; i < m_QueueSize; i++)
       m_free.push_back(i);
+    m_timings.Reset();
 
     m_bRenderGUI = true;
     m_bTriggerUpdateResolution = true;
@@ -398,6 +399,9 @@ void CRenderManager::UnInit()
   m_overlays.Flush();
   m_debugRenderer.Flush();
 
+  if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->CanLogComponent(LOGAVTIMING))
+    m_timings.SaveCSV("special://temp/rendertimings.csv");
+
   DeleteRenderer();
 
   m_renderState = STATE_UNCONFIGURED;
@@ -439,6 +443,7 @@ bool CRenderManager::Flush(bool wait, bool saveBuffers)
         m_presentstep = PRESENT_IDLE;
         for (int i = 1; i < m_QueueSize; i++)
           m_free.push_back(i);
+        m_timings.Reset();
       }
 
       m_flushEvent.Set();
@@ -739,6 +744,11 @@ void CRenderManager::Render(bool clear, DWORD flags, DWORD alpha, bool gui)
                                      clockspeed * 100);
       }
 
+      const CRenderTimings::SStatistics stats = m_timings.GetStatistics();
+      vsync += StringUtils::Format(" Frames: wait:%.1fms latency:%.1fms interval:%.1fms jitter:%.1fms skipped:%u/%u",
+                                   stats.wait, stats.latency, stats.interval, stats.jitter,
+                                   stats.skipped, stats.frames);
+
       m_debugRenderer.SetInfo(audio, video, player, vsync);
       m_debugRenderer.Render(src, dst, view);
 
@@ -757,10 +767,16 @@ void CRenderManager::Render(bool clear, DWORD flags, DWORD alpha, bool gui)
       if (m.presentmethod == PRESENT_METHOD_BOB)
         m_presentstep = PRESENT_FRAME2;
       else
+      {
         m_presentstep = PRESENT_IDLE;
+        m_timings.FrameRendered(m_presentsource);
+      }
     }
     else if (m_presentstep == PRESENT_FRAME2)
+    {
       m_presentstep = PRESENT_IDLE;
+      m_timings.FrameRendered(m_presentsource);
+    }
 
     if (m_presentstep == PRESENT_IDLE)
     {
@@ -962,6 +978,7 @@ bool CRenderManager::AddVideoPicture(const VideoPicture& picture, volatile std::
   m.presentfield = displayField;
   m.presentmethod = presentmethod;
   m.pts = picture.pts;
+  m_timings.FrameQueued(index, picture.pts, picture.decoded);
   m_queued.push_back(m_free.front());
   m_free.pop_front();
   m_playerPort->UpdateRenderBuffers(m_queued.size(), m_discard.size(), m_free.size());
@@ -1156,6 +1173,7 @@ void CRenderManager::PrepareNextRender()
         m_discard.push_back(m_presentsourcePast);
         m_QueueSkip++;
       }
+      m_timings.FrameSkipped(m_queued.front());
       m_presentsourcePast = m_queued.front();
       m_queued.pop_front();
     }
@@ -1170,6 +1188,7 @@ void CRenderManager::PrepareNextRender()
     m_discard.push_back(m_presentsource);
     m_presentsource = idx;
     m_queued.pop_front();
+    m_timings.FramePresented(idx);
     m_presentpts = m_Queue[idx].pts - m_displayLatency;
     m_presentevent.notifyAll();
 
@@ -1182,6 +1201,7 @@ void CRenderManager::PrepareNextRender()
     m_presentsourcePast = m_presentsource;
     m_presentsource = m_queued.front();
     m_queued.pop_front();
+    m_timings.FramePresented(m_presentsource);
     m_presentpts = m_Queue[m_presentsource].pts - m_displayLatency - frametime / 2;
     m_presentevent.notifyAll();
   }
@@ -0,0 +1,201 @@
+/*
+ *  Copyright (C) 2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "RenderTimings.h"
+
+#include "cores/VideoPlayer/VideoRenderers/BaseRenderer.h"
+#include "filesystem/File.h"
+#include "threads/SingleLock.h"
+#include "utils/StringUtils.h"
+#include "utils/TimeUtils.h"
+#include "utils/log.h"
+
+#include <cmath>
+
+namespace
+{
+int64_t ToUs(int64_t counter)
+{
+  // counter * 1000000 would overflow after a few hours with a nanosecond counter
+  return static_cast<int64_t>(counter * (1000000.0 / CurrentHostFrequency()));
+}
+
+bool IsValidIndex(int index)
+{
+  return index >= 0 && index < NUM_BUFFERS;
+}
+} // namespace
+
+CRenderTimings::CRenderTimings(size_t capacity)
+  : m_pending(NUM_BUFFERS), m_isPending(NUM_BUFFERS, false), m_capacity(capacity)
+{
+  m_frames.reserve(m_capacity);
+}
+
+int64_t CRenderTimings::GetTimeUs() const
+{
+  return ToUs(CurrentHostCounter());
+}
+
+void CRenderTimings::Reset()
+{
+  CSingleLock lock(m_critSection);
+  m_isPending.assign(NUM_BUFFERS, false);
+  m_frames.clear();
+  m_next = 0;
+}
+
+void CRenderTimings::FrameQueued(int index, double pts, int64_t decoded)
+{
+  if (!IsValidIndex(index))
+    return;
+
+  CSingleLock lock(m_critSection);
+  m_pending[index] = SFrameTiming();
+  m_pending[index].pts = pts;
+  m_pending[index].decoded = decoded > 0 ? ToUs(decoded) : 0;
+  m_pending[index].queued = GetTimeUs();
+  m_isPending[index] = true;
+}
+
+void CRenderTimings::FramePresented(int index)
+{
+  if (!IsValidIndex(index))
+    return;
+
+  CSingleLock lock(m_critSection);
+  if (m_isPending[index])
+    m_pending[index].presented = GetTimeUs();
+}
+
+void CRenderTimings::FrameRendered(int index)
+{
+  if (!IsValidIndex(index))
+    return;
+
+  CSingleLock lock(m_critSection);
+  if (m_isPending[index])
+  {
+    m_pending[index].rendered = GetTimeUs();
+    Finish(index);
+  }
+}
+
+void CRenderTimings::FrameSkipped(int index)
+{
+  if (!IsValidIndex(index))
+    return;
+
+  CSingleLock lock(m_critSection);
+  if (m_isPending[index])
+  {
+    m_pending[index].skipped = true;
+    Finish(index);
+  }
+}
+
+void CRenderTimings::Finish(int index)
+{
+  if (m_frames.size() < m_capacity)
+    m_frames.push_back(m_pending[index]);
+  else
+    m_frames[m_next] = m_pending[index];
+
+  m_next = (m_next + 1) % m_capacity;
+  m_isPending[index] = false;
+}
+
+std::vector<CRenderTimings::SFrameTiming> CRenderTimings::GetFrames() const
+{
+  CSingleLock lock(m_critSection);
+
+  // oldest record first
+  std::vector<SFrameTiming> frames;
+  frames.reserve(m_frames.size());
+  if (m_frames.size() == m_capacity)
+    frames.insert(frames.end(), m_frames.begin() + m_next, m_frames.end());
+  frames.insert(frames.end(), m_frames.begin(),
+                m_frames.size() == m_capacity ? m_frames.begin() + m_next : m_frames.end());
+  return frames;
+}
+
+CRenderTimings::SStatistics CRenderTimings::GetStatistics() const
+{
+  SStatistics stats;
+  const std::vector<SFrameTiming> frames = GetFrames();
+
+  double wait = 0.0;
+  unsigned int decoded = 0;
+  double latency = 0.0;
+  std::vector<double> intervals;
+  int64_t lastRendered = 0;
+  for (const auto& frame : frames)
+  {
+    stats.frames++;
+    if (frame.skipped)
+    {
+      stats.skipped++;
+      continue;
+    }
+
+    if (frame.decoded > 0)
+    {
+      wait += (frame.queued - frame.decoded) / 1000.0;
+      decoded++;
+    }
+    latency += (frame.rendered - frame.queued) / 1000.0;
+    if (lastRendered > 0)
+      intervals.push_back((frame.rendered - lastRendered) / 1000.0);
+    lastRendered = frame.rendered;
+  }
+
+  const unsigned int rendered = stats.frames - stats.skipped;
+  if (rendered > 0)
+    stats.latency = latency / rendered;
+  if (decoded > 0)
+    stats.wait = wait / decoded;
+
+  if (!intervals.empty())
+  {
+    for (double interval : intervals)
+      stats.interval += interval;
+    stats.interval /= intervals.size();
+
+    double variance = 0.0;
+    for (double interval : intervals)
+      variance += (interval - stats.interval) * (interval - stats.interval);
+    stats.jitter = std::sqrt(variance / intervals.size());
+  }
+
+  return stats;
+}
+
+bool CRenderTimings::SaveCSV(const std::string& path) const
+{
+  const std::vector<SFrameTiming> frames = GetFrames();
+  if (frames.empty())
+    return false;
+
+  std::string csv = "pts,decoded,queued,presented,rendered,skipped\n";
+  for (const auto& frame : frames)
+  {
+    csv += StringUtils::Format("%.0f,%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%d\n",
+                               frame.pts, frame.decoded, frame.queued, frame.presented,
+                               frame.rendered, frame.skipped ? 1 : 0);
+  }
+
+  XFILE::CFile file;
+  if (!file.OpenForWrite(path, true) ||
+      file.Write(csv.c_str(), csv.size()) != static_cast<ssize_t>(csv.size()))
+  {
+    CLog::Log(LOGERROR, "CRenderTimings::SaveCSV - failed to write %s", path.c_str());
+    return false;
+  }
+
+  return true;
+}
@@ -0,0 +1,84 @@
+/*
+ *  Copyright (C) 2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/*!
+ * Keeps timing records of the most recent frames passing through the render manager.
+ * A frame is tracked by its render buffer index from the moment it is queued until it
+ * has been rendered or skipped, then moved into a fixed size ring of finished records.
+ */
+class CRenderTimings
+{
+public:
+  struct SFrameTiming
+  {
+    double pts = 0.0;
+    int64_t decoded = 0; // host time in us when the decoder returned the frame, 0 if unknown
+    int64_t queued = 0; // host time in us when the frame was added to the queue
+    int64_t presented = 0; // host time in us when the frame was picked for display
+    int64_t rendered = 0; // host time in us when rendering of the frame was finished
+    bool skipped = false;
+  };
+
+  struct SStatistics
+  {
+    unsigned int frames = 0;
+    unsigned int skipped = 0;
+    double wait = 0.0; // average time from decoded to queued (waiting for a render buffer) in ms
+    double latency = 0.0; // average time from queued to rendered in ms
+    double interval = 0.0; // average time between two rendered frames in ms
+    double jitter = 0.0; // standard deviation of the render interval in ms
+  };
+
+  explicit CRenderTimings(size_t capacity = 512);
+  virtual ~CRenderTimings() = default;
+
+  void Reset();
+
+  /*!
+   * \brief A frame was added to the queue
+   * \param index the render buffer of the frame
+   * \param pts the presentation time stamp of the frame
+   * \param decoded the host counter when the decoder returned the frame, 0 if unknown
+   */
+  void FrameQueued(int index, double pts, int64_t decoded);
+  void FramePresented(int index);
+  void FrameRendered(int index);
+  void FrameSkipped(int index);
+
+  std::vector<SFrameTiming> GetFrames() const;
+  SStatistics GetStatistics() const;
+
+  /*!
+   * \brief Write the finished records as CSV
+   * \param path the file to write to
+   * \return true on success, false otherwise
+   */
+  bool SaveCSV(const std::string& path) const;
+
+protected:
+  // host time in us
+  virtual int64_t GetTimeUs() const;
+
+private:
+  void Finish(int index);
+
+  mutable CCriticalSection m_critSection;
+  std::vector<SFrameTiming> m_pending; // by render buffer index
+  std::vector<bool> m_isPending;
+  std::vector<SFrameTiming> m_frames;
+  size_t m_capacity;
+  size_t m_next = 0;
+};
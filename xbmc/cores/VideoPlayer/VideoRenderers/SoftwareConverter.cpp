@@ -0,0 +1,249 @@
+/*
+ *  Copyright (C) 2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "SoftwareConverter.h"
+
+#include "ServiceBroker.h"
+#include "threads/Event.h"
+#include "threads/Thread.h"
+#include "utils/CPUInfo.h"
+#include "utils/TimeUtils.h"
+#include "utils/log.h"
+
+#include <algorithm>
+
+extern "C" {
+#include <libavutil/pixdesc.h>
+}
+
+namespace
+{
+// bands are a multiple of this, covers the chroma subsampling of all formats
+constexpr int BAND_ALIGNMENT = 16;
+// smaller bands don't pay off the synchronisation
+constexpr int MIN_BAND_HEIGHT = 64;
+constexpr int MAX_BANDS = 8;
+
+int GetPlaneShift(const AVPixFmtDescriptor* desc, int plane)
+{
+  // plane 0 is luma or packed, 3 is alpha, both unsubsampled
+  if (!desc || plane == 0 || plane == 3)
+    return 0;
+  return desc->log2_chroma_h;
+}
+}
+
+class CSoftwareConverter::CWorker : public CThread
+{
+public:
+  explicit CWorker(CSoftwareConverter& converter)
+    : CThread("SWConverter"), m_converter(converter)
+  {
+  }
+
+  ~CWorker() override { StopThread(); }
+
+  void Start(const Band& band)
+  {
+    m_band = &band;
+    m_work.Set();
+  }
+
+  void Wait() { m_done.Wait(); }
+
+protected:
+  void Process() override
+  {
+    while (!m_bStop)
+    {
+      if (AbortableWait(m_work) != WAIT_SIGNALED)
+        break;
+
+      m_converter.ConvertBand(*m_band);
+      m_done.Set();
+    }
+  }
+
+private:
+  CSoftwareConverter& m_converter;
+  const Band* m_band = nullptr;
+  CEvent m_work;
+  CEvent m_done;
+};
+
+CSoftwareConverter::CSoftwareConverter() = default;
+
+CSoftwareConverter::~CSoftwareConverter()
+{
+  LogStatistics();
+  Reset();
+}
+
+void CSoftwareConverter::Reset()
+{
+  m_workers.clear();
+
+  for (auto& band : m_bands)
+    sws_freeContext(band.context);
+  m_bands.clear();
+
+  m_pixels = 0;
+  m_ticks = 0;
+  m_frames = 0;
+}
+
+bool CSoftwareConverter::Configure(int srcWidth, int srcHeight, AVPixelFormat srcFormat,
+                                   int dstWidth, int dstHeight, AVPixelFormat dstFormat,
+                                   AVColorSpace colorSpace, bool fullRange)
+{
+  if (!m_bands.empty() &&
+      srcWidth == m_srcWidth && srcHeight == m_srcHeight && srcFormat == m_srcFormat &&
+      dstWidth == m_dstWidth && dstHeight == m_dstHeight && dstFormat == m_dstFormat &&
+      colorSpace == m_colorSpace && fullRange == m_fullRange)
+    return true;
+
+  LogStatistics();
+  Reset();
+
+  m_srcWidth = srcWidth;
+  m_srcHeight = srcHeight;
+  m_srcFormat = srcFormat;
+  m_dstWidth = dstWidth;
+  m_dstHeight = dstHeight;
+  m_dstFormat = dstFormat;
+  m_colorSpace = colorSpace;
+  m_fullRange = fullRange;
+
+  // swscale needs the whole source for vertical scaling, so bands are only
+  // possible if the height is kept. Chroma at band edges is clamped like at
+  // the picture edges, which is invisible for aligned bands.
+  int bands = 1;
+  if (srcHeight == dstHeight)
+  {
+    bands = std::min(CServiceBroker::GetCPUInfo()->GetCPUCount(), MAX_BANDS);
+    bands = std::max(1, std::min(bands, srcHeight / MIN_BAND_HEIGHT));
+  }
+
+  int bandHeight = (srcHeight + bands - 1) / bands;
+  bandHeight = (bandHeight + BAND_ALIGNMENT - 1) / BAND_ALIGNMENT * BAND_ALIGNMENT;
+
+  for (int y = 0; y < srcHeight; y += bandHeight)
+  {
+    Band band;
+    band.y = y;
+    band.height = std::min(bandHeight, srcHeight - y);
+
+    const int dstBandHeight = bands > 1 ? band.height : dstHeight;
+    band.context = sws_getContext(srcWidth, band.height, srcFormat,
+                                  dstWidth, dstBandHeight, dstFormat,
+                                  SWS_FAST_BILINEAR, nullptr, nullptr, nullptr);
+    if (!band.context)
+    {
+      CLog::Log(LOGERROR, "CSoftwareConverter::{} - unable to create context for {}x{} {} -> {}x{} {}",
+                __FUNCTION__, srcWidth, srcHeight, av_get_pix_fmt_name(srcFormat),
+                dstWidth, dstHeight, av_get_pix_fmt_name(dstFormat));
+      Reset();
+      return false;
+    }
+
+    sws_setColorspaceDetails(band.context,
+                             sws_getCoefficients(colorSpace), fullRange,
+                             sws_getCoefficients(AVCOL_SPC_BT709), fullRange,
+                             0, 1 << 16, 1 << 16);
+
+    m_bands.push_back(band);
+  }
+
+  // the calling thread converts the first band itself
+  for (size_t i = 1; i < m_bands.size(); ++i)
+  {
+    m_workers.emplace_back(new CWorker(*this));
+    m_workers.back()->Create();
+  }
+
+  CLog::Log(LOGDEBUG, "CSoftwareConverter::{} - {}x{} {} -> {}x{} {} in {} band(s)", __FUNCTION__,
+            srcWidth, srcHeight, av_get_pix_fmt_name(srcFormat), dstWidth, dstHeight,
+            av_get_pix_fmt_name(dstFormat), m_bands.size());
+
+  return true;
+}
+
+bool CSoftwareConverter::Convert(uint8_t* const src[], const int srcStride[],
+                                 uint8_t* const dst[], const int dstStride[])
+{
+  if (m_bands.empty())
+    return false;
+
+  const int64_t start = CurrentHostCounter();
+
+  m_src = src;
+  m_srcStride = srcStride;
+  m_dst = dst;
+  m_dstStride = dstStride;
+
+  for (size_t i = 1; i < m_bands.size(); ++i)
+    m_workers[i - 1]->Start(m_bands[i]);
+
+  ConvertBand(m_bands[0]);
+
+  for (auto& worker : m_workers)
+    worker->Wait();
+
+  m_src = m_dst = nullptr;
+  m_srcStride = m_dstStride = nullptr;
+
+  m_ticks += CurrentHostCounter() - start;
+  m_pixels += static_cast<uint64_t>(m_dstWidth) * m_dstHeight;
+  m_frames++;
+
+  return true;
+}
+
+void CSoftwareConverter::ConvertBand(const Band& band)
+{
+  const AVPixFmtDescriptor* srcDesc = av_pix_fmt_desc_get(m_srcFormat);
+  const AVPixFmtDescriptor* dstDesc = av_pix_fmt_desc_get(m_dstFormat);
+
+  // without bands the destination starts at the top, too
+  const int dstY = m_bands.size() > 1 ? band.y : 0;
+
+  const uint8_t* src[4] = {};
+  int srcStride[4] = {};
+  for (int plane = 0; plane < std::min(av_pix_fmt_count_planes(m_srcFormat), 4); ++plane)
+  {
+    srcStride[plane] = m_srcStride[plane];
+    src[plane] = m_src[plane] + (band.y >> GetPlaneShift(srcDesc, plane)) * srcStride[plane];
+  }
+
+  uint8_t* dst[4] = {};
+  int dstStride[4] = {};
+  for (int plane = 0; plane < std::min(av_pix_fmt_count_planes(m_dstFormat), 4); ++plane)
+  {
+    dstStride[plane] = m_dstStride[plane];
+    dst[plane] = m_dst[plane] + (dstY >> GetPlaneShift(dstDesc, plane)) * dstStride[plane];
+  }
+
+  sws_scale(band.context, src, srcStride, 0, band.height, dst, dstStride);
+}
+
+double CSoftwareConverter::GetPixelRate() const
+{
+  if (m_ticks <= 0)
+    return 0.0;
+  return static_cast<double>(m_pixels) * CurrentHostFrequency() / m_ticks;
+}
+
+void CSoftwareConverter::LogStatistics()
+{
+  if (!m_frames)
+    return;
+
+  CLog::Log(LOGDEBUG, "CSoftwareConverter::{} - {} frames of {}x{} {}, {:.1f} Mpixel/s", __FUNCTION__,
+            m_frames, m_dstWidth, m_dstHeight, av_get_pix_fmt_name(m_dstFormat),
+            GetPixelRate() / 1000000.0);
+}
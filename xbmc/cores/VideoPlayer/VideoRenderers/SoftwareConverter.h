@@ -0,0 +1,88 @@
+/*
+ *  Copyright (C) 2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+extern "C" {
+#include <libavutil/pixfmt.h>
+#include <libswscale/swscale.h>
+}
+
+/*!
+ * @brief CPU pixel format conversion and scaling for software render paths.
+ *
+ * Wraps swscale, which selects SSE/AVX/NEON code paths at runtime. If the
+ * picture is not scaled, it is split into horizontal bands that are converted
+ * in parallel, each with its own swscale context, on a small set of worker
+ * threads owned by the converter.
+ */
+class CSoftwareConverter
+{
+public:
+  CSoftwareConverter();
+  ~CSoftwareConverter();
+
+  /*!
+   * @brief Set up the conversion, cheap if nothing changed since the last call.
+   * @param colorSpace color space of the source, the destination is always BT.709
+   * @param fullRange true if source and destination use full range
+   */
+  bool Configure(int srcWidth, int srcHeight, AVPixelFormat srcFormat,
+                 int dstWidth, int dstHeight, AVPixelFormat dstFormat,
+                 AVColorSpace colorSpace, bool fullRange);
+
+  /*!
+   * @brief Convert a picture with the configured parameters. Blocks until all
+   * bands are done.
+   */
+  bool Convert(uint8_t* const src[], const int srcStride[], uint8_t* const dst[], const int dstStride[]);
+
+  /*!
+   * @brief Average throughput in destination pixels per second since Configure()
+   */
+  double GetPixelRate() const;
+
+private:
+  class CWorker;
+
+  struct Band
+  {
+    SwsContext* context = nullptr;
+    int y = 0;
+    int height = 0;
+  };
+
+  void Reset();
+  void ConvertBand(const Band& band);
+  void LogStatistics();
+
+  int m_srcWidth = 0;
+  int m_srcHeight = 0;
+  AVPixelFormat m_srcFormat = AV_PIX_FMT_NONE;
+  int m_dstWidth = 0;
+  int m_dstHeight = 0;
+  AVPixelFormat m_dstFormat = AV_PIX_FMT_NONE;
+  AVColorSpace m_colorSpace = AVCOL_SPC_UNSPECIFIED;
+  bool m_fullRange = false;
+
+  std::vector<Band> m_bands;
+  std::vector<std::unique_ptr<CWorker>> m_workers;
+
+  // picture of the conversion in progress, only valid during Convert()
+  uint8_t* const* m_src = nullptr;
+  const int* m_srcStride = nullptr;
+  uint8_t* const* m_dst = nullptr;
+  const int* m_dstStride = nullptr;
+
+  uint64_t m_pixels = 0;
+  int64_t m_ticks = 0;
+  unsigned int m_frames = 0;
+};
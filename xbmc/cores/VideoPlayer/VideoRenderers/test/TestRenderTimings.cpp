@@ -0,0 +1,108 @@
+/*
+ *  Copyright (C) 2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/VideoRenderers/BaseRenderer.h"
+#include "cores/VideoPlayer/VideoRenderers/RenderTimings.h"
+#include "utils/TimeUtils.h"
+
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+// timings on a clock set by the test
+class CTestRenderTimings : public CRenderTimings
+{
+public:
+  explicit CTestRenderTimings(size_t capacity) : CRenderTimings(capacity) {}
+
+  // run a frame through the render manager, times in ms
+  void Render(int index, double pts, int64_t decoded, int64_t queued, int64_t rendered)
+  {
+    m_now = queued * 1000;
+    FrameQueued(index, pts, decoded * CurrentHostFrequency() / 1000);
+    FramePresented(index);
+    m_now = rendered * 1000;
+    FrameRendered(index);
+  }
+
+  int64_t m_now = 0;
+
+protected:
+  int64_t GetTimeUs() const override { return m_now; }
+};
+} // unnamed namespace
+
+TEST(TestRenderTimings, RingKeepsNewestFrames)
+{
+  CTestRenderTimings timings(4);
+  for (int i = 0; i < 6; ++i)
+    timings.Render(i % NUM_BUFFERS, i, 0, i * 40, i * 40 + 10);
+
+  const std::vector<CRenderTimings::SFrameTiming> frames = timings.GetFrames();
+  ASSERT_EQ(4u, frames.size());
+  for (size_t i = 0; i < frames.size(); ++i)
+  {
+    EXPECT_EQ(i + 2, frames[i].pts);
+    EXPECT_EQ(static_cast<int64_t>(i + 2) * 40000, frames[i].queued);
+    EXPECT_EQ(frames[i].queued, frames[i].presented);
+    EXPECT_EQ(frames[i].queued + 10000, frames[i].rendered);
+  }
+
+  timings.Reset();
+  EXPECT_TRUE(timings.GetFrames().empty());
+}
+
+TEST(TestRenderTimings, Statistics)
+{
+  CTestRenderTimings timings(16);
+  // rendered at 10, 50, 90, 150, 170 ms: intervals of 40, 40, 60 and 20 ms
+  timings.Render(0, 0, 0, 0, 10);
+  timings.Render(1, 1, 30, 35, 50);
+  timings.Render(2, 2, 60, 70, 90);
+  timings.Render(3, 3, 100, 130, 150);
+  timings.Render(4, 4, 150, 160, 170);
+
+  // skipped frames only count as frames
+  timings.m_now = 180000;
+  timings.FrameQueued(5, 5, 0);
+  timings.FrameSkipped(5);
+
+  const CRenderTimings::SStatistics stats = timings.GetStatistics();
+  EXPECT_EQ(6u, stats.frames);
+  EXPECT_EQ(1u, stats.skipped);
+  // 10, 15, 20, 20 and 10 ms from queued to rendered
+  EXPECT_NEAR(15.0, stats.latency, 0.001);
+  // 5, 10, 30 and 10 ms from decoded to queued, the first frame has no decode time
+  EXPECT_NEAR(13.75, stats.wait, 0.01);
+  EXPECT_NEAR(40.0, stats.interval, 0.001);
+  EXPECT_NEAR(std::sqrt(200.0), stats.jitter, 0.001);
+}
+
+TEST(TestRenderTimings, IgnoresFramesNotQueued)
+{
+  CTestRenderTimings timings(16);
+  timings.FrameRendered(0);
+  timings.FrameSkipped(1);
+  timings.FramePresented(-1);
+  timings.FrameQueued(NUM_BUFFERS, 0, 0);
+  timings.FrameRendered(NUM_BUFFERS);
+  EXPECT_TRUE(timings.GetFrames().empty());
+
+  // a frame is finished only once
+  timings.Render(0, 0, 0, 0, 10);
+  timings.FrameRendered(0);
+  EXPECT_EQ(1u, timings.GetFrames().size());
+
+  const CRenderTimings::SStatistics stats = timings.GetStatistics();
+  EXPECT_EQ(1u, stats.frames);
+  EXPECT_EQ(0.0, stats.interval);
+  EXPECT_EQ(0.0, stats.jitter);
+}
@@ -0,0 +1,179 @@
+/*
+ *  Copyright (C) 2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ServiceBroker.h"
+#include "cores/VideoPlayer/VideoRenderers/SoftwareConverter.h"
+#include "utils/CPUInfo.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <stdio.h>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+// a YUV420P picture with gradients and a pattern, so every band differs
+struct Picture
+{
+  Picture(int width, int height) : width(width), height(height)
+  {
+    const int chromaWidth = (width + 1) / 2;
+    const int chromaHeight = (height + 1) / 2;
+    data[0].resize(width * height);
+    data[1].resize(chromaWidth * chromaHeight);
+    data[2].resize(chromaWidth * chromaHeight);
+
+    for (int y = 0; y < height; ++y)
+      for (int x = 0; x < width; ++x)
+        data[0][y * width + x] = static_cast<uint8_t>(16 + (x + y * 3) % 220 + ((x / 8 + y / 8) % 2) * 10);
+
+    for (int y = 0; y < chromaHeight; ++y)
+      for (int x = 0; x < chromaWidth; ++x)
+      {
+        data[1][y * chromaWidth + x] = static_cast<uint8_t>(16 + (x * 7) % 224);
+        data[2][y * chromaWidth + x] = static_cast<uint8_t>(16 + (y * 5) % 224);
+      }
+
+    for (int plane = 0; plane < 3; ++plane)
+    {
+      planes[plane] = data[plane].data();
+      strides[plane] = plane == 0 ? width : chromaWidth;
+    }
+  }
+
+  int width;
+  int height;
+  std::vector<uint8_t> data[3];
+  uint8_t* planes[4] = {};
+  int strides[4] = {};
+};
+
+// the whole picture converted with a single swscale context
+std::vector<uint8_t> ConvertSingle(const Picture& src, int dstWidth, int dstHeight)
+{
+  std::vector<uint8_t> dst(dstWidth * dstHeight * 4);
+  SwsContext* context =
+      sws_getContext(src.width, src.height, AV_PIX_FMT_YUV420P, dstWidth, dstHeight,
+                     AV_PIX_FMT_BGRA, SWS_FAST_BILINEAR, nullptr, nullptr, nullptr);
+  if (!context)
+    return {};
+
+  sws_setColorspaceDetails(context, sws_getCoefficients(AVCOL_SPC_BT709), 0,
+                           sws_getCoefficients(AVCOL_SPC_BT709), 0, 0, 1 << 16, 1 << 16);
+
+  uint8_t* dstPlanes[4] = {dst.data()};
+  int dstStrides[4] = {dstWidth * 4};
+  sws_scale(context, src.planes, src.strides, 0, src.height, dstPlanes, dstStrides);
+  sws_freeContext(context);
+  return dst;
+}
+
+std::vector<uint8_t> Convert(CSoftwareConverter& converter, const Picture& src, int dstWidth, int dstHeight)
+{
+  std::vector<uint8_t> dst(dstWidth * dstHeight * 4);
+  if (!converter.Configure(src.width, src.height, AV_PIX_FMT_YUV420P, dstWidth, dstHeight,
+                           AV_PIX_FMT_BGRA, AVCOL_SPC_BT709, false))
+    return {};
+
+  uint8_t* dstPlanes[4] = {dst.data()};
+  int dstStrides[4] = {dstWidth * 4};
+  if (!converter.Convert(src.planes, src.strides, dstPlanes, dstStrides))
+    return {};
+  return dst;
+}
+
+int MaxDifference(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b)
+{
+  int difference = 0;
+  for (size_t i = 0; i < std::min(a.size(), b.size()); ++i)
+    difference = std::max(difference, std::abs(a[i] - b[i]));
+  return difference;
+}
+
+class TestSoftwareConverter : public ::testing::Test
+{
+protected:
+  TestSoftwareConverter() { CServiceBroker::RegisterCPUInfo(CCPUInfo::GetCPUInfo()); }
+
+  ~TestSoftwareConverter() override { CServiceBroker::UnregisterCPUInfo(); }
+};
+} // unnamed namespace
+
+// unscaled pictures are split into bands on multi core machines
+TEST_F(TestSoftwareConverter, BandsMatchSingleContext)
+{
+  for (const auto& size : {std::make_pair(1920, 1080), std::make_pair(1280, 720),
+                           std::make_pair(720, 576), std::make_pair(642, 362)})
+  {
+    const Picture src(size.first, size.second);
+    CSoftwareConverter converter;
+
+    const std::vector<uint8_t> banded = Convert(converter, src, src.width, src.height);
+    const std::vector<uint8_t> single = ConvertSingle(src, src.width, src.height);
+    ASSERT_EQ(single.size(), banded.size()) << src.width << "x" << src.height;
+    EXPECT_EQ(0, MaxDifference(single, banded)) << src.width << "x" << src.height;
+  }
+}
+
+TEST_F(TestSoftwareConverter, ScaledMatchesSingleContext)
+{
+  const Picture src(1920, 1080);
+  CSoftwareConverter converter;
+
+  const std::vector<uint8_t> scaled = Convert(converter, src, 640, 360);
+  const std::vector<uint8_t> single = ConvertSingle(src, 640, 360);
+  ASSERT_EQ(single.size(), scaled.size());
+  EXPECT_EQ(0, MaxDifference(single, scaled));
+}
+
+TEST_F(TestSoftwareConverter, Reconfigure)
+{
+  const Picture large(1280, 720);
+  const Picture small(320, 240);
+  CSoftwareConverter converter;
+
+  EXPECT_FALSE(Convert(converter, large, large.width, large.height).empty());
+  EXPECT_EQ(0, MaxDifference(ConvertSingle(small, small.width, small.height),
+                             Convert(converter, small, small.width, small.height)));
+  EXPECT_GT(converter.GetPixelRate(), 0.0);
+}
+
+// Throughput of 1080p YUV420P to BGRA, band threaded against a single swscale context.
+// Run with --gtest_also_run_disabled_tests.
+TEST_F(TestSoftwareConverter, DISABLED_PixelRateBenchmark)
+{
+  constexpr int FRAMES = 200;
+  const Picture src(1920, 1080);
+  std::vector<uint8_t> dst(src.width * src.height * 4);
+  uint8_t* dstPlanes[4] = {dst.data()};
+  int dstStrides[4] = {src.width * 4};
+
+  SwsContext* context =
+      sws_getContext(src.width, src.height, AV_PIX_FMT_YUV420P, src.width, src.height,
+                     AV_PIX_FMT_BGRA, SWS_FAST_BILINEAR, nullptr, nullptr, nullptr);
+  ASSERT_NE(nullptr, context);
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < FRAMES; ++i)
+    sws_scale(context, src.planes, src.strides, 0, src.height, dstPlanes, dstStrides);
+  const double seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  sws_freeContext(context);
+
+  CSoftwareConverter converter;
+  ASSERT_TRUE(converter.Configure(src.width, src.height, AV_PIX_FMT_YUV420P, src.width,
+                                  src.height, AV_PIX_FMT_BGRA, AVCOL_SPC_BT709, false));
+  for (int i = 0; i < FRAMES; ++i)
+    ASSERT_TRUE(converter.Convert(src.planes, src.strides, dstPlanes, dstStrides));
+
+  printf("single context: %.1f Mpixel/s, bands on %d cpus: %.1f Mpixel/s\n",
+         static_cast<double>(src.width) * src.height * FRAMES / seconds / 1000000.0,
+         CServiceBroker::GetCPUInfo()->GetCPUCount(), converter.GetPixelRate() / 1000000.0);
+}
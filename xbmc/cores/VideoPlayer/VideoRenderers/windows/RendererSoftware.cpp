@@ -39,15 +39,6 @@ void CRendererSoftware::GetWeight(std::map<RenderMethod, int>& weights, const Vi
     weights[RENDER_SW] = weight;
 }
 
-CRendererSoftware::~CRendererSoftware()
-{
-  if (m_sw_scale_ctx)
-  {
-    sws_freeContext(m_sw_scale_ctx);
-    m_sw_scale_ctx = nullptr;
-  }
-}
-
 bool CRendererSoftware::Configure(const VideoPicture& picture, float fps, unsigned orientation)
 {
   if (__super::Configure(picture, fps, orientation))
@@ -79,19 +70,12 @@ void CRendererSoftware::RenderImpl(CD3DTexture& target, CRect& sourceRect, CPoin
   CRenderBuffer* buf = m_renderBuffers[m_iBufferIndex];
 
   // 1. convert yuv to rgb
-  m_sw_scale_ctx = sws_getCachedContext(m_sw_scale_ctx,
-    buf->GetWidth(), buf->GetHeight(), buf->av_format,
-    buf->GetWidth(), buf->GetHeight(), AV_PIX_FMT_BGRA,
-    SWS_FAST_BILINEAR, nullptr, nullptr, nullptr);
-
-  if (!m_sw_scale_ctx)
+  const int height = std::min(target.GetHeight(), buf->GetHeight());
+  if (!m_converter.Configure(buf->GetWidth(), height, buf->av_format,
+                             buf->GetWidth(), height, AV_PIX_FMT_BGRA,
+                             buf->color_space, buf->full_range))
     return;
 
-  sws_setColorspaceDetails(m_sw_scale_ctx,
-    sws_getCoefficients(buf->color_space), buf->full_range,
-    sws_getCoefficients(AVCOL_SPC_BT709),  buf->full_range,
-    0, 1 << 16, 1 << 16);
-
   uint8_t* src[YuvImage::MAX_PLANES];
   int srcStride[YuvImage::MAX_PLANES];
   buf->GetDataPlanes(src, srcStride);
@@ -102,7 +86,7 @@ void CRendererSoftware::RenderImpl(CD3DTexture& target, CRect& sourceRect, CPoin
     uint8_t *dst[] = { static_cast<uint8_t*>(mapping.pData), nullptr, nullptr };
     int dstStride[] = { static_cast<int>(mapping.RowPitch), 0, 0 };
 
-    sws_scale(m_sw_scale_ctx, src, srcStride, 0, std::min(target.GetHeight(), buf->GetHeight()), dst, dstStride);
+    m_converter.Convert(src, srcStride, dst, dstStride);
 
     if (!target.UnlockRect(0))
       CLog::LogF(LOGERROR, "failed to unlock swtarget texture.");
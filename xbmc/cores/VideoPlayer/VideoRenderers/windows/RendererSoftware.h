@@ -8,6 +8,7 @@
 #pragma once
 
 #include "RendererBase.h"
+#include "cores/VideoPlayer/VideoRenderers/SoftwareConverter.h"
 
 #include <map>
 extern "C" {
@@ -19,8 +20,6 @@ class CRendererSoftware : public CRendererBase
 {
   class CRenderBufferImpl;
 public:
-  ~CRendererSoftware();
-
   bool Configure(const VideoPicture& picture, float fps, unsigned orientation) override;
   bool Supports(ESCALINGMETHOD method) override;
 
@@ -34,7 +33,7 @@ protected:
   void FinalOutput(CD3DTexture& source, CD3DTexture& target, const CRect& src, const CPoint(&destPoints)[4]) override;
 
 private:
-  SwsContext* m_sw_scale_ctx = nullptr;
+  CSoftwareConverter m_converter;
 };
 
 class CRendererSoftware::CRenderBufferImpl : public CRenderBuffer
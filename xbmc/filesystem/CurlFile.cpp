@@ -457,6 +457,7 @@ void CCurlFile::SetCommonOptions(CReadState* state, bool failOnError /* = true *
   CURL_HANDLE* h = state->m_easyHandle;
 
   g_curlInterface.easy_reset(h);
+  g_curlInterface.easy_share(h);
 
   g_curlInterface.easy_setopt(h, CURLOPT_DEBUGFUNCTION, debug_callback);
 
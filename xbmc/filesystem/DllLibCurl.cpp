@@ -14,6 +14,17 @@
 
 #include <assert.h>
 
+namespace
+{
+// Sessions to the same host at a time, like the per-host connection limit of browsers. Every
+// session has a connection of its own, so this limits the connections to a host, too. It leaves
+// room for the maximum of parallel connections the file cache may use.
+constexpr unsigned int MAX_HOST_SESSIONS = 8;
+// How long a new session waits for a free slot. The limit is given up after that, so a thread
+// holding sessions to a host never waits for itself.
+constexpr unsigned int HOST_SESSION_WAIT_MS = 3000;
+}
+
 namespace XCURL
 {
 CURLcode DllLibCurl::global_init(long flags)
@@ -97,6 +108,16 @@ CURLMcode DllLibCurl::multi_cleanup(CURLM* handle)
   return curl_multi_cleanup(handle);
 }
 
+CURLSH* DllLibCurl::share_init()
+{
+  return curl_share_init();
+}
+
+CURLSHcode DllLibCurl::share_cleanup(CURLSH* share)
+{
+  return curl_share_cleanup(share);
+}
+
 curl_slist* DllLibCurl::slist_append(curl_slist* list, const char* to_append)
 {
   return curl_slist_append(list, to_append);
@@ -130,10 +151,25 @@ DllLibCurlGlobal::DllLibCurlGlobal()
   {
     CLog::Log(LOGERROR, "Error initializing libcurl");
   }
+
+  /* share dns lookups and tls sessions between all handles, so that new sessions
+   * to a known host can skip the name lookup and do an abbreviated tls handshake */
+  m_share = share_init();
+  if (m_share)
+  {
+    share_setopt(m_share, CURLSHOPT_LOCKFUNC, share_lock);
+    share_setopt(m_share, CURLSHOPT_UNLOCKFUNC, share_unlock);
+    share_setopt(m_share, CURLSHOPT_USERDATA, this);
+    share_setopt(m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    share_setopt(m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+  }
 }
 
 DllLibCurlGlobal::~DllLibCurlGlobal()
 {
+  if (m_share)
+    share_cleanup(m_share);
+
   // close libcurl
   curl_global_cleanup();
 }
@@ -167,6 +203,60 @@ void DllLibCurlGlobal::CheckIdle()
   }
 }
 
+void DllLibCurlGlobal::share_lock(CURL_HANDLE* handle,
+                                  curl_lock_data data,
+                                  curl_lock_access access,
+                                  void* userptr)
+{
+  DllLibCurlGlobal* global = static_cast<DllLibCurlGlobal*>(userptr);
+  global->m_shareLocks[data].lock();
+}
+
+void DllLibCurlGlobal::share_unlock(CURL_HANDLE* handle, curl_lock_data data, void* userptr)
+{
+  DllLibCurlGlobal* global = static_cast<DllLibCurlGlobal*>(userptr);
+  global->m_shareLocks[data].unlock();
+}
+
+void DllLibCurlGlobal::easy_share(CURL_HANDLE* easy_handle)
+{
+  if (m_share)
+    easy_setopt(easy_handle, CURLOPT_SHARE, m_share);
+}
+
+DllLibCurlGlobal::SConnectionStats DllLibCurlGlobal::GetConnectionStats()
+{
+  CSingleLock lock(m_critSection);
+  return m_connectionStats;
+}
+
+void DllLibCurlGlobal::UpdateConnectionStats(CURL_HANDLE* easy_handle)
+{
+  long response = 0;
+  if (easy_getinfo(easy_handle, CURLINFO_RESPONSE_CODE, &response) != CURLE_OK || response == 0)
+    return; // no transfer was done with this handle
+
+  long connects = 0;
+  if (easy_getinfo(easy_handle, CURLINFO_NUM_CONNECTS, &connects) != CURLE_OK)
+    return;
+
+  if (connects > 0)
+    m_connectionStats.m_new++;
+  else
+    m_connectionStats.m_reused++;
+}
+
+unsigned int DllLibCurlGlobal::GetBusySessions(const char* protocol, const char* hostname) const
+{
+  unsigned int sessions = 0;
+  for (const auto& it : m_sessions)
+  {
+    if (it.m_busy && it.m_protocol.compare(protocol) == 0 && it.m_hostname.compare(hostname) == 0)
+      sessions++;
+  }
+  return sessions;
+}
+
 void DllLibCurlGlobal::easy_acquire(const char* protocol,
                                     const char* hostname,
                                     CURL_HANDLE** easy_handle,
@@ -176,6 +266,22 @@ void DllLibCurlGlobal::easy_acquire(const char* protocol,
 
   CSingleLock lock(m_critSection);
 
+  if (GetBusySessions(protocol, hostname) >= MAX_HOST_SESSIONS)
+  {
+    m_connectionStats.m_limited++;
+    XbmcThreads::EndTime timeout(HOST_SESSION_WAIT_MS);
+    while (GetBusySessions(protocol, hostname) >= MAX_HOST_SESSIONS)
+    {
+      if (timeout.IsTimePast())
+      {
+        CLog::Log(LOGDEBUG, "{} - Exceeding {} sessions to {}://{}", __FUNCTION__,
+                  MAX_HOST_SESSIONS, protocol, hostname);
+        break;
+      }
+      m_sessionReleased.wait(lock, timeout.MillisLeft());
+    }
+  }
+
   for (auto& it : m_sessions)
   {
     if (!it.m_busy)
@@ -251,11 +357,14 @@ void DllLibCurlGlobal::easy_release(CURL_HANDLE** easy_handle, CURLM** multi_han
   {
     if (it.m_easy == easy && (multi == nullptr || it.m_multi == multi))
     {
+      UpdateConnectionStats(easy);
+
       /* reset session so next caller doesn't reuse options, only connections */
       /* will reset verbose too so it won't print that it closed connections on cleanup*/
       easy_reset(easy);
       it.m_busy = false;
       it.m_idletimestamp = XbmcThreads::SystemClockMillis();
+      m_sessionReleased.notifyAll();
       return;
     }
   }
@@ -8,8 +8,10 @@
 
 #pragma once
 
+#include "threads/Condition.h"
 #include "threads/CriticalSection.h"
 
+#include <stdint.h>
 #include <stdio.h>
 #include <string>
 #include <sys/time.h>
@@ -57,6 +59,13 @@ public:
   CURLMcode multi_timeout(CURLM* multi_handle, long* timeout);
   CURLMsg* multi_info_read(CURLM* multi_handle, int* msgs_in_queue);
   CURLMcode multi_cleanup(CURLM* handle);
+  CURLSH* share_init();
+  template<typename... Args>
+  CURLSHcode share_setopt(CURLSH* share, CURLSHoption option, Args... args)
+  {
+    return curl_share_setopt(share, option, std::forward<Args>(args)...);
+  }
+  CURLSHcode share_cleanup(CURLSH* share);
   curl_slist* slist_append(curl_slist* list, const char* to_append);
   void slist_free_all(curl_slist* list);
   const char* easy_strerror(CURLcode code);
@@ -77,6 +86,23 @@ public:
   CURL_HANDLE* easy_duphandle(CURL_HANDLE* easy_handle) override;
   void CheckIdle();
 
+  /*!
+   \brief Attach the process-wide share object to an easy handle so that it uses the common
+   DNS and TLS session caches
+   \param easy_handle the handle to attach
+   */
+  void easy_share(CURL_HANDLE* easy_handle);
+
+  /* statistics on the connections used by finished transfers */
+  struct SConnectionStats
+  {
+    uint64_t m_new = 0; // transfers which had to open a new connection
+    uint64_t m_reused = 0; // transfers which reused a cached connection
+    uint64_t m_limited = 0; // sessions which had to wait for a free slot to their host
+  };
+
+  SConnectionStats GetConnectionStats();
+
   /* overloaded load and unload with reference counter */
 
   /* structure holding a session info */
@@ -94,6 +120,21 @@ public:
 
   VEC_CURLSESSIONS m_sessions;
   CCriticalSection m_critSection;
+
+private:
+  static void share_lock(CURL_HANDLE* handle,
+                         curl_lock_data data,
+                         curl_lock_access access,
+                         void* userptr);
+  static void share_unlock(CURL_HANDLE* handle, curl_lock_data data, void* userptr);
+
+  void UpdateConnectionStats(CURL_HANDLE* easy_handle);
+  unsigned int GetBusySessions(const char* protocol, const char* hostname) const;
+
+  CURLSH* m_share = nullptr;
+  XbmcThreads::ConditionVariable m_sessionReleased;
+  CCriticalSection m_shareLocks[CURL_LOCK_DATA_LAST];
+  SConnectionStats m_connectionStats;
 };
 } // namespace XCURL
 
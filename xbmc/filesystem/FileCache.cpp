@@ -33,6 +33,14 @@
 
 using namespace XFILE;
 
+namespace
+{
+// Upper bound for the adaptive source read size, as a multiple of the base chunk size
+constexpr unsigned MAX_CHUNK_MULTIPLIER = 16;
+// The adaptive read size targets reads of roughly this many milliseconds of source data
+constexpr unsigned READ_SIZE_TARGET_MS = 100;
+} // namespace
+
 class CWriteRate
 {
 public:
@@ -87,6 +95,8 @@ CFileCache::CFileCache(const unsigned int flags)
   , m_readPos(0)
   , m_writePos(0)
   , m_chunkSize(0)
+  , m_maxChunkSize(0)
+  , m_readSize(0)
   , m_writeRate(0)
   , m_writeRateActual(0)
   , m_forwardCacheSize(0)
@@ -94,6 +104,8 @@ CFileCache::CFileCache(const unsigned int flags)
   , m_bFilling(false)
   , m_bLowSpeedDetected(false)
   , m_fileSize(0)
+  , m_seekHits(0)
+  , m_seekMisses(0)
   , m_flags(flags)
 {
 }
@@ -184,6 +196,31 @@ bool CFileCache::Open(const CURL& url)
     }
   }
 
+  // Optionally fill the cache over several connections to remote http sources. The reader takes
+  // over m_source, its length and seekability were determined above and are not queried again.
+  m_parallelReader.reset();
+  const unsigned int connections =
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_cacheParallelConnections;
+  if (connections > 1 && m_seekPossible > 0 && m_fileSize > 0 &&
+      (url.IsProtocol("http") || url.IsProtocol("https")))
+  {
+    m_parallelReader = std::unique_ptr<CParallelRangeReader>(new CParallelRangeReader()); // C++14 - Replace with std::make_unique
+    if (m_parallelReader->Open(url, connections, &m_source))
+      CLog::Log(LOGDEBUG, "CFileCache::Open - using %u parallel connections", connections);
+    else
+      m_parallelReader.reset();
+  }
+
+  // Fast sources are read in larger blocks (multiples of the chunk size) to keep the
+  // per-request overhead low, but never more than a quarter of the forward cache
+  m_maxChunkSize = m_chunkSize * MAX_CHUNK_MULTIPLIER;
+  if (m_forwardCacheSize > 0)
+  {
+    const int64_t maxChunks = std::max<int64_t>(1, m_forwardCacheSize / 4 / m_chunkSize);
+    m_maxChunkSize = static_cast<unsigned>(
+        m_chunkSize * std::min<int64_t>(maxChunks, MAX_CHUNK_MULTIPLIER));
+  }
+
   // open cache strategy
   if (!m_pCache || m_pCache->Open() != CACHE_RC_OK)
   {
@@ -196,6 +233,9 @@ bool CFileCache::Open(const CURL& url)
   m_writePos = 0;
   m_writeRate = 1024 * 1024;
   m_writeRateActual = 0;
+  m_readSize = m_chunkSize;
+  m_seekHits = 0;
+  m_seekMisses = 0;
   m_forward = 0;
   m_bFilling = true;
   m_bLowSpeedDetected = false;
@@ -216,7 +256,7 @@ void CFileCache::Process()
   }
 
   // create our read buffer
-  std::unique_ptr<char[]> buffer(new char[m_chunkSize]);
+  std::unique_ptr<char[]> buffer(new char[m_maxChunkSize]);
   if (buffer == nullptr)
   {
     CLog::Log(LOGERROR, "%s - failed to allocate read buffer", __FUNCTION__);
@@ -229,8 +269,9 @@ void CFileCache::Process()
 
   while (!m_bStop)
   {
-    // Update filesize
-    m_fileSize = m_source.GetLength();
+    // Update filesize, the parallel reader owns m_source and is only used for sources of known size
+    if (!m_parallelReader)
+      m_fileSize = m_source.GetLength();
 
     // check for seek events
     if (m_seekEvent.WaitMSec(0))
@@ -241,12 +282,14 @@ void CFileCache::Process()
       bool sourceSeekFailed = false;
       if (!cacheReachEOF)
       {
-        m_nSeekResult = m_source.Seek(cacheMaxPos, SEEK_SET);
+        // the parallel reader reads at explicit positions, there's nothing to seek
+        m_nSeekResult = m_parallelReader ? cacheMaxPos : m_source.Seek(cacheMaxPos, SEEK_SET);
         if (m_nSeekResult != cacheMaxPos)
         {
           CLog::Log(LOGERROR, "CFileCache::Process - Error %d seeking. Seek returned %" PRId64,
                     static_cast<int>(GetLastError()), m_nSeekResult);
-          m_seekPossible = m_source.IoControl(IOCTRL_SEEK_POSSIBLE, NULL);
+          if (!m_parallelReader)
+            m_seekPossible = m_source.IoControl(IOCTRL_SEEK_POSSIBLE, NULL);
           sourceSeekFailed = true;
         }
       }
@@ -265,6 +308,7 @@ void CFileCache::Process()
                     "CFileCache::Process - Cache completely reset for seek to position %" PRId64,
                     m_seekPos);
           m_forward = 0;
+          m_readSize = m_chunkSize;
           m_bFilling = true;
           m_bLowSpeedDetected = false;
         }
@@ -292,7 +336,7 @@ void CFileCache::Process()
       }
     }
 
-    size_t maxWrite = m_pCache->GetMaxWriteSize(m_chunkSize);
+    size_t maxWrite = m_pCache->GetMaxWriteSize(m_readSize);
 
     /* Only read from source if there's enough write space in the cache
      * else we may keep disposing data and seeking back on (slow) source
@@ -303,9 +347,17 @@ void CFileCache::Process()
       continue;
     }
 
+    // Never read more than fits in the cache, keeping the read a multiple of the chunk size
+    const size_t readSize = std::min<size_t>(m_readSize, maxWrite / m_chunkSize * m_chunkSize);
+
     ssize_t iRead = 0;
     if (!cacheReachEOF)
-      iRead = m_source.Read(buffer.get(), m_chunkSize);
+    {
+      if (m_parallelReader)
+        iRead = m_parallelReader->Read(m_writePos, buffer.get(), readSize);
+      else
+        iRead = m_source.Read(buffer.get(), readSize);
+    }
     if (iRead == 0)
     {
       // Check for actual EOF and retry as long as we still have data in our cache
@@ -391,6 +443,12 @@ void CFileCache::Process()
     // avoid uncertainty at start of caching
     m_writeRateActual = average.Rate(m_writePos, 1000);
 
+    // Adapt the read size to the measured source throughput
+    const uint64_t targetSize = static_cast<uint64_t>(m_writeRateActual) * READ_SIZE_TARGET_MS / 1000;
+    const unsigned chunks = static_cast<unsigned>(
+        std::min<uint64_t>(targetSize / m_chunkSize, m_maxChunkSize / m_chunkSize));
+    m_readSize = std::max(1u, chunks) * m_chunkSize;
+
     // Update forward cache size
     m_forward = m_pCache->WaitForData(0, 0);
 
@@ -505,6 +563,8 @@ int64_t CFileCache::Seek(int64_t iFilePosition, int iWhence)
 
   if ((m_nSeekResult = m_pCache->Seek(iTarget)) != iTarget)
   {
+    m_seekMisses++;
+
     if (m_seekPossible == 0)
       return m_nSeekResult;
 
@@ -533,7 +593,10 @@ int64_t CFileCache::Seek(int64_t iFilePosition, int iWhence)
     m_seekEvent.Reset();
   }
   else
+  {
+    m_seekHits++;
     m_readPos = iTarget;
+  }
 
   return iTarget;
 }
@@ -544,8 +607,15 @@ void CFileCache::Close()
 
   CSingleLock lock(m_sync);
   if (m_pCache)
+  {
+    if (m_seekHits + m_seekMisses > 0)
+      CLog::Log(LOGDEBUG, "CFileCache::Close - %" PRIu64 " of %" PRIu64 " seeks served from cache",
+                static_cast<uint64_t>(m_seekHits), static_cast<uint64_t>(m_seekHits + m_seekMisses));
     m_pCache->Close();
+  }
 
+  // the parallel reader streams from m_source, stop it first
+  m_parallelReader.reset();
   m_source.Close();
 }
 
@@ -564,6 +634,9 @@ void CFileCache::StopThread(bool bWait /*= true*/)
   m_bStop = true;
   //Process could be waiting for seekEvent
   m_seekEvent.Set();
+  //or for the parallel reader
+  if (m_parallelReader)
+    m_parallelReader->Abort();
   CThread::StopThread(bWait);
 }
 
@@ -584,6 +657,9 @@ int CFileCache::IoControl(EIoControl request, void* param)
     status->maxrate = m_writeRate;
     status->currate = m_writeRateActual;
     status->lowspeed = m_bLowSpeedDetected;
+    status->readsize = m_readSize;
+    status->seekhits = m_seekHits;
+    status->seekmisses = m_seekMisses;
     m_bLowSpeedDetected = false; // Reset flag
     return 0;
   }
@@ -11,6 +11,7 @@
 #include "CacheStrategy.h"
 #include "File.h"
 #include "IFile.h"
+#include "ParallelRangeReader.h"
 #include "threads/CriticalSection.h"
 #include "threads/Thread.h"
 
@@ -58,6 +59,7 @@ namespace XFILE
     std::unique_ptr<CCacheStrategy> m_pCache;
     int m_seekPossible;
     CFile m_source;
+    std::unique_ptr<CParallelRangeReader> m_parallelReader;
     std::string m_sourcePath;
     CEvent m_seekEvent;
     CEvent m_seekEnded;
@@ -66,6 +68,8 @@ namespace XFILE
     int64_t m_readPos;
     int64_t m_writePos;
     unsigned m_chunkSize;
+    unsigned m_maxChunkSize;
+    unsigned m_readSize;
     unsigned m_writeRate;
     unsigned m_writeRateActual;
     int64_t m_forwardCacheSize;
@@ -73,6 +77,8 @@ namespace XFILE
     bool m_bFilling;
     bool m_bLowSpeedDetected;
     std::atomic<int64_t> m_fileSize;
+    std::atomic<uint64_t> m_seekHits;
+    std::atomic<uint64_t> m_seekMisses;
     unsigned int m_flags;
     CCriticalSection m_sync;
   };
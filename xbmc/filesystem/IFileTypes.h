@@ -52,6 +52,9 @@ struct SCacheStatus
   unsigned maxrate;  /**< maximum number of bytes per second cache is allowed to fill */
   unsigned currate;  /**< average read rate from source file since last position change */
   bool     lowspeed; /**< cache low speed condition detected? */
+  unsigned readsize = 0; /**< current size of the reads issued to the source file */
+  uint64_t seekhits = 0; /**< number of seeks served from cached data since open */
+  uint64_t seekmisses = 0; /**< number of seeks which required a source seek since open */
 };
 
 typedef enum {
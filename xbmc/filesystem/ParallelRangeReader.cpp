@@ -0,0 +1,305 @@
+/*
+ *  Copyright (C) 2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ParallelRangeReader.h"
+
+#include "File.h"
+#include "URL.h"
+#include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "threads/Thread.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <string.h>
+
+using namespace XFILE;
+
+namespace
+{
+// the connections hand their data over to the reader in blocks of this size
+constexpr size_t BLOCK_SIZE = 64 * 1024;
+} // unnamed namespace
+
+class CParallelRangeReader::CWorker : public CThread
+{
+public:
+  CWorker(CCriticalSection& critSection, CEvent& dataEvent, size_t stripeSize)
+    : CThread("ParallelRangeReader"),
+      m_buffer(stripeSize),
+      m_critSection(critSection),
+      m_dataEvent(dataEvent)
+  {
+  }
+
+  ~CWorker() override
+  {
+    StopThread();
+    if (m_ownedFile)
+      m_ownedFile->Close();
+  }
+
+  bool Open(const CURL& url, CFile* source)
+  {
+    if (source)
+    {
+      m_file = source;
+    }
+    else
+    {
+      m_ownedFile.reset(new CFile()); // C++14 - Replace with std::make_unique
+      if (!m_ownedFile->Open(url, READ_NO_CACHE | READ_TRUNCATED | READ_CHUNKED))
+        return false;
+
+      bool retry = false;
+      m_ownedFile->IoControl(IOCTRL_SET_RETRY, &retry);
+      m_file = m_ownedFile.get();
+    }
+
+    Create(false);
+    return true;
+  }
+
+  /*!
+   \brief Start fetching a stripe, dropping the current one. Called with the reader's lock held.
+   */
+  void Assign(int64_t stripe)
+  {
+    m_stripe = stripe;
+    m_filled = 0;
+    m_eof = false;
+    m_error = false;
+    ++m_generation;
+    m_request.Set();
+  }
+
+  void StopThread(bool bWait = true) override
+  {
+    m_bStop = true;
+    m_request.Set();
+    CThread::StopThread(bWait);
+  }
+
+  // guarded by the reader's lock
+  int64_t m_stripe = -1;
+  size_t m_filled = 0;
+  bool m_eof = false;
+  bool m_error = false;
+  std::vector<char> m_buffer;
+
+protected:
+  void Process() override
+  {
+    while (!m_bStop)
+    {
+      if (AbortableWait(m_request) != WAIT_SIGNALED || m_bStop)
+        break;
+
+      FetchStripe();
+    }
+  }
+
+private:
+  void FetchStripe()
+  {
+    int64_t stripe;
+    unsigned int generation;
+    {
+      CSingleLock lock(m_critSection);
+      stripe = m_stripe;
+      generation = m_generation;
+    }
+
+    if (stripe < 0)
+      return;
+
+    const int64_t start = stripe * static_cast<int64_t>(m_buffer.size());
+    const int64_t length = m_file->GetLength();
+    if (length > 0 && start >= length)
+    {
+      Update(generation, 0);
+      return;
+    }
+
+    // one seek per stripe, the rest of the stripe is streamed over the same request
+    if (m_file->GetPosition() != start && m_file->Seek(start, SEEK_SET) != start)
+    {
+      CLog::Log(LOGERROR, "CParallelRangeReader - failed to seek to position %" PRId64, start);
+      Update(generation, -1);
+      return;
+    }
+
+    size_t filled = 0;
+    while (filled < m_buffer.size() && !m_bStop)
+    {
+      // the reader only accesses the data below m_filled, so this is safe without the lock
+      const ssize_t read =
+          m_file->Read(m_buffer.data() + filled, std::min(BLOCK_SIZE, m_buffer.size() - filled));
+      if (!Update(generation, read))
+        break;
+      filled += read;
+    }
+  }
+
+  /*!
+   \brief Publish the result of a read to the reader.
+   \return true if the stripe was not reassigned meanwhile and there's more data to fetch
+   */
+  bool Update(unsigned int generation, ssize_t read)
+  {
+    CSingleLock lock(m_critSection);
+    if (generation != m_generation)
+      return false;
+
+    if (read < 0)
+      m_error = true;
+    else if (read == 0)
+      m_eof = true;
+    else
+      m_filled += read;
+
+    m_dataEvent.Set();
+    return read > 0;
+  }
+
+  CFile* m_file = nullptr;
+  std::unique_ptr<CFile> m_ownedFile;
+  CCriticalSection& m_critSection;
+  CEvent& m_dataEvent;
+  CEvent m_request;
+  unsigned int m_generation = 0;
+};
+
+CParallelRangeReader::CParallelRangeReader() = default;
+
+CParallelRangeReader::~CParallelRangeReader()
+{
+  Close();
+}
+
+bool CParallelRangeReader::Open(const CURL& url,
+                                unsigned int connections,
+                                CFile* source,
+                                size_t stripeSize)
+{
+  Close();
+
+  m_aborted = false;
+  m_stripeSize = std::max<size_t>(stripeSize, 1);
+  for (unsigned int i = 0; i < connections; ++i)
+  {
+    std::unique_ptr<CWorker> worker(new CWorker(m_critSection, m_dataEvent, m_stripeSize)); // C++14 - Replace with std::make_unique
+    if (!worker->Open(url, i == 0 ? source : nullptr))
+    {
+      CLog::Log(LOGERROR, "CParallelRangeReader::Open - failed to open connection %u to <%s>", i,
+                url.GetRedacted().c_str());
+      Close();
+      return false;
+    }
+    m_workers.push_back(std::move(worker));
+  }
+
+  return !m_workers.empty();
+}
+
+void CParallelRangeReader::Close()
+{
+  m_workers.clear();
+}
+
+void CParallelRangeReader::Abort()
+{
+  m_aborted = true;
+  m_dataEvent.Set();
+}
+
+void CParallelRangeReader::Restart(int64_t stripe)
+{
+  CLog::Log(LOGDEBUG, "CParallelRangeReader::Restart - fetching stripes from position %" PRId64,
+            stripe * static_cast<int64_t>(m_stripeSize));
+
+  m_nextStripe = stripe;
+  for (auto& worker : m_workers)
+    worker->Assign(m_nextStripe++);
+}
+
+ssize_t CParallelRangeReader::Read(int64_t position, void* buffer, size_t size)
+{
+  if (m_workers.empty() || position < 0 || m_aborted)
+    return -1;
+
+  if (size == 0)
+    return 0;
+
+  const int64_t stripe = position / static_cast<int64_t>(m_stripeSize);
+  const size_t offset = static_cast<size_t>(position % static_cast<int64_t>(m_stripeSize));
+
+  CSingleLock lock(m_critSection);
+
+  auto it = std::find_if(m_workers.begin(), m_workers.end(),
+                         [stripe](const std::unique_ptr<CWorker>& worker) {
+                           return worker->m_stripe == stripe;
+                         });
+  if (it == m_workers.end())
+  {
+    // first read or a seek, start over at the requested stripe
+    Restart(stripe);
+    it = m_workers.begin();
+  }
+
+  // connections holding stripes the reader has moved past continue with the next ones
+  for (auto& worker : m_workers)
+  {
+    if (worker->m_stripe < stripe)
+      worker->Assign(m_nextStripe++);
+  }
+
+  CWorker& worker = **it;
+  XbmcThreads::EndTime timeout(READ_TIMEOUT_MS);
+  while (true)
+  {
+    if (worker.m_filled > offset)
+    {
+      const size_t available = std::min(size, worker.m_filled - offset);
+      memcpy(buffer, worker.m_buffer.data() + offset, available);
+      return available;
+    }
+
+    if (worker.m_error)
+    {
+      // fetch the stripe again on the next read
+      worker.Assign(stripe);
+      return -1;
+    }
+
+    if (worker.m_eof)
+      return 0;
+
+    if (m_aborted)
+      return -1;
+
+    if (timeout.IsTimePast())
+    {
+      CLog::Log(LOGERROR,
+                "CParallelRangeReader::Read - no data at position %" PRId64 " within %u ms",
+                position, READ_TIMEOUT_MS);
+      // reconnect the stalled stripe on the next read
+      worker.Assign(stripe);
+      return -1;
+    }
+
+    lock.Leave();
+    m_dataEvent.WaitMSec(100);
+    lock.Enter();
+  }
+}
+
+unsigned int CParallelRangeReader::GetConnectionCount() const
+{
+  return m_workers.size();
+}
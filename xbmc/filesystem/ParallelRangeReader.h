@@ -0,0 +1,90 @@
+/*
+ *  Copyright (C) 2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+
+#include <atomic>
+#include <memory>
+#include <stdint.h>
+#include <vector>
+
+#include <sys/types.h>
+
+class CURL;
+
+namespace XFILE
+{
+class CFile;
+
+/*!
+ \brief Reads a seekable source over several connections at once.
+
+ The source is divided into stripes of a fixed size. Every connection streams one whole stripe
+ sequentially into its own buffer, while the other connections prefetch the following stripes.
+ Once the reader has moved past a stripe, its connection continues with the next stripe that is
+ not yet being fetched, so a connection only reconnects once per stripe and never has to discard
+ data it requested. This lifts the throughput limit of a single TCP stream for remote sources.
+ */
+class CParallelRangeReader
+{
+public:
+  static constexpr size_t DEFAULT_STRIPE_SIZE = 4 * 1024 * 1024;
+  static constexpr unsigned int READ_TIMEOUT_MS = 30000;
+
+  CParallelRangeReader();
+  ~CParallelRangeReader();
+
+  /*!
+   \brief Open the given number of connections to the source
+   \param url the source to read from, has to support seeking
+   \param connections number of parallel connections
+   \param source optional connection to the source that is already open, it is used as the first
+          connection and must not be used by the caller until the reader is closed
+   \param stripeSize number of bytes every connection fetches in one go
+   \return true if all connections could be opened, false otherwise
+   */
+  bool Open(const CURL& url,
+            unsigned int connections,
+            CFile* source = nullptr,
+            size_t stripeSize = DEFAULT_STRIPE_SIZE);
+  void Close();
+
+  /*!
+   \brief Make a pending and all further reads fail, so a thread blocked in Read can be stopped
+   */
+  void Abort();
+
+  /*!
+   \brief Read from the source, waiting for the data to arrive if it hasn't been fetched yet
+   \param position offset in the source to read from
+   \param buffer buffer receiving the data
+   \param size size of the buffer
+   \return number of bytes read, which may be less than size, 0 on end of file and -1 on error,
+           after an abort or if no data arrived within READ_TIMEOUT_MS
+   */
+  ssize_t Read(int64_t position, void* buffer, size_t size);
+
+  unsigned int GetConnectionCount() const;
+
+private:
+  class CWorker;
+
+  void Restart(int64_t stripe);
+
+  std::vector<std::unique_ptr<CWorker>> m_workers;
+  size_t m_stripeSize = DEFAULT_STRIPE_SIZE;
+  int64_t m_nextStripe = 0;
+  CCriticalSection m_critSection;
+  CEvent m_dataEvent;
+  std::atomic<bool> m_aborted{false};
+};
+
+} // namespace XFILE
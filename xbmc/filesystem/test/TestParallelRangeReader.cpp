@@ -0,0 +1,353 @@
+/*
+ *  Copyright (C) 2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "URL.h"
+#include "filesystem/File.h"
+#include "filesystem/ParallelRangeReader.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <stdio.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <gtest/gtest.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace XFILE;
+
+namespace
+{
+/*!
+ * Minimal local http server serving one file with range support. Every response is sent at a
+ * limited rate after a fixed delay, to resemble a remote server behind a slow link.
+ */
+class CThrottledHttpServer
+{
+public:
+  CThrottledHttpServer(const std::string& content, size_t bytesPerSecond, unsigned int latencyMs)
+    : m_content(content), m_bytesPerSecond(bytesPerSecond), m_latencyMs(latencyMs)
+  {
+  }
+
+  ~CThrottledHttpServer() { Stop(); }
+
+  bool Start()
+  {
+    m_socket = socket(AF_INET, SOCK_STREAM, 0);
+    if (m_socket < 0)
+      return false;
+
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(addr);
+    if (bind(m_socket, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        listen(m_socket, 16) != 0 ||
+        getsockname(m_socket, reinterpret_cast<sockaddr*>(&addr), &length) != 0)
+      return false;
+
+    m_port = ntohs(addr.sin_port);
+    m_acceptThread = std::thread(&CThrottledHttpServer::Accept, this);
+    return true;
+  }
+
+  void Stop()
+  {
+    if (m_socket < 0)
+      return;
+
+    m_stop = true;
+    shutdown(m_socket, SHUT_RDWR);
+    if (m_acceptThread.joinable())
+      m_acceptThread.join();
+    close(m_socket);
+    m_socket = -1;
+
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      for (int connection : m_connections)
+        shutdown(connection, SHUT_RDWR);
+    }
+    for (auto& thread : m_threads)
+      thread.join();
+    m_threads.clear();
+  }
+
+  std::string GetUrl() const { return "http://127.0.0.1:" + std::to_string(m_port) + "/file.bin"; }
+
+  unsigned int GetRequestCount() const { return m_requests; }
+
+private:
+  void Accept()
+  {
+    while (!m_stop)
+    {
+      const int connection = accept(m_socket, nullptr, nullptr);
+      if (connection < 0)
+        break;
+
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_connections.insert(connection);
+      m_threads.emplace_back(&CThrottledHttpServer::Serve, this, connection);
+    }
+  }
+
+  void Serve(int connection)
+  {
+    std::string request;
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == std::string::npos)
+    {
+      const ssize_t received = recv(connection, buffer, sizeof(buffer), 0);
+      if (received <= 0)
+        break;
+      request.append(buffer, received);
+    }
+
+    if (request.find("\r\n\r\n") != std::string::npos)
+      Respond(connection, request);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_connections.erase(connection);
+    close(connection);
+  }
+
+  void Respond(int connection, const std::string& request)
+  {
+    ++m_requests;
+    std::this_thread::sleep_for(std::chrono::milliseconds(m_latencyMs));
+
+    size_t first = 0;
+    size_t last = m_content.size() - 1;
+    const size_t range = request.find("Range: bytes=");
+    if (range != std::string::npos)
+    {
+      unsigned long long rangeFirst = 0;
+      unsigned long long rangeLast = 0;
+      const int fields =
+          sscanf(request.c_str() + range, "Range: bytes=%llu-%llu", &rangeFirst, &rangeLast);
+      if (fields >= 1)
+        first = static_cast<size_t>(rangeFirst);
+      if (fields == 2)
+        last = std::min(last, static_cast<size_t>(rangeLast));
+    }
+
+    std::string header;
+    if (first >= m_content.size())
+    {
+      header = "HTTP/1.1 416 Range Not Satisfiable\r\nContent-Range: bytes */" +
+               std::to_string(m_content.size()) + "\r\nContent-Length: 0\r\n";
+      first = 1;
+      last = 0;
+    }
+    else if (range != std::string::npos)
+    {
+      header = "HTTP/1.1 206 Partial Content\r\nContent-Range: bytes " + std::to_string(first) +
+               "-" + std::to_string(last) + "/" + std::to_string(m_content.size()) +
+               "\r\nContent-Length: " + std::to_string(last - first + 1) + "\r\n";
+    }
+    else
+    {
+      header = "HTTP/1.1 200 OK\r\nContent-Length: " + std::to_string(m_content.size()) + "\r\n";
+    }
+    header += "Accept-Ranges: bytes\r\nContent-Type: application/octet-stream\r\n"
+              "Connection: close\r\n\r\n";
+
+    if (!SendAll(connection, header.c_str(), header.size()) ||
+        request.compare(0, 5, "HEAD ") == 0)
+      return;
+
+    const auto start = std::chrono::steady_clock::now();
+    size_t sent = 0;
+    while (first + sent <= last && !m_stop)
+    {
+      const size_t block = std::min<size_t>(16 * 1024, last - first - sent + 1);
+      if (!SendAll(connection, m_content.data() + first + sent, block))
+        break;
+      sent += block;
+
+      if (m_bytesPerSecond > 0)
+        std::this_thread::sleep_until(
+            start + std::chrono::microseconds(static_cast<uint64_t>(sent) * 1000000 /
+                                              m_bytesPerSecond));
+    }
+  }
+
+  static bool SendAll(int connection, const char* data, size_t size)
+  {
+    while (size > 0)
+    {
+      const ssize_t sent = send(connection, data, size, MSG_NOSIGNAL);
+      if (sent <= 0)
+        return false;
+      data += sent;
+      size -= sent;
+    }
+    return true;
+  }
+
+  const std::string m_content;
+  const size_t m_bytesPerSecond;
+  const unsigned int m_latencyMs;
+  int m_socket = -1;
+  uint16_t m_port = 0;
+  std::atomic<bool> m_stop{false};
+  std::atomic<unsigned int> m_requests{0};
+  std::thread m_acceptThread;
+  std::mutex m_mutex;
+  std::set<int> m_connections;
+  std::vector<std::thread> m_threads;
+};
+
+std::string CreateContent(size_t size)
+{
+  std::string content(size, '\0');
+  for (size_t i = 0; i < size; ++i)
+    content[i] = static_cast<char>((i * 31 + i / 251) % 256);
+  return content;
+}
+
+/*!
+ * Read the source sequentially from the given position, over a plain connection if connections
+ * is 1 and over the parallel reader otherwise.
+ */
+class CSequentialReader
+{
+public:
+  bool Open(const std::string& url, unsigned int connections, size_t stripeSize)
+  {
+    if (!m_source.Open(url, READ_NO_CACHE | READ_TRUNCATED | READ_CHUNKED))
+      return false;
+    if (connections > 1)
+    {
+      m_reader.reset(new CParallelRangeReader()); // C++14 - Replace with std::make_unique
+      return m_reader->Open(CURL(url), connections, &m_source, stripeSize);
+    }
+    return true;
+  }
+
+  void Abort()
+  {
+    if (m_reader)
+      m_reader->Abort();
+  }
+
+  ~CSequentialReader()
+  {
+    m_reader.reset();
+    m_source.Close();
+  }
+
+  std::string Read(int64_t position, size_t size)
+  {
+    if (!m_reader && m_source.Seek(position, SEEK_SET) != position)
+      return std::string();
+
+    std::string result;
+    char buffer[40000];
+    while (result.size() < size)
+    {
+      const size_t length = std::min(sizeof(buffer), size - result.size());
+      const ssize_t read = m_reader ? m_reader->Read(position, buffer, length)
+                                    : m_source.Read(buffer, length);
+      if (read <= 0)
+        break;
+      result.append(buffer, read);
+      position += read;
+    }
+    return result;
+  }
+
+private:
+  CFile m_source;
+  std::unique_ptr<CParallelRangeReader> m_reader;
+};
+} // unnamed namespace
+
+TEST(TestParallelRangeReader, ReadsSourceInStripes)
+{
+  const size_t stripeSize = 64 * 1024;
+  const unsigned int connections = 4;
+  const std::string content = CreateContent(1024 * 1024 + 1000);
+  CThrottledHttpServer server(content, 0, 0);
+  ASSERT_TRUE(server.Start());
+
+  CSequentialReader reader;
+  ASSERT_TRUE(reader.Open(server.GetUrl(), connections, stripeSize));
+  EXPECT_TRUE(reader.Read(0, content.size()) == content);
+
+  // every stripe is fetched with a single request, no matter the number of reads
+  const unsigned int stripes = (content.size() + stripeSize - 1) / stripeSize;
+  EXPECT_LE(server.GetRequestCount(), stripes + 2 * connections);
+
+  // seeking back and forth restarts the connections at the new position
+  EXPECT_TRUE(reader.Read(300000, 1000) == content.substr(300000, 1000));
+  EXPECT_TRUE(reader.Read(5, 100000) == content.substr(5, 100000));
+  EXPECT_TRUE(reader.Read(content.size() - 10, 100) == content.substr(content.size() - 10));
+  EXPECT_TRUE(reader.Read(content.size(), 100).empty());
+}
+
+TEST(TestParallelRangeReader, AbortStopsPendingRead)
+{
+  const std::string content = CreateContent(1024 * 1024);
+  CThrottledHttpServer server(content, 0, 1000);
+  ASSERT_TRUE(server.Start());
+
+  CSequentialReader reader;
+  ASSERT_TRUE(reader.Open(server.GetUrl(), 2, 64 * 1024));
+
+  // every request takes a second to be answered, the read after the seek has to wait for it
+  std::thread abort([&reader]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    reader.Abort();
+  });
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_TRUE(reader.Read(500000, 100).empty());
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(900));
+  abort.join();
+
+  // and stays aborted
+  EXPECT_TRUE(reader.Read(0, 100).empty());
+}
+
+// Startup and throughput of a source limited to 1 MiB/s per connection with a latency of 50 ms.
+// Run with --gtest_also_run_disabled_tests.
+TEST(TestParallelRangeReader, DISABLED_ThrottledServerBenchmark)
+{
+  const size_t rate = 1024 * 1024;
+  const size_t firstData = 256 * 1024; // roughly what the demuxer needs for the first frame
+  const std::string content = CreateContent(16 * 1024 * 1024);
+  CThrottledHttpServer server(content, rate, 50);
+  ASSERT_TRUE(server.Start());
+
+  for (unsigned int connections : {1, 2, 4, 8})
+  {
+    const auto start = std::chrono::steady_clock::now();
+    CSequentialReader reader;
+    ASSERT_TRUE(reader.Open(server.GetUrl(), connections, 1024 * 1024));
+    ASSERT_TRUE(reader.Read(0, firstData) == content.substr(0, firstData));
+    const auto first = std::chrono::steady_clock::now();
+    ASSERT_TRUE(reader.Read(firstData, content.size()) == content.substr(firstData));
+    const auto end = std::chrono::steady_clock::now();
+
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    printf("%u connection(s): first %zu KiB after %lld ms, %.2f MiB/s over %zu MiB\n",
+           connections, firstData / 1024,
+           static_cast<long long>(
+               std::chrono::duration_cast<std::chrono::milliseconds>(first - start).count()),
+           content.size() / seconds / (1024 * 1024), content.size() / (1024 * 1024));
+  }
+}
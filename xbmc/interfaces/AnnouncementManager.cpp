@@ -19,10 +19,22 @@
 #include "utils/log.h"
 #include "video/VideoDatabase.h"
 
+#include <algorithm>
+#include <iterator>
 #include <stdio.h>
 
 #define LOOKUP_PROPERTY "database-lookup"
 
+namespace
+{
+// Upper bound for queued announcements. Library scans can queue thousands of
+// updates faster than slow announcers (e.g. remote JSON-RPC clients) consume them.
+constexpr size_t MAX_QUEUE_DEPTH = 4096;
+
+// Deliveries taking longer than this from queueing are logged.
+constexpr std::chrono::milliseconds LATENCY_WARN_THRESHOLD{1000};
+}
+
 using namespace ANNOUNCEMENT;
 
 CAnnouncementManager::CAnnouncementManager() : CThread("Announce")
@@ -44,6 +56,20 @@ void CAnnouncementManager::Deinitialize()
   m_bStop = true;
   m_queueEvent.Set();
   StopThread();
+
+  {
+    CSingleLock lock(m_queueCritSection);
+    if (m_statistics.queued > 0)
+      CLog::Log(LOGDEBUG,
+                "CAnnouncementManager - queued: {}, coalesced: {}, dropped: {}, delivered: {}, "
+                "max depth: {}, max latency: {} ms, avg latency: {} ms",
+                m_statistics.queued, m_statistics.coalesced, m_statistics.dropped,
+                m_statistics.delivered, m_statistics.maxDepth, m_statistics.maxLatency.count(),
+                m_statistics.delivered > 0
+                    ? m_statistics.totalLatency.count() / m_statistics.delivered
+                    : 0);
+  }
+
   CSingleLock lock (m_announcersCritSection);
   m_announcers.clear();
 }
@@ -101,11 +127,142 @@ void CAnnouncementManager::Announce(AnnouncementFlag flag, const char *sender, c
   if (item != nullptr)
     announcement.item = CFileItemPtr(new CFileItem(*item));
 
+  announcement.key = GetCoalescingKey(announcement);
+  announcement.queued = std::chrono::steady_clock::now();
+
+  Enqueue(std::move(announcement));
+  m_queueEvent.Set();
+}
+
+CAnnouncementManager::SStatistics CAnnouncementManager::GetStatistics() const
+{
+  CSingleLock lock(m_queueCritSection);
+  return m_statistics;
+}
+
+std::string CAnnouncementManager::GetCoalescingKey(const CAnnounceData& announcement)
+{
+  // Only library style announcements referring to a database item by type and
+  // id are coalesced; a newer one makes a still queued older one redundant.
+  if (announcement.flag == Player)
+    return "";
+
+  if (announcement.item != nullptr)
   {
-    CSingleLock lock (m_queueCritSection);
-    m_announcementQueue.push_back(announcement);
+    // file items are keyed by their database id if they have one already, otherwise it is only
+    // looked up on delivery. They are delivered in a different shape, so they only replace
+    // announcements of file items.
+    const CFileItem& item = *announcement.item;
+    std::string type;
+    int id = 0;
+    if (item.HasPVRChannelInfoTag())
+    {
+      type = "channel";
+      id = item.GetPVRChannelInfoTag()->ChannelID();
+    }
+    else if (item.HasVideoInfoTag() && !item.HasPVRRecordingInfoTag())
+    {
+      id = item.GetVideoInfoTag()->m_iDbId;
+      if (!item.GetVideoInfoTag()->m_type.empty())
+        type = item.GetVideoInfoTag()->m_type;
+      else
+        CVideoDatabase::VideoContentTypeToString(
+            static_cast<VIDEODB_CONTENT_TYPE>(item.GetVideoContentType()), type);
+    }
+    else if (item.HasMusicInfoTag())
+    {
+      type = MediaTypeSong;
+      id = item.GetMusicInfoTag()->GetDatabaseId();
+    }
+
+    if (id <= 0 || type.empty())
+      return "";
+
+    return StringUtils::Format("{}/{}/{}/item/{}/{}", static_cast<int>(announcement.flag),
+                               announcement.sender, announcement.message, type, id);
   }
-  m_queueEvent.Set();
+
+  if (!announcement.data.isObject() || !announcement.data.isMember("type") ||
+      !announcement.data.isMember("id"))
+    return "";
+
+  return StringUtils::Format("{}/{}/{}/{}/{}", static_cast<int>(announcement.flag),
+                             announcement.sender, announcement.message,
+                             announcement.data["type"].asString(),
+                             announcement.data["id"].asInteger());
+}
+
+void CAnnouncementManager::Enqueue(CAnnounceData&& announcement)
+{
+  CSingleLock lock(m_queueCritSection);
+
+  m_statistics.queued++;
+
+  if (!announcement.key.empty())
+  {
+    const auto it = m_pending.find(announcement.key);
+    if (it != m_pending.end())
+    {
+      // keep flags like "added" of the superseded announcement
+      CAnnounceData& queued = *it->second;
+      const CVariant& olddata = queued.data;
+      for (auto member = olddata.begin_map(); member != olddata.end_map(); ++member)
+      {
+        if (!announcement.data.isMember(member->first))
+          announcement.data[member->first] = member->second;
+      }
+
+      // the newer announcement takes the place of the older one, so an item updated over and
+      // over again is not pushed back behind all the others
+      announcement.queued = queued.queued;
+      queued = std::move(announcement);
+      m_statistics.coalesced++;
+      return;
+    }
+  }
+
+  if (announcement.flag != Player &&
+      m_announcementQueue.size() + m_priorityQueue.size() >= MAX_QUEUE_DEPTH)
+  {
+    // Only library updates that could have been coalesced can be shed, a later update of the
+    // same item or a scan finished announcement makes clients refresh them anyway. Everything
+    // else has to be delivered, so the queue grows beyond its limit instead.
+    const auto oldest = std::find_if(m_announcementQueue.begin(), m_announcementQueue.end(),
+                                     [](const CAnnounceData& queued) {
+                                       return !queued.key.empty() &&
+                                              (queued.flag == VideoLibrary ||
+                                               queued.flag == AudioLibrary);
+                                     });
+    if (oldest != m_announcementQueue.end())
+    {
+      if (m_statistics.dropped == 0)
+        CLog::Log(LOGWARNING,
+                  "CAnnouncementManager - queue full, dropping library updates ({} from {})",
+                  oldest->message, oldest->sender);
+      m_pending.erase(oldest->key);
+      m_announcementQueue.erase(oldest);
+      m_statistics.dropped++;
+    }
+    else if (m_announcementQueue.size() + m_priorityQueue.size() == MAX_QUEUE_DEPTH)
+    {
+      CLog::Log(LOGWARNING, "CAnnouncementManager - queue full, nothing to drop, growing it");
+    }
+  }
+
+  if (announcement.flag == Player)
+  {
+    m_priorityQueue.push_back(std::move(announcement));
+  }
+  else
+  {
+    const std::string key = announcement.key;
+    m_announcementQueue.push_back(std::move(announcement));
+    if (!key.empty())
+      m_pending[key] = std::prev(m_announcementQueue.end());
+  }
+
+  m_statistics.depth = m_announcementQueue.size() + m_priorityQueue.size();
+  m_statistics.maxDepth = std::max(m_statistics.maxDepth, m_statistics.depth);
 }
 
 void CAnnouncementManager::DoAnnounce(AnnouncementFlag flag, const char *sender, const char *message, const CVariant &data)
@@ -275,12 +432,29 @@ void CAnnouncementManager::Process()
   while (!m_bStop)
   {
     CSingleLock lock (m_queueCritSection);
-    if (!m_announcementQueue.empty())
+    if (!m_priorityQueue.empty() || !m_announcementQueue.empty())
     {
-      auto announcement = m_announcementQueue.front();
-      m_announcementQueue.pop_front();
+      // player announcements are not held up behind queued library updates
+      std::list<CAnnounceData>& queue =
+          !m_priorityQueue.empty() ? m_priorityQueue : m_announcementQueue;
+      CAnnounceData announcement = std::move(queue.front());
+      queue.pop_front();
+      if (!announcement.key.empty())
+        m_pending.erase(announcement.key);
+      m_statistics.depth = m_announcementQueue.size() + m_priorityQueue.size();
+
+      const auto latency = std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now() - announcement.queued);
+      m_statistics.delivered++;
+      m_statistics.totalLatency += latency;
+      m_statistics.maxLatency = std::max(m_statistics.maxLatency, latency);
+      const size_t depth = m_statistics.depth;
       {
         CSingleExit ex(m_queueCritSection);
+        if (latency > LATENCY_WARN_THRESHOLD)
+          CLog::Log(LOGDEBUG, LOGANNOUNCE,
+                    "CAnnouncementManager - {} from {} delivered after {} ms, {} queued",
+                    announcement.message, announcement.sender, latency.count(), depth);
         DoAnnounce(announcement.flag, announcement.sender.c_str(), announcement.message.c_str(), announcement.item, announcement.data);
       }
     }
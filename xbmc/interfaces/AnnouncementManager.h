@@ -15,7 +15,10 @@
 #include "threads/Thread.h"
 #include "utils/Variant.h"
 
+#include <chrono>
 #include <list>
+#include <map>
+#include <string>
 #include <vector>
 
 class CVariant;
@@ -41,6 +44,23 @@ namespace ANNOUNCEMENT
     void Announce(AnnouncementFlag flag, const char *sender, const char *message,
         const std::shared_ptr<const CFileItem>& item, const CVariant &data);
 
+    struct SStatistics
+    {
+      uint64_t queued = 0; //!< announcements accepted into the queue
+      uint64_t coalesced = 0; //!< queued announcements superseded by a newer one
+      uint64_t dropped = 0; //!< announcements discarded because the queue was full
+      uint64_t delivered = 0; //!< announcements handed to the announcers
+      size_t depth = 0; //!< current number of queued announcements
+      size_t maxDepth = 0; //!< highest number of queued announcements seen
+      std::chrono::milliseconds maxLatency{0}; //!< longest time from queueing to delivery
+      std::chrono::milliseconds totalLatency{0}; //!< sum of all queueing to delivery times
+    };
+
+    /*!
+     \brief Get queue depth and delivery latency figures since start.
+     */
+    SStatistics GetStatistics() const;
+
   protected:
     void Process() override;
     void DoAnnounce(AnnouncementFlag flag, const char *sender, const char *message, CFileItemPtr item, const CVariant &data);
@@ -53,16 +73,24 @@ namespace ANNOUNCEMENT
       std::string message;
       CFileItemPtr item;
       CVariant data;
+      std::string key; //!< coalescing key, empty if the announcement can't be coalesced
+      std::chrono::steady_clock::time_point queued;
     };
     std::list<CAnnounceData> m_announcementQueue;
+    std::list<CAnnounceData> m_priorityQueue; //!< player announcements, delivered first
+    std::map<std::string, std::list<CAnnounceData>::iterator> m_pending; //!< coalescing key -> queued announcement
     CEvent m_queueEvent;
 
   private:
     CAnnouncementManager(const CAnnouncementManager&) = delete;
     CAnnouncementManager const& operator=(CAnnouncementManager const&) = delete;
 
+    static std::string GetCoalescingKey(const CAnnounceData& announcement);
+    void Enqueue(CAnnounceData&& announcement);
+
     CCriticalSection m_announcersCritSection;
-    CCriticalSection m_queueCritSection;
+    mutable CCriticalSection m_queueCritSection;
+    SStatistics m_statistics;
     std::vector<IAnnouncer *> m_announcers;
   };
 }
@@ -61,6 +61,7 @@ JsonRpcMethodMap CJSONServiceDescription::m_methodMaps[] = {
   { "Player.Zoom",                                  CPlayerOperations::Zoom },
   { "Player.SetViewMode",                           CPlayerOperations::SetViewMode },
   { "Player.GetViewMode",                           CPlayerOperations::GetViewMode },
+  { "Player.GetRenderTimings",                      CPlayerOperations::GetRenderTimings },
   { "Player.Rotate",                                CPlayerOperations::Rotate },
 
   { "Player.Open",                                  CPlayerOperations::Open },
@@ -640,6 +640,36 @@ JSONRPC_STATUS CPlayerOperations::GetViewMode(const std::string &method, ITransp
   return OK;
 }
 
+JSONRPC_STATUS CPlayerOperations::GetRenderTimings(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant &parameterObject, CVariant &result)
+{
+  std::vector<CRenderTimings::SFrameTiming> frames;
+  CRenderTimings::SStatistics statistics;
+  if (!g_application.GetAppPlayer().GetRenderTimings(frames, statistics))
+    return FailedToExecute;
+
+  result["statistics"]["frames"] = statistics.frames;
+  result["statistics"]["skipped"] = statistics.skipped;
+  result["statistics"]["wait"] = statistics.wait;
+  result["statistics"]["latency"] = statistics.latency;
+  result["statistics"]["interval"] = statistics.interval;
+  result["statistics"]["jitter"] = statistics.jitter;
+
+  result["frames"] = CVariant(CVariant::VariantTypeArray);
+  for (const auto& frame : frames)
+  {
+    CVariant timing(CVariant::VariantTypeObject);
+    timing["pts"] = frame.pts;
+    timing["decoded"] = frame.decoded;
+    timing["queued"] = frame.queued;
+    timing["presented"] = frame.presented;
+    timing["rendered"] = frame.rendered;
+    timing["skipped"] = frame.skipped;
+    result["frames"].push_back(timing);
+  }
+
+  return OK;
+}
+
 JSONRPC_STATUS CPlayerOperations::Rotate(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant &parameterObject, CVariant &result)
 {
   switch (GetPlayer(parameterObject["playerid"]))
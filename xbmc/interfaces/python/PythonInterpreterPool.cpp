@@ -0,0 +1,127 @@
+/*
+ *  Copyright (C) 2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+// python.h should always be included first before any other includes
+#include <Python.h>
+
+#include "PythonInterpreterPool.h"
+
+#include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "utils/log.h"
+
+namespace
+{
+// time without an interpreter being taken before the pool is refilled, unless it is empty
+constexpr unsigned int REFILL_DELAY_MS = 50;
+} // unnamed namespace
+
+CPythonInterpreterPool::CPythonInterpreterPool(unsigned int size)
+  : CThread("PythonInterpreterPool"), m_size(size)
+{
+}
+
+CPythonInterpreterPool::~CPythonInterpreterPool()
+{
+  Stop();
+}
+
+void CPythonInterpreterPool::Start()
+{
+  if (m_size > 0)
+    Create(false);
+}
+
+void CPythonInterpreterPool::Stop()
+{
+  m_bStop = true;
+  m_refill.Set();
+  StopThread(true);
+
+  std::deque<PyThreadState*> idle;
+  {
+    CSingleLock lock(m_critSection);
+    idle.swap(m_idle);
+  }
+
+  if (idle.empty())
+    return;
+
+  const PyGILState_STATE gilState = PyGILState_Ensure();
+  PyThreadState* ownState = PyThreadState_Get();
+  for (PyThreadState* state : idle)
+  {
+    PyThreadState_Swap(state);
+    Py_EndInterpreter(state);
+  }
+  PyThreadState_Swap(ownState);
+  PyGILState_Release(gilState);
+}
+
+PyThreadState* CPythonInterpreterPool::Acquire()
+{
+  PyThreadState* poolState;
+  {
+    CSingleLock lock(m_critSection);
+    if (m_idle.empty())
+      return nullptr;
+
+    poolState = m_idle.front();
+    m_idle.pop_front();
+  }
+  m_lastAcquire = XbmcThreads::SystemClockMillis();
+  m_refill.Set();
+
+  // the interpreter is used by the calling thread from now on, replace the thread state of the
+  // pool's thread. The new one is created first, the interpreter must not be left without one.
+  PyThreadState* state = PyThreadState_New(poolState->interp);
+  PyThreadState_Clear(poolState);
+  PyThreadState_Delete(poolState);
+  return state;
+}
+
+void CPythonInterpreterPool::Process()
+{
+  while (!m_bStop)
+  {
+    size_t idle;
+    {
+      CSingleLock lock(m_critSection);
+      idle = m_idle.size();
+    }
+
+    if (idle >= m_size)
+    {
+      AbortableWait(m_refill);
+      continue;
+    }
+
+    const unsigned int elapsed = XbmcThreads::SystemClockMillis() - m_lastAcquire;
+    if (idle > 0 && elapsed < REFILL_DELAY_MS)
+    {
+      AbortableWait(m_refill, REFILL_DELAY_MS - elapsed);
+      continue;
+    }
+
+    const PyGILState_STATE gilState = PyGILState_Ensure();
+    PyThreadState* ownState = PyThreadState_Get();
+    PyThreadState* state = Py_NewInterpreter();
+    PyThreadState_Swap(ownState);
+    PyGILState_Release(gilState);
+
+    if (!state)
+    {
+      CLog::Log(LOGERROR, "CPythonInterpreterPool::%s - failed to create an interpreter",
+                __FUNCTION__);
+      break;
+    }
+
+    CSingleLock lock(m_critSection);
+    m_idle.push_back(state);
+  }
+}
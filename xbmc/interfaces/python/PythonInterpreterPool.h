@@ -0,0 +1,64 @@
+/*
+ *  Copyright (C) 2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "threads/Thread.h"
+
+#include <atomic>
+#include <deque>
+
+struct _ts;
+
+/*!
+ * @brief Pool of python sub-interpreters created ahead of time.
+ *
+ * Creating a sub-interpreter sets up sys, builtins and the import system and imports the codecs,
+ * which every script invocation (e.g. each plugin directory listing) used to wait for. The pool
+ * creates the interpreters on its own thread while none is needed. Every interpreter is handed
+ * out only once and ended by the invoker as before, so no state carries over between scripts.
+ * Creating an interpreter holds the GIL most of the time, so the pool waits for the scripts to
+ * settle down after an interpreter was taken before it creates the next one, unless it ran empty.
+ */
+class CPythonInterpreterPool : private CThread
+{
+public:
+  explicit CPythonInterpreterPool(unsigned int size);
+  ~CPythonInterpreterPool() override;
+
+  /*!
+   * @brief Start creating interpreters. Python has to be initialized, the caller must not hold
+   * the GIL.
+   */
+  void Start();
+
+  /*!
+   * @brief Stop creating interpreters and end the ones not taken. The caller must not hold the
+   * GIL.
+   */
+  void Stop();
+
+  /*!
+   * @brief Take an interpreter. Must be called with the GIL held.
+   * @return A new thread state of the interpreter for the calling thread, which still has to be
+   * made the current one, or nullptr if no interpreter is ready.
+   */
+  _ts* Acquire();
+
+protected:
+  void Process() override;
+
+private:
+  const unsigned int m_size;
+  CCriticalSection m_critSection;
+  CEvent m_refill;
+  std::atomic<unsigned int> m_lastAcquire{0};
+  std::deque<_ts*> m_idle; /*!< interpreters with a thread state of the pool's thread */
+};
@@ -35,6 +35,7 @@
 #include "guilib/GUIWindowManager.h"
 #include "guilib/LocalizeStrings.h"
 #include "interfaces/python/PyContext.h"
+#include "interfaces/python/PythonInterpreterPool.h"
 #include "interfaces/python/pythreadstate.h"
 #include "interfaces/python/swig.h"
 #include "interfaces/python/XBPython.h"
@@ -180,12 +181,20 @@ bool CPythonInvoker::execute(const std::string& script, const std::vector<std::w
   {
     if (!m_threadState)
     {
+      // take the pool before the GIL, XBPython's lock is also taken before the GIL elsewhere
+      std::shared_ptr<CPythonInterpreterPool> interpreterPool =
+          CServiceBroker::GetXBPython().GetInterpreterPool();
+
       // TODO: Re-write everything.
       // this is a TOTAL hack. We need the GIL but we need to borrow a PyThreadState in order to get it
       // as of Python 3.2 since PyEval_AcquireLock is deprecated
       extern PyThreadState* savestate;
       PyEval_RestoreThread(savestate);
-      l_threadState = Py_NewInterpreter();
+      l_threadState = interpreterPool ? interpreterPool->Acquire() : nullptr;
+      if (l_threadState)
+        PyThreadState_Swap(l_threadState);
+      else
+        l_threadState = Py_NewInterpreter();
       PyEval_ReleaseThread(l_threadState);
       if (l_threadState == NULL)
       {
@@ -32,6 +32,7 @@
 #include "interfaces/legacy/Monitor.h"
 #include "interfaces/legacy/AddonUtils.h"
 #include "interfaces/python/AddonPythonInvoker.h"
+#include "interfaces/python/PythonInterpreterPool.h"
 #include "interfaces/python/PythonInvoker.h"
 #include "ServiceBroker.h"
 
@@ -465,8 +466,13 @@ void XBPython::Finalize()
     m_bInitialized    = false;
     PyThreadState* curTs = (PyThreadState*)m_mainThreadState;
     m_mainThreadState = NULL; // clear the main thread state before releasing the lock
+    std::shared_ptr<CPythonInterpreterPool> interpreterPool;
+    interpreterPool.swap(m_interpreterPool);
     {
       CSingleExit exit(m_critSection);
+      if (interpreterPool)
+        interpreterPool->Stop();
+
       PyEval_AcquireThread(curTs);
 
       Py_Finalize();
@@ -606,6 +612,14 @@ bool XBPython::OnScriptInitialized(ILanguageInvoker *invoker)
       CLog::Log(LOGERROR, "Python threadstate is NULL.");
     savestate = PyEval_SaveThread();
 
+    const unsigned int interpreterPoolSize =
+        CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_pythonInterpreterPoolSize;
+    if (interpreterPoolSize > 0)
+    {
+      m_interpreterPool = std::make_shared<CPythonInterpreterPool>(interpreterPoolSize);
+      m_interpreterPool->Start();
+    }
+
     m_bInitialized = true;
   }
 
@@ -677,6 +691,12 @@ void XBPython::OnScriptFinalized(ILanguageInvoker *invoker)
   m_endtime = XbmcThreads::SystemClockMillis();
 }
 
+std::shared_ptr<CPythonInterpreterPool> XBPython::GetInterpreterPool()
+{
+  CSingleLock lock(m_critSection);
+  return m_interpreterPool;
+}
+
 ILanguageInvoker* XBPython::CreateInvoker()
 {
   return new CAddonPythonInvoker(this);
@@ -21,6 +21,7 @@
 
 #define g_pythonParser CServiceBroker::GetXBPython()
 
+class CPythonInterpreterPool;
 class CPythonInvoker;
 class CVariant;
 
@@ -101,11 +102,18 @@ public:
   void UnregisterExtensionLib(LibraryLoader *pLib);
   void UnloadExtensionLibs();
 
+  /*!
+   * @brief Get the pool of sub-interpreters created ahead of time.
+   * @return The pool, or nullptr if python isn't initialized or the pool is disabled.
+   */
+  std::shared_ptr<CPythonInterpreterPool> GetInterpreterPool();
+
 private:
   void Finalize();
 
   CCriticalSection    m_critSection;
   void*             m_mainThreadState;
+  std::shared_ptr<CPythonInterpreterPool> m_interpreterPool;
   bool              m_bInitialized;
   int               m_iDllScriptCounter; // to keep track of the total scripts running that need the dll
   unsigned int      m_endtime;
@@ -0,0 +1,160 @@
+/*
+ *  Copyright (C) 2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+// python.h should always be included first before any other includes
+#include <Python.h>
+
+#include "interfaces/python/PythonInterpreterPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+// stands in for the entry script of a plugin
+const char* PLUGIN_SCRIPT = "import sys, json\n"
+                            "items = [{'label': 'item %d' % i, 'path': sys.argv[0]} for i in range(50)]\n"
+                            "listing = json.dumps(items)\n";
+
+class TestPythonInterpreterPool : public ::testing::Test
+{
+protected:
+  static void SetUpTestCase()
+  {
+    Py_Initialize();
+    s_mainState = PyEval_SaveThread();
+  }
+
+  static void TearDownTestCase()
+  {
+    PyEval_RestoreThread(s_mainState);
+    Py_Finalize();
+  }
+
+  // take an interpreter from the pool, waiting for the pool to create one
+  PyThreadState* Acquire(CPythonInterpreterPool& pool)
+  {
+    for (int i = 0; i < 500; ++i)
+    {
+      PyEval_RestoreThread(s_mainState);
+      PyThreadState* state = pool.Acquire();
+      if (state)
+      {
+        PyThreadState_Swap(state);
+        return state;
+      }
+      PyEval_SaveThread();
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return nullptr;
+  }
+
+  // same as CPythonInvoker without a pool
+  PyThreadState* Create()
+  {
+    PyEval_RestoreThread(s_mainState);
+    return Py_NewInterpreter();
+  }
+
+  // run a script in the interpreter of the current thread state and end it
+  bool Run(PyThreadState* state, const char* script)
+  {
+    const bool result = PyRun_SimpleString(script) == 0;
+    Py_EndInterpreter(state);
+    PyThreadState_Swap(s_mainState);
+    PyEval_SaveThread();
+    return result;
+  }
+
+  static PyThreadState* s_mainState;
+};
+
+PyThreadState* TestPythonInterpreterPool::s_mainState = nullptr;
+} // unnamed namespace
+
+TEST_F(TestPythonInterpreterPool, InterpretersAreNotShared)
+{
+  CPythonInterpreterPool pool(2);
+  pool.Start();
+
+  PyThreadState* state = Acquire(pool);
+  ASSERT_NE(nullptr, state);
+  EXPECT_TRUE(Run(state, "import sys\nsys.modules['__main__'].leftover = 1\n"));
+
+  state = Acquire(pool);
+  ASSERT_NE(nullptr, state);
+  EXPECT_TRUE(Run(state, "import sys\nassert not hasattr(sys.modules['__main__'], 'leftover')\n"));
+
+  pool.Stop();
+}
+
+TEST_F(TestPythonInterpreterPool, StopEndsIdleInterpreters)
+{
+  CPythonInterpreterPool pool(2);
+  pool.Start();
+
+  PyThreadState* state = Acquire(pool);
+  ASSERT_NE(nullptr, state);
+  EXPECT_TRUE(Run(state, PLUGIN_SCRIPT));
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  pool.Stop();
+
+  // nothing is handed out after stopping
+  PyEval_RestoreThread(s_mainState);
+  EXPECT_EQ(nullptr, pool.Acquire());
+  PyEval_SaveThread();
+}
+
+// Latency of 1000 invocations of a plugin-like script, each in a new interpreter as
+// CPythonInvoker does, with and without the pool. The invocations are 100 ms apart, like fast
+// navigation through a plugin. Run with --gtest_also_run_disabled_tests.
+TEST_F(TestPythonInterpreterPool, DISABLED_InvocationBenchmark)
+{
+  for (const bool usePool : {false, true})
+  {
+    CPythonInterpreterPool pool(2);
+    if (usePool)
+      pool.Start();
+
+    std::vector<double> latencies;
+    for (int i = 0; i < 1000; ++i)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+      const auto start = std::chrono::steady_clock::now();
+      PyThreadState* state = nullptr;
+      if (usePool)
+      {
+        PyEval_RestoreThread(s_mainState);
+        state = pool.Acquire();
+        if (state)
+          PyThreadState_Swap(state);
+        else
+          state = Py_NewInterpreter();
+      }
+      else
+        state = Create();
+      ASSERT_NE(nullptr, state);
+      ASSERT_TRUE(Run(state, PLUGIN_SCRIPT));
+      latencies.emplace_back(
+          std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+              .count());
+    }
+    pool.Stop();
+
+    std::sort(latencies.begin(), latencies.end());
+    printf("%s: median %.2f ms, p99 %.2f ms\n", usePool ? "pool" : "no pool",
+           latencies[latencies.size() / 2], latencies[latencies.size() * 99 / 100]);
+  }
+}
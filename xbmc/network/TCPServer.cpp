@@ -224,7 +224,8 @@ int CTCPServer::GetCapabilities()
 
 void CTCPServer::Announce(ANNOUNCEMENT::AnnouncementFlag flag, const char *sender, const char *message, const CVariant &data)
 {
-  std::string str = IJSONRPCAnnouncer::AnnouncementToJSONRPC(flag, sender, message, data, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_jsonOutputCompact);
+  // serialize (and frame) only once for all interested clients
+  std::unique_ptr<CAnnouncementMessage> announcement;
 
   for (unsigned int i = 0; i < m_connections.size(); i++)
   {
@@ -234,10 +235,31 @@ void CTCPServer::Announce(ANNOUNCEMENT::AnnouncementFlag flag, const char *sende
         continue;
     }
 
-    m_connections[i]->Send(str.c_str(), str.size());
+    if (!announcement)
+    {
+      const bool compact = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_jsonOutputCompact;
+      announcement.reset(new CAnnouncementMessage(
+          IJSONRPCAnnouncer::AnnouncementToJSONRPC(flag, sender, message, data, compact)));
+    }
+
+    m_connections[i]->Send(*announcement);
   }
 }
 
+const std::string& CTCPServer::CAnnouncementMessage::GetWebSocketFrame()
+{
+  // server to client frames are never masked so they are the same for all
+  // protocol versions and clients
+  if (m_frame.empty())
+  {
+    CWebSocketFrame frame(WebSocketTextFrame, m_json.c_str(), static_cast<uint32_t>(m_json.size()));
+    if (frame.IsValid())
+      m_frame.assign(frame.GetFrameData(), static_cast<size_t>(frame.GetFrameLength()));
+  }
+
+  return m_frame;
+}
+
 bool CTCPServer::Initialize()
 {
   Deinitialize();
@@ -534,6 +556,12 @@ void CTCPServer::CTCPClient::Send(const char *data, unsigned int size)
   } while (sent < size);
 }
 
+void CTCPServer::CTCPClient::Send(CAnnouncementMessage& announcement)
+{
+  const std::string& json = announcement.GetJSON();
+  Send(json.c_str(), json.size());
+}
+
 void CTCPServer::CTCPClient::PushBuffer(CTCPServer *host, const char *buffer, int length)
 {
   m_new = false;
@@ -664,8 +692,8 @@ CTCPServer::CWebSocketClient& CTCPServer::CWebSocketClient::operator=(const CWeb
 
 void CTCPServer::CWebSocketClient::Send(const char *data, unsigned int size)
 {
-  const CWebSocketMessage *msg = m_websocket->Send(WebSocketTextFrame, data, size);
-  if (msg == NULL || !msg->IsComplete())
+  std::unique_ptr<const CWebSocketMessage> msg(m_websocket->Send(WebSocketTextFrame, data, size));
+  if (!msg || !msg->IsComplete())
     return;
 
   std::vector<const CWebSocketFrame *> frames = msg->GetFrames();
@@ -673,6 +701,15 @@ void CTCPServer::CWebSocketClient::Send(const char *data, unsigned int size)
     CTCPClient::Send(frames.at(index)->GetFrameData(), (unsigned int)frames.at(index)->GetFrameLength());
 }
 
+void CTCPServer::CWebSocketClient::Send(CAnnouncementMessage& announcement)
+{
+  const std::string& frame = announcement.GetWebSocketFrame();
+  if (frame.empty())
+    return;
+
+  CTCPClient::Send(frame.c_str(), frame.size());
+}
+
 void CTCPServer::CWebSocketClient::PushBuffer(CTCPServer *host, const char *buffer, int length)
 {
   bool send;
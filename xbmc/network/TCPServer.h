@@ -15,6 +15,8 @@
 #include "threads/Thread.h"
 #include "websocket/WebSocket.h"
 
+#include <memory>
+#include <string>
 #include <vector>
 
 #include <sys/socket.h>
@@ -46,6 +48,20 @@ namespace JSONRPC
     bool InitializeTCP();
     void Deinitialize();
 
+    // An announcement rendered once and shared by all clients it is sent to
+    class CAnnouncementMessage
+    {
+    public:
+      explicit CAnnouncementMessage(std::string json) : m_json(std::move(json)) {}
+
+      const std::string& GetJSON() const { return m_json; }
+      const std::string& GetWebSocketFrame();
+
+    private:
+      std::string m_json;
+      std::string m_frame;
+    };
+
     class CTCPClient : public IClient
     {
     public:
@@ -61,6 +77,7 @@ namespace JSONRPC
       bool SetAnnouncementFlags(int flags) override;
 
       virtual void Send(const char *data, unsigned int size);
+      virtual void Send(CAnnouncementMessage& announcement);
       virtual void PushBuffer(CTCPServer *host, const char *buffer, int length);
       virtual void Disconnect();
 
@@ -92,6 +109,7 @@ namespace JSONRPC
       ~CWebSocketClient() override;
 
       void Send(const char *data, unsigned int size) override;
+      void Send(CAnnouncementMessage& announcement) override;
       void PushBuffer(CTCPServer *host, const char *buffer, int length) override;
       void Disconnect() override;
 
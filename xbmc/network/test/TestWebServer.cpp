@@ -16,7 +16,9 @@
 #include <gtest/gtest.h>
 #include "URL.h"
 #include "filesystem/CurlFile.h"
+#include "filesystem/DllLibCurl.h"
 #include "filesystem/File.h"
+#include "filesystem/ParallelRangeReader.h"
 #include "interfaces/json-rpc/JSONRPC.h"
 #include "network/WebServer.h"
 #include "network/httprequesthandler/HTTPVfsHandler.h"
@@ -28,7 +30,10 @@
 #include "utils/URIUtils.h"
 #include "utils/Variant.h"
 
+#include <atomic>
+#include <chrono>
 #include <random>
+#include <thread>
 
 using namespace XFILE;
 
@@ -897,3 +902,106 @@ TEST_F(TestWebServer, CanGetCachedRangedFileWithNewerIfRange)
   ASSERT_TRUE(curl.Get(GetUrlOfTestFile(TEST_FILES_RANGES), result));
   CheckRangesTestFileResponse(curl, result, ranges);
 }
+
+TEST_F(TestWebServer, CanReuseConnectionForSequentialRequests)
+{
+  std::string result;
+
+  // the first request may or may not find an open connection to the webserver
+  {
+    CCurlFile curl;
+    curl.SetRequestHeader(MHD_HTTP_HEADER_RANGE, "");
+    ASSERT_TRUE(curl.Get(GetUrlOfTestFile(TEST_FILES_HTML), result));
+  }
+
+  const auto before = g_curlInterface.GetConnectionStats();
+
+  // the second request to the same host has to reuse the pooled connection
+  {
+    CCurlFile curl;
+    curl.SetRequestHeader(MHD_HTTP_HEADER_RANGE, "");
+    ASSERT_TRUE(curl.Get(GetUrlOfTestFile(TEST_FILES_HTML), result));
+    EXPECT_STREQ(TEST_FILES_DATA, result.c_str());
+  }
+
+  const auto after = g_curlInterface.GetConnectionStats();
+  EXPECT_EQ(before.m_new, after.m_new);
+  EXPECT_EQ(before.m_reused + 1, after.m_reused);
+}
+
+TEST_F(TestWebServer, LimitsSessionsPerHost)
+{
+  // no transfers are done, only the sessions are taken
+  std::vector<CURL_HANDLE*> sessions(8, nullptr);
+  for (auto& session : sessions)
+  {
+    g_curlInterface.easy_acquire("http", "limit.test", &session, nullptr);
+    ASSERT_NE(nullptr, session);
+  }
+
+  const auto before = g_curlInterface.GetConnectionStats();
+
+  std::atomic<bool> acquired(false);
+  CURL_HANDLE* waiting = nullptr;
+  std::thread thread([&waiting, &acquired]() {
+    g_curlInterface.easy_acquire("http", "limit.test", &waiting, nullptr);
+    acquired = true;
+  });
+
+  // other hosts are not held up
+  CURL_HANDLE* other = nullptr;
+  g_curlInterface.easy_acquire("http", "other.test", &other, nullptr);
+  ASSERT_NE(nullptr, other);
+  g_curlInterface.easy_release(&other, nullptr);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  EXPECT_FALSE(acquired);
+
+  g_curlInterface.easy_release(&sessions.back(), nullptr);
+  sessions.pop_back();
+  thread.join();
+  EXPECT_TRUE(acquired);
+  EXPECT_NE(nullptr, waiting);
+  EXPECT_EQ(before.m_limited + 1, g_curlInterface.GetConnectionStats().m_limited);
+
+  g_curlInterface.easy_release(&waiting, nullptr);
+  for (auto& session : sessions)
+    g_curlInterface.easy_release(&session, nullptr);
+}
+
+TEST_F(TestWebServer, CanReadRangesOverParallelConnections)
+{
+  // tiny stripes so every connection fetches several of them
+  CParallelRangeReader reader;
+  ASSERT_TRUE(reader.Open(CURL(GetUrlOfTestFile(TEST_FILES_RANGES)), 3, nullptr, 4));
+  EXPECT_EQ(3u, reader.GetConnectionCount());
+
+  const auto readRange = [&reader](int64_t position, size_t size) {
+    std::string result;
+    char buffer[16];
+    while (result.size() < size)
+    {
+      const ssize_t read =
+          reader.Read(position, buffer, std::min(sizeof(buffer), size - result.size()));
+      if (read <= 0)
+        break;
+      result.append(buffer, read);
+      position += read;
+    }
+    return result;
+  };
+
+  // the whole file, spread over all connections
+  EXPECT_EQ(TEST_FILES_DATA_RANGES, readRange(0, strlen(TEST_FILES_DATA_RANGES)));
+
+  // a range in the middle of the file, starting within a stripe
+  EXPECT_EQ("range2", readRange(7, 6));
+
+  // seeking back to the start
+  EXPECT_EQ("range1", readRange(0, 6));
+
+  // a range reaching past the end of the file only returns the available data
+  EXPECT_EQ("range3", readRange(14, 10));
+  char byte;
+  EXPECT_EQ(0, reader.Read(strlen(TEST_FILES_DATA_RANGES), &byte, 1));
+}
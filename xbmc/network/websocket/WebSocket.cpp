@@ -426,5 +426,6 @@ const CWebSocketMessage* CWebSocket::Send(WebSocketFrameOpcode opcode, const cha
   if (msg->IsComplete())
     return msg;
 
+  delete msg;
   return NULL;
 }
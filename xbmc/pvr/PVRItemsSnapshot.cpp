@@ -0,0 +1,41 @@
+/*
+ *  Copyright (C) 2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "PVRItemsSnapshot.h"
+
+#include "utils/log.h"
+
+using namespace PVR;
+
+namespace
+{
+// number of reads after which the statistics get logged
+constexpr size_t STATISTICS_INTERVAL = 1000;
+} // unnamed namespace
+
+void CPVRItemsSnapshotStatistics::OnRead()
+{
+  const size_t iReads = ++m_iReads;
+  if (iReads % STATISTICS_INTERVAL == 0)
+    CLog::LogFC(LOGDEBUG, LOGPVR,
+                "%s: %zu reads, %zu served without lock, %zu rebuilds waited %u ms for the lock",
+                m_strName.c_str(), iReads, iReads - m_iRebuilds, m_iWaits.load(),
+                m_iWaitTime.load());
+}
+
+void CPVRItemsSnapshotStatistics::OnRebuild(unsigned int iWaitTime, size_t iSize)
+{
+  ++m_iRebuilds;
+  if (iWaitTime > 0)
+  {
+    ++m_iWaits;
+    m_iWaitTime += iWaitTime;
+    CLog::LogFC(LOGDEBUG, LOGPVR, "%s: waited %u ms for the lock to copy %zu items",
+                m_strName.c_str(), iWaitTime, iSize);
+  }
+}
@@ -0,0 +1,97 @@
+/*
+ *  Copyright (C) 2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+#include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace PVR
+{
+/*!
+ * @brief Usage statistics of a snapshot, logged periodically.
+ */
+class CPVRItemsSnapshotStatistics
+{
+public:
+  explicit CPVRItemsSnapshotStatistics(const std::string& strName) : m_strName(strName) {}
+
+protected:
+  void OnRead();
+  void OnRebuild(unsigned int iWaitTime, size_t iSize);
+
+private:
+  const std::string m_strName;
+  std::atomic<size_t> m_iReads{0};
+  std::atomic<size_t> m_iRebuilds{0};
+  std::atomic<size_t> m_iWaits{0}; /*!< rebuilds that had to wait for the lock */
+  std::atomic<unsigned int> m_iWaitTime{0}; /*!< total time spent waiting for the lock, in ms */
+};
+
+/*!
+ * @brief Immutable, reference counted copy of the items of a PVR collection.
+ *
+ * Readers obtain the current copy without taking the collection's lock. Writers invalidate the
+ * copy, with the collection's lock held, after changing the collection. The next reader then
+ * builds a new copy, which is the only time readers have to take the lock. Readers still using
+ * an older copy are not affected by changes of the collection.
+ */
+template<typename T>
+class CPVRItemsSnapshot : public CPVRItemsSnapshotStatistics
+{
+public:
+  using Items = std::vector<std::shared_ptr<T>>;
+
+  explicit CPVRItemsSnapshot(const std::string& strName) : CPVRItemsSnapshotStatistics(strName) {}
+
+  /*!
+   * @brief Get the current copy of the items.
+   * @param critSection The lock of the collection, taken if the copy has to be rebuilt.
+   * @param build Function returning the items of the collection, called with the lock held.
+   * @return The items.
+   */
+  template<typename F>
+  std::shared_ptr<const Items> Get(CCriticalSection& critSection, F build)
+  {
+    OnRead();
+
+    std::shared_ptr<const Items> items = std::atomic_load(&m_items);
+    if (items)
+      return items;
+
+    const unsigned int iStart = XbmcThreads::SystemClockMillis();
+    CSingleLock lock(critSection);
+    const unsigned int iWaitTime = XbmcThreads::SystemClockMillis() - iStart;
+
+    // another reader may have been faster
+    items = std::atomic_load(&m_items);
+    if (!items)
+    {
+      items = std::make_shared<const Items>(build());
+      std::atomic_store(&m_items, items);
+      OnRebuild(iWaitTime, items->size());
+    }
+    return items;
+  }
+
+  /*!
+   * @brief Drop the current copy. Must be called with the lock of the collection held, after the
+   * collection was changed.
+   */
+  void Invalidate() { std::atomic_store(&m_items, std::shared_ptr<const Items>()); }
+
+private:
+  std::shared_ptr<const Items> m_items;
+};
+} // namespace PVR
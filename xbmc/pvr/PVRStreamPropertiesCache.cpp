@@ -0,0 +1,124 @@
+/*
+ *  Copyright (C) 2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "PVRStreamPropertiesCache.h"
+
+#include "ServiceBroker.h"
+#include "pvr/PVRManager.h"
+#include "pvr/addons/PVRClient.h"
+#include "pvr/channels/PVRChannel.h"
+#include "pvr/channels/PVRChannelGroup.h"
+#include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "utils/JobManager.h"
+#include "utils/log.h"
+
+#include <vector>
+
+using namespace PVR;
+
+namespace
+{
+// stream properties older than this are not used for playback
+constexpr unsigned int MAX_ENTRY_AGE = 30000;
+} // unnamed namespace
+
+void CPVRStreamPropertiesCache::Prefetch(const std::shared_ptr<CPVRChannelGroup>& group,
+                                         const std::shared_ptr<CPVRChannel>& channel)
+{
+  std::vector<std::shared_ptr<CPVRChannel>> channels;
+  if (group && channel)
+  {
+    const std::shared_ptr<CPVRChannel> next = group->GetNextChannel(channel);
+    if (next && next != channel)
+      channels.emplace_back(next);
+
+    const std::shared_ptr<CPVRChannel> previous = group->GetPreviousChannel(channel);
+    if (previous && previous != channel && previous != next)
+      channels.emplace_back(previous);
+  }
+
+  unsigned int iGeneration = 0;
+  {
+    CSingleLock lock(m_critSection);
+    m_entries.clear();
+    iGeneration = ++m_iGeneration;
+  }
+
+  if (channels.empty())
+    return;
+
+  const std::weak_ptr<CPVRStreamPropertiesCache> cache = shared_from_this();
+  CJobManager::GetInstance().Submit([cache, channels, iGeneration]() {
+    for (const auto& channel : channels)
+    {
+      const std::shared_ptr<CPVRStreamPropertiesCache> self = cache.lock();
+      if (!self)
+        return;
+
+      self->Fetch(channel, iGeneration);
+    }
+  });
+}
+
+void CPVRStreamPropertiesCache::Fetch(const std::shared_ptr<CPVRChannel>& channel,
+                                      unsigned int iGeneration)
+{
+  {
+    CSingleLock lock(m_critSection);
+    if (iGeneration != m_iGeneration)
+      return;
+  }
+
+  const std::shared_ptr<CPVRClient> client =
+      CServiceBroker::GetPVRManager().GetClient(channel->ClientID());
+  if (!client)
+    return;
+
+  SEntry entry;
+  const unsigned int iStart = XbmcThreads::SystemClockMillis();
+  if (client->GetChannelStreamProperties(channel, entry.props) != PVR_ERROR_NO_ERROR ||
+      entry.props.empty())
+    return;
+
+  entry.iTime = XbmcThreads::SystemClockMillis();
+  CLog::LogFC(LOGDEBUG, LOGPVR, "Prefetched stream properties of channel '%s' in %u ms",
+              channel->ChannelName().c_str(), entry.iTime - iStart);
+
+  CSingleLock lock(m_critSection);
+  if (iGeneration == m_iGeneration)
+    m_entries[GetKey(*channel)] = std::move(entry);
+}
+
+bool CPVRStreamPropertiesCache::Take(const std::shared_ptr<CPVRChannel>& channel,
+                                     CPVRStreamProperties& props)
+{
+  CSingleLock lock(m_critSection);
+  const auto it = m_entries.find(GetKey(*channel));
+  if (it == m_entries.end())
+    return false;
+
+  const bool bFresh = XbmcThreads::SystemClockMillis() - it->second.iTime <= MAX_ENTRY_AGE;
+  if (bFresh)
+    props = std::move(it->second.props);
+
+  m_entries.erase(it);
+  return bFresh;
+}
+
+void CPVRStreamPropertiesCache::Clear()
+{
+  CSingleLock lock(m_critSection);
+  m_entries.clear();
+  ++m_iGeneration;
+}
+
+CPVRStreamPropertiesCache::ChannelKey CPVRStreamPropertiesCache::GetKey(const CPVRChannel& channel)
+{
+  return std::make_pair(channel.ClientID(), channel.UniqueID());
+}
@@ -0,0 +1,70 @@
+/*
+ *  Copyright (C) 2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "pvr/PVRStreamProperties.h"
+#include "threads/CriticalSection.h"
+
+#include <map>
+#include <memory>
+#include <utility>
+
+namespace PVR
+{
+class CPVRChannel;
+class CPVRChannelGroup;
+
+/*!
+ * @brief Stream properties of the channels next to the playing channel, obtained in advance to
+ * save the round trip to the backend when switching to one of them.
+ */
+class CPVRStreamPropertiesCache : public std::enable_shared_from_this<CPVRStreamPropertiesCache>
+{
+public:
+  /*!
+   * @brief Replace the cache contents by the stream properties of the previous and the next
+   * channel of the given channel. The properties are obtained asynchronously.
+   * @param group The group containing the channel.
+   * @param channel The channel.
+   */
+  void Prefetch(const std::shared_ptr<CPVRChannelGroup>& group,
+                const std::shared_ptr<CPVRChannel>& channel);
+
+  /*!
+   * @brief Take the stream properties of a channel from the cache. Every entry is handed out only
+   * once and only for a short time after it was obtained, as backends may return session URLs.
+   * @param channel The channel.
+   * @param props Filled with the stream properties on success.
+   * @return True if usable properties were found, false otherwise.
+   */
+  bool Take(const std::shared_ptr<CPVRChannel>& channel, CPVRStreamProperties& props);
+
+  /*!
+   * @brief Drop all cached stream properties.
+   */
+  void Clear();
+
+private:
+  using ChannelKey = std::pair<int, int>; /*!< client id, client channel uid */
+
+  struct SEntry
+  {
+    CPVRStreamProperties props;
+    unsigned int iTime = 0; /*!< time the properties were obtained */
+  };
+
+  static ChannelKey GetKey(const CPVRChannel& channel);
+
+  void Fetch(const std::shared_ptr<CPVRChannel>& channel, unsigned int iGeneration);
+
+  CCriticalSection m_critSection;
+  std::map<ChannelKey, SEntry> m_entries;
+  unsigned int m_iGeneration = 0; /*!< incremented by every prefetch, to drop outdated results */
+};
+} // namespace PVR
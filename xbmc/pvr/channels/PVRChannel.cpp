@@ -14,6 +14,7 @@
 #include "pvr/PVRDatabase.h"
 #include "pvr/PVRManager.h"
 #include "pvr/addons/PVRClient.h"
+#include "pvr/channels/PVRChannelGroupMemberIndex.h"
 #include "pvr/channels/PVRChannelsPath.h"
 #include "pvr/epg/Epg.h"
 #include "pvr/epg/EpgChannelData.h"
@@ -145,6 +146,7 @@ bool CPVRChannel::CreateEPG()
       {
         m_iEpgId = m_epg->EpgID();
         m_bChanged = true;
+        CPVRChannelGroupMemberIndex::InvalidateAll();
       }
       return true;
     }
@@ -210,6 +212,7 @@ bool CPVRChannel::SetChannelID(int iChannelId)
   if (m_iChannelId != iChannelId)
   {
     m_iChannelId = iChannelId;
+    CPVRChannelGroupMemberIndex::InvalidateAll();
 
     const std::shared_ptr<CPVREpg> epg = GetEPG();
     if (epg)
@@ -787,6 +790,7 @@ void CPVRChannel::SetEpgID(int iEpgId)
     m_iEpgId = iEpgId;
     m_epg.reset();
     m_bChanged = true;
+    CPVRChannelGroupMemberIndex::InvalidateAll();
   }
 }
 
@@ -25,6 +25,7 @@
 #include "settings/SettingsComponent.h"
 #include "settings/lib/Setting.h"
 #include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
 #include "utils/StringUtils.h"
 #include "utils/log.h"
 
@@ -124,6 +125,7 @@ void CPVRChannelGroup::Unload()
   CSingleLock lock(m_critSection);
   m_sortedMembers.clear();
   m_members.clear();
+  InvalidateMemberIndexes();
   m_failedClientsForChannels.clear();
   m_failedClientsForChannelGroupMembers.clear();
 }
@@ -172,6 +174,7 @@ bool CPVRChannelGroup::SetChannelNumber(const std::shared_ptr<CPVRChannel>& chan
         m_bChanged = true;
         bReturn = true;
         member->channelNumber = channelNumber;
+        InvalidateMemberIndexes();
       }
       break;
     }
@@ -228,15 +231,23 @@ bool CPVRChannelGroup::SortAndRenumber()
 void CPVRChannelGroup::SortByClientChannelNumber()
 {
   CSingleLock lock(m_critSection);
-  if (!PreventSortAndRenumber())
-    sort(m_sortedMembers.begin(), m_sortedMembers.end(), sortByClientChannelNumber());
+  if (!PreventSortAndRenumber() &&
+      !std::is_sorted(m_sortedMembers.begin(), m_sortedMembers.end(), sortByClientChannelNumber()))
+  {
+    std::sort(m_sortedMembers.begin(), m_sortedMembers.end(), sortByClientChannelNumber());
+    InvalidateMemberIndexes();
+  }
 }
 
 void CPVRChannelGroup::SortByChannelNumber()
 {
   CSingleLock lock(m_critSection);
-  if (!PreventSortAndRenumber())
-    sort(m_sortedMembers.begin(), m_sortedMembers.end(), sortByChannelNumber());
+  if (!PreventSortAndRenumber() &&
+      !std::is_sorted(m_sortedMembers.begin(), m_sortedMembers.end(), sortByChannelNumber()))
+  {
+    std::sort(m_sortedMembers.begin(), m_sortedMembers.end(), sortByChannelNumber());
+    InvalidateMemberIndexes();
+  }
 }
 
 bool CPVRChannelGroup::UpdateClientPriorities()
@@ -294,26 +305,16 @@ std::shared_ptr<CPVRChannel> CPVRChannelGroup::GetByChannelID(int iChannelID) co
 {
   CSingleLock lock(m_critSection);
 
-  for (const auto& memberPair : m_members)
-  {
-    if (memberPair.second->channel->ChannelID() == iChannelID)
-      return memberPair.second->channel;
-  }
-
-  return {};
+  const std::shared_ptr<PVRChannelGroupMember> member = m_membersByChannelId.Find(iChannelID, m_sortedMembers);
+  return member ? member->channel : std::shared_ptr<CPVRChannel>();
 }
 
 std::shared_ptr<CPVRChannel> CPVRChannelGroup::GetByChannelEpgID(int iEpgID) const
 {
   CSingleLock lock(m_critSection);
 
-  for (const auto& memberPair : m_members)
-  {
-    if (memberPair.second->channel->EpgID() == iEpgID)
-      return memberPair.second->channel;
-  }
-
-  return {};
+  const std::shared_ptr<PVRChannelGroupMember> member = m_membersByEpgId.Find(iEpgID, m_sortedMembers);
+  return member ? member->channel : std::shared_ptr<CPVRChannel>();
 }
 
 std::shared_ptr<CPVRChannel> CPVRChannelGroup::GetLastPlayedChannel(int iCurrentChannel /* = -1 */) const
@@ -354,14 +355,9 @@ std::shared_ptr<CPVRChannel> CPVRChannelGroup::GetByChannelNumber(const CPVRChan
 {
   CSingleLock lock(m_critSection);
 
-  for (const auto& member : m_sortedMembers)
-  {
-    CPVRChannelNumber activeChannelNumber = m_bUsingBackendChannelNumbers ? member->clientChannelNumber : member->channelNumber;
-    if (activeChannelNumber == channelNumber)
-      return member->channel;
-  }
-
-  return {};
+  CPVRChannelGroupMemberIndex& index = m_bUsingBackendChannelNumbers ? m_membersByClientChannelNumber : m_membersByChannelNumber;
+  const std::shared_ptr<PVRChannelGroupMember> member = index.Find(GetChannelNumberKey(channelNumber), m_sortedMembers);
+  return member ? member->channel : std::shared_ptr<CPVRChannel>();
 }
 
 std::shared_ptr<CPVRChannel> CPVRChannelGroup::GetNextChannel(const std::shared_ptr<CPVRChannel>& channel) const
@@ -419,12 +415,13 @@ std::shared_ptr<CPVRChannel> CPVRChannelGroup::GetPreviousChannel(const std::sha
 
 std::vector<std::shared_ptr<PVRChannelGroupMember>> CPVRChannelGroup::GetMembers(Include eFilter /* = Include::ALL */) const
 {
-  CSingleLock lock(m_critSection);
+  const auto sortedMembers =
+      m_membersSnapshot.Get(m_critSection, [this]() { return m_sortedMembers; });
   if (eFilter == Include::ALL)
-    return m_sortedMembers;
+    return *sortedMembers;
 
   std::vector<std::shared_ptr<PVRChannelGroupMember>> members;
-  for (const auto& member : m_sortedMembers)
+  for (const auto& member : *sortedMembers)
   {
     switch (eFilter)
     {
@@ -466,6 +463,11 @@ int CPVRChannelGroup::LoadFromDb(bool bCompress /* = false */)
 
   database->Get(*this, *m_allChannelsGroup);
 
+  {
+    CSingleLock lock(m_critSection);
+    InvalidateMemberIndexes();
+  }
+
   return Size() - iChannelCount;
 }
 
@@ -513,6 +515,7 @@ bool CPVRChannelGroup::AddAndUpdateChannels(const CPVRChannelGroup& channels, bo
         existingMember->channelNumber = newMember->channelNumber;
         existingMember->clientChannelNumber = newMember->clientChannelNumber;
         existingMember->iOrder = newMember->iOrder;
+        InvalidateMemberIndexes();
         bReturn = true;
       }
 
@@ -601,6 +604,7 @@ std::vector<std::shared_ptr<CPVRChannel>> CPVRChannelGroup::RemoveDeletedChannel
 
       m_members.erase(channel->StorageId());
       it = m_sortedMembers.erase(it);
+      InvalidateMemberIndexes();
       m_bChanged = true;
     }
     else
@@ -617,6 +621,7 @@ bool CPVRChannelGroup::UpdateGroupEntries(const CPVRChannelGroup& channels, std:
   bool bReturn(false);
   bool bChanged(false);
   bool bRemoved(false);
+  const unsigned int iStart = XbmcThreads::SystemClockMillis();
 
   CSingleLock lock(m_critSection);
   /* sort by client channel number if this is the first time or if SETTING_PVRMANAGER_BACKENDCHANNELORDER is true */
@@ -646,6 +651,9 @@ bool CPVRChannelGroup::UpdateGroupEntries(const CPVRChannelGroup& channels, std:
     bReturn = true;
   }
 
+  CLog::LogFC(LOGDEBUG, LOGPVR, "Updated channel group '%s' with %zu channels in %u ms",
+              GroupName().c_str(), m_sortedMembers.size(), XbmcThreads::SystemClockMillis() - iStart);
+
   return bReturn;
 }
 
@@ -661,6 +669,7 @@ bool CPVRChannelGroup::RemoveFromGroup(const std::shared_ptr<CPVRChannel>& chann
       //! @todo notify observers
       m_members.erase((*it)->channel->StorageId());
       it = m_sortedMembers.erase(it);
+      InvalidateMemberIndexes();
       bReturn = true;
       m_bChanged = true;
       break;
@@ -702,6 +711,7 @@ bool CPVRChannelGroup::AddToGroup(const std::shared_ptr<CPVRChannel>& channel, c
       auto newMember = std::make_shared<PVRChannelGroupMember>(realMember->channel, CPVRChannelNumber(iChannelNumber, channelNumber.GetSubChannelNumber()), realMember->iClientPriority, iOrder, clientChannelNumberToUse);
       m_sortedMembers.emplace_back(newMember);
       m_members.insert(std::make_pair(realMember->channel->StorageId(), newMember));
+      InvalidateMemberIndexes();
       m_bChanged = true;
 
       SortAndRenumber();
@@ -723,14 +733,7 @@ bool CPVRChannelGroup::IsGroupMember(const std::shared_ptr<CPVRChannel>& channel
 bool CPVRChannelGroup::IsGroupMember(int iChannelId) const
 {
   CSingleLock lock(m_critSection);
-
-  for (const auto& memberPair : m_members)
-  {
-    if (iChannelId == memberPair.second->channel->ChannelID())
-      return true;
-  }
-
-  return false;
+  return m_membersByChannelId.Find(iChannelId, m_sortedMembers) != nullptr;
 }
 
 bool CPVRChannelGroup::Persist()
@@ -812,10 +815,7 @@ bool CPVRChannelGroup::Renumber(RenumberMode mode /* = NORMAL */)
       m_bChanged = true;
       sortedMember->channelNumber = currentChannelNumber;
       sortedMember->clientChannelNumber = currentClientChannelNumber;
-
-      auto& unsortedMember = GetByUniqueID(sortedMember->channel->StorageId());
-      unsortedMember->channelNumber = sortedMember->channelNumber;
-      unsortedMember->clientChannelNumber = sortedMember->clientChannelNumber;
+      InvalidateMemberIndexes();
     }
   }
 
@@ -1141,3 +1141,27 @@ void CPVRChannelGroup::SetPosition(int iPosition)
     m_bChanged = true;
   }
 }
+
+void CPVRChannelGroup::InvalidateMemberIndexes()
+{
+  m_membersByChannelId.Invalidate();
+  m_membersByEpgId.Invalidate();
+  m_membersByChannelNumber.Invalidate();
+  m_membersByClientChannelNumber.Invalidate();
+  m_membersSnapshot.Invalidate();
+}
+
+int64_t CPVRChannelGroup::GetChannelIdKey(const PVRChannelGroupMember& member)
+{
+  return member.channel->ChannelID();
+}
+
+int64_t CPVRChannelGroup::GetEpgIdKey(const PVRChannelGroupMember& member)
+{
+  return member.channel->EpgID();
+}
+
+int64_t CPVRChannelGroup::GetChannelNumberKey(const CPVRChannelNumber& channelNumber)
+{
+  return (static_cast<int64_t>(channelNumber.GetChannelNumber()) << 32) | channelNumber.GetSubChannelNumber();
+}
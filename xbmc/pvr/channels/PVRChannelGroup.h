@@ -9,6 +9,8 @@
 #pragma once
 
 #include "XBDateTime.h"
+#include "pvr/PVRItemsSnapshot.h"
+#include "pvr/channels/PVRChannelGroupMemberIndex.h"
 #include "pvr/channels/PVRChannelNumber.h"
 #include "pvr/channels/PVRChannelsPath.h"
 #include "settings/lib/ISettingCallback.h"
@@ -479,6 +481,11 @@ namespace PVR
     bool UpdateChannelNumbersFromAllChannelsGroup();
 
   protected:
+    /*!
+     * @brief Rebuild the member indexes and the members snapshot on next use. Must be called with the lock held when adding or removing members or changing their channel numbers or order.
+     */
+    void InvalidateMemberIndexes();
+
     /*!
      * @brief Init class
      */
@@ -556,6 +563,7 @@ namespace PVR
     int m_iPosition = 0; /*!< the position of this group within the group list */
     std::vector<std::shared_ptr<PVRChannelGroupMember>> m_sortedMembers; /*!< members sorted by channel number */
     std::map<std::pair<int, int>, std::shared_ptr<PVRChannelGroupMember>> m_members; /*!< members with key clientid+uniqueid */
+    mutable CPVRItemsSnapshot<PVRChannelGroupMember> m_membersSnapshot{"Channel group members"}; /*!< copy of m_sortedMembers, must be invalidated whenever m_sortedMembers changes */
     mutable CCriticalSection m_critSection;
     std::vector<int> m_failedClientsForChannels;
     std::vector<int> m_failedClientsForChannelGroupMembers;
@@ -567,6 +575,17 @@ namespace PVR
   private:
     CDateTime GetEPGDate(EpgDateType epgDateType) const;
 
+    static int64_t GetChannelIdKey(const PVRChannelGroupMember& member);
+    static int64_t GetEpgIdKey(const PVRChannelGroupMember& member);
+    static int64_t GetChannelNumberKey(const CPVRChannelNumber& channelNumber);
+
+    mutable CPVRChannelGroupMemberIndex m_membersByChannelId{GetChannelIdKey};
+    mutable CPVRChannelGroupMemberIndex m_membersByEpgId{GetEpgIdKey};
+    mutable CPVRChannelGroupMemberIndex m_membersByChannelNumber{
+        [](const PVRChannelGroupMember& member) { return GetChannelNumberKey(member.channelNumber); }};
+    mutable CPVRChannelGroupMemberIndex m_membersByClientChannelNumber{
+        [](const PVRChannelGroupMember& member) { return GetChannelNumberKey(member.clientChannelNumber); }};
+
     std::shared_ptr<CPVRChannelGroup> m_allChannelsGroup;
     CPVRChannelsPath m_path;
   };
@@ -98,6 +98,7 @@ std::shared_ptr<CPVRChannel> CPVRChannelGroupInternal::UpdateFromClient(const st
     auto newMember = std::make_shared<PVRChannelGroupMember>(channel, CPVRChannelNumber(iChannelNumber, channelNumber.GetSubChannelNumber()), 0, iOrder, clientChannelNumber);
     m_sortedMembers.emplace_back(newMember);
     m_members.insert(std::make_pair(channel->StorageId(), newMember));
+    InvalidateMemberIndexes();
     m_bChanged = true;
 
     SortAndRenumber();
@@ -143,6 +144,7 @@ bool CPVRChannelGroupInternal::AddToGroup(const std::shared_ptr<CPVRChannel>& ch
   if (groupMember->channelNumber.GetChannelNumber() != iChannelNumber)
   {
     groupMember->channelNumber = CPVRChannelNumber(iChannelNumber, channelNumber.GetSubChannelNumber());
+    InvalidateMemberIndexes();
     bSort = true;
   }
 
@@ -204,6 +206,11 @@ int CPVRChannelGroupInternal::LoadFromDb(bool bCompress /* = false */)
   if (database->Get(*this, bCompress) == 0)
     CLog::LogFC(LOGDEBUG, LOGPVR, "No channels in the database");
 
+  {
+    CSingleLock lock(m_critSection);
+    InvalidateMemberIndexes();
+  }
+
   SortByChannelNumber();
 
   return Size() - iChannelCount;
@@ -248,6 +255,7 @@ bool CPVRChannelGroupInternal::AddAndUpdateChannels(const CPVRChannelGroup& chan
           existingMember->channelNumber = newMember->channelNumber;
         existingMember->clientChannelNumber = newMember->clientChannelNumber;
         existingMember->iOrder = newMember->iOrder;
+        InvalidateMemberIndexes();
         bReturn = true;
       }
     }
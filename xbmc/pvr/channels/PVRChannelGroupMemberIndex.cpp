@@ -0,0 +1,45 @@
+/*
+ *  Copyright (C) 2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "PVRChannelGroupMemberIndex.h"
+
+#include "pvr/channels/PVRChannelGroup.h"
+
+using namespace PVR;
+
+std::atomic<unsigned int> CPVRChannelGroupMemberIndex::s_iGeneration{0};
+
+CPVRChannelGroupMemberIndex::CPVRChannelGroupMemberIndex(const KeyFunction& getKey)
+  : m_getKey(getKey)
+{
+}
+
+std::shared_ptr<PVRChannelGroupMember> CPVRChannelGroupMemberIndex::Find(
+    int64_t key, const std::vector<std::shared_ptr<PVRChannelGroupMember>>& members)
+{
+  if (!m_bValid || m_iGeneration != s_iGeneration)
+    Rebuild(members);
+
+  const auto it = m_index.find(key);
+  return it != m_index.end() ? it->second : std::shared_ptr<PVRChannelGroupMember>();
+}
+
+void CPVRChannelGroupMemberIndex::Rebuild(
+    const std::vector<std::shared_ptr<PVRChannelGroupMember>>& members)
+{
+  // take the generation first, a concurrent InvalidateAll() then triggers another rebuild
+  m_iGeneration = s_iGeneration;
+  m_index.clear();
+  m_index.reserve(members.size());
+
+  // emplace keeps the first member of several with the same key
+  for (const auto& member : members)
+    m_index.emplace(m_getKey(*member), member);
+
+  m_bValid = true;
+}
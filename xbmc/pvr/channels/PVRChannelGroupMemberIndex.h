@@ -0,0 +1,71 @@
+/*
+ *  Copyright (C) 2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace PVR
+{
+  struct PVRChannelGroupMember;
+
+  /*!
+   * @brief Hash index of the members of a channel group by some key, e.g. channel id or number.
+   *
+   * The index is trusted as long as it is valid, so it must be invalidated whenever members are
+   * added, removed or get a different key. Keys stored in the members (channel numbers) are
+   * changed by the group, which calls Invalidate(). Keys stored in the channels (channel id,
+   * EPG id) are shared by all groups and changed by the channel, which calls InvalidateAll().
+   */
+  class CPVRChannelGroupMemberIndex
+  {
+  public:
+    using KeyFunction = std::function<int64_t(const PVRChannelGroupMember& member)>;
+
+    /*!
+     * @brief Create a new index.
+     * @param getKey Function returning the key of a member.
+     */
+    explicit CPVRChannelGroupMemberIndex(const KeyFunction& getKey);
+
+    /*!
+     * @brief Mark the index for rebuild on next use.
+     */
+    void Invalidate() { m_bValid = false; }
+
+    /*!
+     * @brief Mark all indexes for rebuild on next use.
+     */
+    static void InvalidateAll() { ++s_iGeneration; }
+
+    /*!
+     * @brief Find the member with the given key. If several members share a key, the first one
+     * in the given member list is returned.
+     * @param key The key.
+     * @param members All members of the group.
+     * @return The member or nullptr if not found.
+     */
+    std::shared_ptr<PVRChannelGroupMember> Find(
+        int64_t key, const std::vector<std::shared_ptr<PVRChannelGroupMember>>& members);
+
+  private:
+    void Rebuild(const std::vector<std::shared_ptr<PVRChannelGroupMember>>& members);
+
+    static std::atomic<unsigned int> s_iGeneration;
+
+    const KeyFunction m_getKey;
+    bool m_bValid = false;
+    unsigned int m_iGeneration = 0;
+    std::unordered_map<int64_t, std::shared_ptr<PVRChannelGroupMember>> m_index;
+  };
+}
@@ -0,0 +1,148 @@
+/*
+ *  Copyright (C) 2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "pvr/channels/PVRChannelGroup.h"
+#include "pvr/channels/PVRChannelGroupMemberIndex.h"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <stdio.h>
+
+#include <gtest/gtest.h>
+
+using namespace PVR;
+
+namespace
+{
+int64_t GetNumber(const PVRChannelGroupMember& member)
+{
+  return member.channelNumber.GetChannelNumber();
+}
+
+std::vector<std::shared_ptr<PVRChannelGroupMember>> CreateMembers(unsigned int iCount)
+{
+  std::vector<std::shared_ptr<PVRChannelGroupMember>> members;
+  for (unsigned int i = 1; i <= iCount; ++i)
+    members.emplace_back(std::make_shared<PVRChannelGroupMember>(
+        nullptr, CPVRChannelNumber(i, 0), 0, 0, CPVRChannelNumber()));
+  return members;
+}
+} // unnamed namespace
+
+TEST(TestPVRChannelGroupMemberIndex, Find)
+{
+  const auto members = CreateMembers(5000);
+  CPVRChannelGroupMemberIndex index(GetNumber);
+
+  for (const auto& member : members)
+    EXPECT_EQ(member, index.Find(GetNumber(*member), members));
+  EXPECT_EQ(nullptr, index.Find(0, members));
+  EXPECT_EQ(nullptr, index.Find(5001, members));
+}
+
+TEST(TestPVRChannelGroupMemberIndex, FindFirstOfDuplicates)
+{
+  auto members = CreateMembers(3);
+  members[2]->channelNumber = CPVRChannelNumber(2, 0);
+  CPVRChannelGroupMemberIndex index(GetNumber);
+
+  EXPECT_EQ(members[1], index.Find(2, members));
+}
+
+TEST(TestPVRChannelGroupMemberIndex, TrustsValidIndex)
+{
+  auto members = CreateMembers(3);
+  CPVRChannelGroupMemberIndex index(GetNumber);
+  ASSERT_EQ(nullptr, index.Find(4, members));
+
+  // a miss is not looked up in the members as long as the index wasn't invalidated
+  members.emplace_back(std::make_shared<PVRChannelGroupMember>(
+      nullptr, CPVRChannelNumber(4, 0), 0, 0, CPVRChannelNumber()));
+  EXPECT_EQ(nullptr, index.Find(4, members));
+
+  index.Invalidate();
+  EXPECT_EQ(members[3], index.Find(4, members));
+}
+
+TEST(TestPVRChannelGroupMemberIndex, Invalidate)
+{
+  auto members = CreateMembers(3);
+  CPVRChannelGroupMemberIndex index(GetNumber);
+  ASSERT_EQ(members[1], index.Find(2, members));
+
+  members.erase(members.begin() + 1);
+  index.Invalidate();
+  EXPECT_EQ(nullptr, index.Find(2, members));
+  EXPECT_EQ(members[1], index.Find(3, members));
+
+  members[0]->channelNumber = CPVRChannelNumber(10, 0);
+  index.Invalidate();
+  EXPECT_EQ(nullptr, index.Find(1, members));
+  EXPECT_EQ(members[0], index.Find(10, members));
+}
+
+TEST(TestPVRChannelGroupMemberIndex, InvalidateAll)
+{
+  const auto members = CreateMembers(3);
+  CPVRChannelGroupMemberIndex index1(GetNumber);
+  CPVRChannelGroupMemberIndex index2(GetNumber);
+  ASSERT_EQ(members[0], index1.Find(1, members));
+  ASSERT_EQ(members[0], index2.Find(1, members));
+
+  // keys stored in channels change for all groups at once
+  members[0]->channelNumber = CPVRChannelNumber(10, 0);
+  CPVRChannelGroupMemberIndex::InvalidateAll();
+  EXPECT_EQ(members[0], index1.Find(10, members));
+  EXPECT_EQ(members[0], index2.Find(10, members));
+  EXPECT_EQ(nullptr, index2.Find(1, members));
+}
+
+// Lookups as done while zapping through or rendering the guide of a large channel list, with the
+// index and with a scan of the members. Run with --gtest_also_run_disabled_tests.
+TEST(TestPVRChannelGroupMemberIndex, DISABLED_LookupBenchmark)
+{
+  const auto members = CreateMembers(5000);
+  std::vector<int64_t> keys;
+  for (const auto& member : members)
+    keys.emplace_back(GetNumber(*member));
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(5000));
+
+  constexpr int ROUNDS = 10;
+  CPVRChannelGroupMemberIndex index(GetNumber);
+  size_t found = 0;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < ROUNDS; ++i)
+  {
+    for (const int64_t key : keys)
+      found += index.Find(key, members) != nullptr;
+  }
+  const auto indexTime = std::chrono::steady_clock::now() - start;
+
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < ROUNDS; ++i)
+  {
+    for (const int64_t key : keys)
+    {
+      found += std::find_if(members.begin(), members.end(),
+                            [key](const std::shared_ptr<PVRChannelGroupMember>& member) {
+                              return GetNumber(*member) == key;
+                            }) != members.end();
+    }
+  }
+  const auto scanTime = std::chrono::steady_clock::now() - start;
+
+  EXPECT_EQ(2 * ROUNDS * members.size(), found);
+  printf("%zu lookups in %zu members: index %lld us, scan %lld us\n", keys.size() * ROUNDS,
+         members.size(),
+         static_cast<long long>(
+             std::chrono::duration_cast<std::chrono::microseconds>(indexTime).count()),
+         static_cast<long long>(
+             std::chrono::duration_cast<std::chrono::microseconds>(scanTime).count()));
+}
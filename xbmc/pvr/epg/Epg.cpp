@@ -15,10 +15,12 @@
 #include "pvr/epg/EpgChannelData.h"
 #include "pvr/epg/EpgDatabase.h"
 #include "pvr/epg/EpgInfoTag.h"
+#include "pvr/epg/EpgSearchIndex.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
 #include "utils/log.h"
 
 #include <memory>
@@ -72,6 +74,7 @@ void CPVREpg::Clear()
 {
   CSingleLock lock(m_critSection);
   m_tags.clear();
+  m_searchIndex.reset();
 }
 
 void CPVREpg::Cleanup(int iPastDays)
@@ -90,6 +93,9 @@ void CPVREpg::Cleanup(const CDateTime& time)
       if (m_nowActiveStart == it->first)
         m_nowActiveStart.SetValid(false);
 
+      if (m_searchIndex)
+        m_searchIndex->Remove(it->second);
+
       it = m_tags.erase(it);
     }
     else
@@ -375,6 +381,9 @@ void CPVREpg::AddEntry(const CPVREpgInfoTag& tag)
   newTag->Update(tag);
   newTag->SetChannelData(m_channelData);
   newTag->SetEpgID(m_iEpgID);
+
+  if (m_searchIndex)
+    m_searchIndex->Add(newTag);
 }
 
 bool CPVREpg::Load(const std::shared_ptr<CPVREpgDatabase>& database)
@@ -420,16 +429,25 @@ bool CPVREpg::UpdateEntries(const CPVREpg& epg, bool bStoreInDb /* = true */)
 {
   CSingleLock lock(m_critSection);
   /* copy over tags */
+  size_t iChangedTags = 0;
   for (const auto& tag : epg.m_tags)
-    UpdateEntry(tag.second, bStoreInDb);
+  {
+    if (UpdateEntry(tag.second, bStoreInDb))
+      ++iChangedTags;
+  }
 
-  FixOverlappingEvents(bStoreInDb);
+  const bool bFixedTags = FixOverlappingEvents(bStoreInDb);
 
   /* update the last scan time of this table */
   m_lastScanTime = CDateTime::GetUTCDateTime();
   m_bUpdateLastScanTime = true;
 
-  m_events.Publish(PVREvent::Epg);
+  CLog::LogFC(LOGDEBUG, LOGEPG, "Updated table '%s': %zu of %zu tags new or changed",
+              m_strName.c_str(), iChangedTags, epg.m_tags.size());
+
+  if (iChangedTags > 0 || bFixedTags)
+    m_events.Publish(PVREvent::Epg);
+
   return true;
 }
 
@@ -452,6 +470,10 @@ bool CPVREpg::UpdateEntry(const std::shared_ptr<CPVREpgInfoTag>& tag, bool bUpda
   if (it != m_tags.end())
   {
     infoTag = it->second;
+
+    // clients resend all events on every update, most of them unchanged
+    if (tag->ContentHash() != 0 && tag->ContentHash() == infoTag->ContentHash())
+      return false;
   }
   else
   {
@@ -465,6 +487,9 @@ bool CPVREpg::UpdateEntry(const std::shared_ptr<CPVREpgInfoTag>& tag, bool bUpda
   infoTag->SetChannelData(m_channelData);
   infoTag->SetEpgID(m_iEpgID);
 
+  if (m_searchIndex)
+    m_searchIndex->Add(infoTag);
+
   if (bUpdateDatabase)
     m_changedTags.insert(std::make_pair(infoTag->UniqueBroadcastID(), infoTag));
 
@@ -478,7 +503,7 @@ bool CPVREpg::UpdateEntry(const std::shared_ptr<CPVREpgInfoTag>& tag, EPG_EVENT_
 
   if (newState == EPG_EVENT_CREATED || newState == EPG_EVENT_UPDATED)
   {
-    bRet = UpdateEntry(tag, bUpdateDatabase);
+    bNotify = UpdateEntry(tag, bUpdateDatabase);
   }
   else if (newState == EPG_EVENT_DELETED)
   {
@@ -504,6 +529,9 @@ bool CPVREpg::UpdateEntry(const std::shared_ptr<CPVREpgInfoTag>& tag, EPG_EVENT_
         if (bUpdateDatabase)
           m_deletedTags.insert(std::make_pair(it->second->UniqueBroadcastID(), it->second));
 
+        if (m_searchIndex)
+          m_searchIndex->Remove(it->second);
+
         m_tags.erase(it);
       }
       else
@@ -583,6 +611,30 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpg::GetTags() const
   return tags;
 }
 
+std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpg::GetSearchCandidates(const CTextSearch& search) const
+{
+  std::vector<std::shared_ptr<CPVREpgInfoTag>> tags;
+
+  CSingleLock lock(m_critSection);
+
+  // built on first use, most EPGs (e.g. the temporary ones used for updates) never get searched
+  if (!m_searchIndex)
+  {
+    m_searchIndex.reset(new CPVREpgSearchIndex);
+    for (const auto& tag : m_tags)
+      m_searchIndex->Add(tag.second);
+  }
+
+  if (!m_searchIndex->GetCandidates(search, tags))
+  {
+    tags.clear();
+    for (const auto& tag : m_tags)
+      tags.emplace_back(tag.second);
+  }
+
+  return tags;
+}
+
 bool CPVREpg::Persist(const std::shared_ptr<CPVREpgDatabase>& database)
 {
   if (!database)
@@ -591,6 +643,10 @@ bool CPVREpg::Persist(const std::shared_ptr<CPVREpgDatabase>& database)
     return false;
   }
 
+  const unsigned int iStart = XbmcThreads::SystemClockMillis();
+  size_t iWrittenTags = 0;
+  size_t iDeletedTags = 0;
+
   database->Lock();
 
   {
@@ -621,6 +677,8 @@ bool CPVREpg::Persist(const std::shared_ptr<CPVREpgDatabase>& database)
         tag.second->SetEpgID(m_iEpgID);
     }
 
+    iWrittenTags = m_changedTags.size();
+    iDeletedTags = m_deletedTags.size();
     m_deletedTags.clear();
     m_changedTags.clear();
     m_bChanged = false;
@@ -631,6 +689,12 @@ bool CPVREpg::Persist(const std::shared_ptr<CPVREpgDatabase>& database)
   bool bRet = database->CommitInsertQueries();
 
   database->Unlock();
+
+  if (iWrittenTags > 0 || iDeletedTags > 0)
+    CLog::LogFC(LOGDEBUG, LOGEPG, "Persisted table '%s': %zu tags written, %zu deleted in %u ms",
+                m_strName.c_str(), iWrittenTags, iDeletedTags,
+                XbmcThreads::SystemClockMillis() - iStart);
+
   return bRet;
 }
 
@@ -658,7 +722,7 @@ CDateTime CPVREpg::GetLastDate() const
 
 bool CPVREpg::FixOverlappingEvents(bool bUpdateDb /* = false */)
 {
-  bool bReturn = true;
+  bool bReturn = false;
   std::shared_ptr<CPVREpgInfoTag> previousTag, currentTag;
 
   for (auto it = m_tags.begin(); it != m_tags.end(); it != m_tags.end() ? it++ : it)
@@ -679,11 +743,16 @@ bool CPVREpg::FixOverlappingEvents(bool bUpdateDb /* = false */)
       if (m_nowActiveStart == it->first)
         m_nowActiveStart.SetValid(false);
 
+      if (m_searchIndex)
+        m_searchIndex->Remove(currentTag);
+
       m_tags.erase(it++);
+      bReturn = true;
     }
     else if (previousTag->EndAsUTC() > currentTag->StartAsUTC())
     {
       previousTag->SetEndFromUTC(currentTag->StartAsUTC());
+      bReturn = true;
       if (bUpdateDb)
         m_changedTags.insert(std::make_pair(previousTag->UniqueBroadcastID(), previousTag));
 
@@ -18,6 +18,8 @@
 #include <string>
 #include <vector>
 
+class CTextSearch;
+
 namespace PVR
 {
   enum class PVREvent;
@@ -25,6 +27,7 @@ namespace PVR
   class CPVREpgChannelData;
   class CPVREpgDatabase;
   class CPVREpgInfoTag;
+  class CPVREpgSearchIndex;
 
   class CPVREpg
   {
@@ -162,7 +165,7 @@ namespace PVR
      * @brief Update an entry in this EPG.
      * @param data The tag to update.
      * @param iClientId The id of the pvr client this event belongs to.
-     * @return True if it was updated successfully, false otherwise.
+     * @return True if the tag was created or changed, false if it is unchanged.
      */
     bool UpdateEntry(const EPG_TAG* data, int iClientId);
 
@@ -170,7 +173,7 @@ namespace PVR
      * @brief Update an entry in this EPG.
      * @param tag The tag to update.
      * @param bUpdateDatabase If set to true, this event will be persisted in the database.
-     * @return True if it was updated successfully, false otherwise.
+     * @return True if the tag was created or changed, false if it is unchanged.
      */
     bool UpdateEntry(const std::shared_ptr<CPVREpgInfoTag>& tag, bool bUpdateDatabase);
 
@@ -201,6 +204,13 @@ namespace PVR
      */
     std::vector<std::shared_ptr<CPVREpgInfoTag>> GetTags() const;
 
+    /*!
+     * @brief Get the EPG tags that may match the given search, using the search index of this EPG.
+     * @param search The search.
+     * @return The tags to check with the search, all tags if the index can't narrow it down.
+     */
+    std::vector<std::shared_ptr<CPVREpgInfoTag>> GetSearchCandidates(const CTextSearch& search) const;
+
     /*!
      * @brief Get all EPG tags for the given time frame, including "gap" tags.
      * @param timelineStart Start of time line
@@ -327,6 +337,7 @@ namespace PVR
     std::map<CDateTime, std::shared_ptr<CPVREpgInfoTag>> m_tags;
     std::map<int, std::shared_ptr<CPVREpgInfoTag>> m_changedTags;
     std::map<int, std::shared_ptr<CPVREpgInfoTag>> m_deletedTags;
+    mutable std::unique_ptr<CPVREpgSearchIndex> m_searchIndex; /*!< search index of m_tags, created on first search */
     bool m_bChanged = false; /*!< true if anything changed that needs to be persisted, false otherwise */
     bool m_bTagsChanged = false; /*!< true when any tags are changed and not persisted, false otherwise */
     bool m_bLoaded = false; /*!< true when the initial entries have been loaded */
@@ -16,11 +16,16 @@
 #include "pvr/epg/EpgContainer.h"
 #include "pvr/epg/EpgDatabase.h"
 #include "pvr/epg/EpgInfoTag.h"
+#include "pvr/epg/EpgSearchFilter.h"
+#include "pvr/epg/EpgStringPool.h"
+#include "pvr/epg/EpgUpdateScheduler.h"
 #include "pvr/guilib/PVRGUIProgressHandler.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "utils/TextSearch.h"
 #include "utils/log.h"
 
 #include <memory>
@@ -286,6 +291,8 @@ void CPVREpgContainer::LoadFromDB()
 
   progressHandler->DestroyProgress();
 
+  CPVREpgStringPool::GetInstance().LogStatistics();
+
   m_bLoaded = bLoaded;
 }
 
@@ -300,12 +307,21 @@ bool CPVREpgContainer::PersistAll()
     m_critSection.unlock();
 
     const std::shared_ptr<CPVREpgDatabase> database = GetEpgDatabase();
+    const unsigned int iStart = XbmcThreads::SystemClockMillis();
+    size_t iPersistedTables = 0;
 
     for (const auto& epg : epgs)
     {
       if (epg.second && epg.second->NeedsSave())
+      {
         bReturn &= epg.second->Persist(database);
+        ++iPersistedTables;
+      }
     }
+
+    if (iPersistedTables > 0)
+      CLog::LogFC(LOGDEBUG, LOGEPG, "Persisted %zu of %zu tables in %u ms", iPersistedTables,
+                  epgs.size(), XbmcThreads::SystemClockMillis() - iStart);
   }
 
   return bReturn;
@@ -505,6 +521,37 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgContainer::GetAllTags() cons
   return allTags;
 }
 
+std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgContainer::GetTags(const CPVREpgSearchFilter& filter) const
+{
+  const unsigned int iStart = XbmcThreads::SystemClockMillis();
+  const std::shared_ptr<CTextSearch> search = filter.GetTextSearch();
+
+  std::vector<std::shared_ptr<CPVREpgInfoTag>> candidates;
+  {
+    CSingleLock lock(m_critSection);
+    for (const auto& epgEntry : m_epgIdToEpgMap)
+    {
+      const std::vector<std::shared_ptr<CPVREpgInfoTag>> epgTags = search ? epgEntry.second->GetSearchCandidates(*search)
+                                                                          : epgEntry.second->GetTags();
+      candidates.insert(candidates.end(), epgTags.begin(), epgTags.end());
+    }
+  }
+
+  // filter outside of the lock, it involves timers, recordings and channel groups
+  std::vector<std::shared_ptr<CPVREpgInfoTag>> results;
+  for (const auto& tag : candidates)
+  {
+    if (filter.FilterEntry(tag))
+      results.emplace_back(tag);
+  }
+
+  CLog::LogFC(LOGDEBUG, LOGEPG, "Search for '%s' checked %zu candidates, found %zu tags in %u ms",
+              filter.GetSearchTerm().c_str(), candidates.size(), results.size(),
+              XbmcThreads::SystemClockMillis() - iStart);
+
+  return results;
+}
+
 void CPVREpgContainer::InsertFromDB(const std::shared_ptr<CPVREpg>& newEpg)
 {
   // table might already have been created when pvr channels were loaded
@@ -665,35 +712,37 @@ bool CPVREpgContainer::UpdateEPG(bool bOnlyPending /* = false */)
   /* load or update all EPG tables */
   unsigned int iCounter = 0;
   const std::shared_ptr<CPVREpgDatabase> database = UseDatabase() ? GetEpgDatabase() : nullptr;
+  const int iUpdateTime = m_settings.GetIntValue(CSettings::SETTING_EPG_EPGUPDATE) * 60;
+  const int iPastDays = m_settings.GetIntValue(CSettings::SETTING_EPG_PAST_DAYSTODISPLAY);
+
+  CPVREpgUpdateScheduler scheduler(advancedSettings->m_iEpgMaxConcurrentRequestsPerClient);
   for (const auto& epgEntry : m_epgIdToEpgMap)
   {
-    if (InterruptUpdate())
-    {
-      bInterrupted = true;
-      break;
-    }
-
     const std::shared_ptr<CPVREpg> epg = epgEntry.second;
     if (!epg)
       continue;
 
-    if (bShowProgress && !bOnlyPending)
-      progressHandler->UpdateProgress(epg->Name(), ++iCounter, m_epgIdToEpgMap.size());
-
-    if ((!bOnlyPending || epg->UpdatePending()) &&
-        epg->Update(start,
-                    end,
-                    m_settings.GetIntValue(CSettings::SETTING_EPG_EPGUPDATE) * 60,
-                    m_settings.GetIntValue(CSettings::SETTING_EPG_PAST_DAYSTODISPLAY),
-                    database,
-                    bOnlyPending))
-    {
-      iUpdatedTables++;
-    }
+    if (!bOnlyPending || epg->UpdatePending())
+      scheduler.Add(epg);
     else if (!epg->IsValid())
-    {
       invalidTables.push_back(epg);
-    }
+  }
+
+  bInterrupted = !scheduler.Run(
+      [start, end, iUpdateTime, iPastDays, &database, bOnlyPending](const std::shared_ptr<CPVREpg>& epg) {
+        return epg->Update(start, end, iUpdateTime, iPastDays, database, bOnlyPending);
+      },
+      [this]() { return InterruptUpdate(); },
+      [progressHandler, &iCounter, this](const std::shared_ptr<CPVREpg>& epg) {
+        if (progressHandler)
+          progressHandler->UpdateProgress(epg->Name(), ++iCounter, m_epgIdToEpgMap.size());
+      });
+
+  iUpdatedTables = scheduler.GetUpdated().size();
+  for (const auto& epg : scheduler.GetFailed())
+  {
+    if (!epg->IsValid())
+      invalidTables.push_back(epg);
   }
 
   if (bShowProgress && !bOnlyPending)
@@ -720,7 +769,10 @@ bool CPVREpgContainer::UpdateEPG(bool bOnlyPending /* = false */)
 
   /* notify observers */
   if (iUpdatedTables > 0)
+  {
+    CPVREpgStringPool::GetInstance().LogStatistics();
     m_events.Publish(PVREvent::EpgContainer);
+  }
 
   CSingleLock lock(m_critSection);
   m_bIsUpdating = false;
@@ -31,6 +31,7 @@ namespace PVR
   class CPVREpgChannelData;
   class CPVREpgDatabase;
   class CPVREpgInfoTag;
+  class CPVREpgSearchFilter;
 
   enum class PVREvent;
 
@@ -152,6 +153,13 @@ namespace PVR
      */
     std::vector<std::shared_ptr<CPVREpgInfoTag>> GetAllTags() const;
 
+    /*!
+     * @brief Get all EPG tags matching the given filter.
+     * @param filter The filter.
+     * @return The matching tags.
+     */
+    std::vector<std::shared_ptr<CPVREpgInfoTag>> GetTags(const CPVREpgSearchFilter& filter) const;
+
     /*!
      * @brief Check whether data should be persisted to the EPG database.
      * @return True if data should be persisted to the EPG database, false otherwise.
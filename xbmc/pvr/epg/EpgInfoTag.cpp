@@ -26,10 +26,51 @@
 
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 using namespace PVR;
 
+namespace
+{
+/*!
+ * @brief 64 bit FNV-1a hash. Unlike std::hash, the result is the same on every platform and every
+ * run, which it has to be, as the hash is stored in the database.
+ */
+class CContentHash
+{
+public:
+  void Add(const std::string& value)
+  {
+    // the length keeps adjacent strings from running into each other
+    Add(value.size());
+    for (const char c : value)
+      AddByte(static_cast<uint8_t>(c));
+  }
+
+  template<typename T>
+  void Add(T value)
+  {
+    static_assert(std::is_integral<T>::value, "integral type expected");
+    // always 8 bytes, so the result doesn't depend on the size of the type on this platform
+    const uint64_t bits = static_cast<uint64_t>(value);
+    for (int i = 0; i < 8; ++i)
+      AddByte(static_cast<uint8_t>(bits >> (i * 8)));
+  }
+
+  uint64_t Get() const { return m_hash; }
+
+private:
+  void AddByte(uint8_t byte)
+  {
+    m_hash ^= byte;
+    m_hash *= 0x100000001b3ULL;
+  }
+
+  uint64_t m_hash = 0xcbf29ce484222325ULL;
+};
+} // unnamed namespace
+
 CPVREpgInfoTag::CPVREpgInfoTag()
 : m_iUniqueBroadcastID(EPG_TAG_INVALID_UID),
   m_iFlags(EPG_TAG_FLAG_UNDEFINED),
@@ -56,6 +97,7 @@ CPVREpgInfoTag::CPVREpgInfoTag(const std::shared_ptr<CPVREpgChannelData>& channe
       0, 0, 0, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_iPVRTimeCorrection);
   m_startTime = start + correction;
   m_endTime = end + correction;
+  m_iContentHash = CalculateContentHash();
 
   UpdatePath();
 }
@@ -120,6 +162,8 @@ CPVREpgInfoTag::CPVREpgInfoTag(const EPG_TAG& data, int iClientId, const std::sh
   if (data.strSeriesLink)
     m_strSeriesLink = data.strSeriesLink;
 
+  m_iContentHash = CalculateContentHash();
+
   UpdatePath();
 }
 
@@ -184,16 +228,16 @@ void CPVREpgInfoTag::Serialize(CVariant& value) const
   value["channeluid"] = m_channelData->UniqueClientChannelId();
   value["parentalrating"] = m_iParentalRating;
   value["rating"] = m_iStarRating;
-  value["title"] = m_strTitle;
-  value["plotoutline"] = m_strPlotOutline;
-  value["plot"] = m_strPlot;
-  value["originaltitle"] = m_strOriginalTitle;
-  value["cast"] = DeTokenize(m_cast);
-  value["director"] = DeTokenize(m_directors);
-  value["writer"] = DeTokenize(m_writers);
+  value["title"] = m_strTitle.Get();
+  value["plotoutline"] = m_strPlotOutline.Get();
+  value["plot"] = m_strPlot.Get();
+  value["originaltitle"] = m_strOriginalTitle.Get();
+  value["cast"] = DeTokenize(m_cast.Get());
+  value["director"] = DeTokenize(m_directors.Get());
+  value["writer"] = DeTokenize(m_writers.Get());
   value["year"] = m_iYear;
-  value["imdbnumber"] = m_strIMDBNumber;
-  value["genre"] = m_genre;
+  value["imdbnumber"] = m_strIMDBNumber.Get();
+  value["genre"] = m_genre.Get();
   value["filenameandpath"] = m_strFileNameAndPath;
   value["starttime"] = m_startTime.IsValid() ? m_startTime.GetAsDBDateTime() : StringUtils::Empty;
   value["endtime"] = m_endTime.IsValid() ? m_endTime.GetAsDBDateTime() : StringUtils::Empty;
@@ -201,7 +245,7 @@ void CPVREpgInfoTag::Serialize(CVariant& value) const
   value["firstaired"] = m_firstAired.IsValid() ? m_firstAired.GetAsDBDate() : StringUtils::Empty;
   value["progress"] = Progress();
   value["progresspercentage"] = ProgressPercentage();
-  value["episodename"] = m_strEpisodeName;
+  value["episodename"] = m_strEpisodeName.Get();
   value["episodenum"] = m_iEpisodeNumber;
   value["episodepart"] = m_iEpisodePart;
   value["hastimer"] = false; // compat
@@ -211,7 +255,7 @@ void CPVREpgInfoTag::Serialize(CVariant& value) const
   value["isactive"] = IsActive();
   value["wasactive"] = WasActive();
   value["isseries"] = IsSeries();
-  value["serieslink"] = m_strSeriesLink;
+  value["serieslink"] = m_strSeriesLink.Get();
 }
 
 int CPVREpgInfoTag::ClientID() const
@@ -299,6 +343,50 @@ int CPVREpgInfoTag::DatabaseID() const
   return m_iDatabaseID;
 }
 
+uint64_t CPVREpgInfoTag::ContentHash() const
+{
+  CSingleLock lock(m_critSection);
+  return m_iContentHash;
+}
+
+uint64_t CPVREpgInfoTag::CalculateContentHash() const
+{
+  CContentHash hash;
+  hash.Add(m_iUniqueBroadcastID);
+  for (const CPVREpgString* value : {&m_strTitle, &m_strPlotOutline, &m_strPlot, &m_strOriginalTitle,
+                                     &m_strIMDBNumber, &m_strEpisodeName, &m_strIconPath,
+                                     &m_strSeriesLink})
+    hash.Add(value->Get());
+  for (const CPVREpgStringList* value : {&m_cast, &m_directors, &m_writers})
+  {
+    hash.Add(value->Get().size());
+    for (const auto& token : value->Get())
+      hash.Add(token);
+  }
+  for (int value : {m_iGenreType, m_iGenreSubType, m_iParentalRating, m_iStarRating,
+                    m_iSeriesNumber, m_iEpisodeNumber, m_iEpisodePart, m_iYear})
+    hash.Add(value);
+  hash.Add(m_iFlags);
+
+  // genre texts derived from type and subtype depend on the language, only hash provided texts
+  if (m_iGenreType == EPG_GENRE_USE_STRING || m_iGenreSubType == EPG_GENRE_USE_STRING)
+  {
+    hash.Add(m_genre.Get().size());
+    for (const auto& token : m_genre.Get())
+      hash.Add(token);
+  }
+
+  for (const CDateTime* value : {&m_startTime, &m_endTime, &m_firstAired})
+  {
+    time_t time = 0;
+    if (value->IsValid())
+      value->GetAsTime(time);
+    hash.Add(static_cast<int64_t>(time));
+  }
+
+  return hash.Get();
+}
+
 int CPVREpgInfoTag::UniqueChannelID() const
 {
   CSingleLock lock(m_critSection);
@@ -344,44 +432,44 @@ int CPVREpgInfoTag::GetDuration() const
 
 std::string CPVREpgInfoTag::Title() const
 {
-  return m_strTitle;
+  return m_strTitle.Get();
 }
 
 std::string CPVREpgInfoTag::PlotOutline() const
 {
-  return m_strPlotOutline;
+  return m_strPlotOutline.Get();
 }
 
 std::string CPVREpgInfoTag::Plot() const
 {
-  return m_strPlot;
+  return m_strPlot.Get();
 }
 
 std::string CPVREpgInfoTag::OriginalTitle() const
 {
-  return m_strOriginalTitle;
+  return m_strOriginalTitle.Get();
 }
 
 const std::vector<std::string> CPVREpgInfoTag::Cast() const
 {
-  return m_cast;
+  return m_cast.Get();
 }
 
 const std::vector<std::string> CPVREpgInfoTag::Directors() const
 {
-  return m_directors;
+  return m_directors.Get();
 }
 
 const std::vector<std::string> CPVREpgInfoTag::Writers() const
 {
-  return m_writers;
+  return m_writers.Get();
 }
 
 const std::string CPVREpgInfoTag::GetCastLabel() const
 {
   // Note: see CVideoInfoTag::GetCast for reference implementation.
   std::string strLabel;
-  for (const auto& castEntry : m_cast)
+  for (const auto& castEntry : m_cast.Get())
     strLabel += StringUtils::Format("%s\n", castEntry.c_str());
 
   return StringUtils::TrimRight(strLabel, "\n");
@@ -389,17 +477,17 @@ const std::string CPVREpgInfoTag::GetCastLabel() const
 
 const std::string CPVREpgInfoTag::GetDirectorsLabel() const
 {
-  return StringUtils::Join(m_directors, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoItemSeparator);
+  return StringUtils::Join(m_directors.Get(), CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoItemSeparator);
 }
 
 const std::string CPVREpgInfoTag::GetWritersLabel() const
 {
-  return StringUtils::Join(m_writers, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoItemSeparator);
+  return StringUtils::Join(m_writers.Get(), CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoItemSeparator);
 }
 
 const std::string CPVREpgInfoTag::GetGenresLabel() const
 {
-  return StringUtils::Join(m_genre, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoItemSeparator);
+  return StringUtils::Join(m_genre.Get(), CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoItemSeparator);
 }
 
 int CPVREpgInfoTag::Year() const
@@ -409,7 +497,7 @@ int CPVREpgInfoTag::Year() const
 
 std::string CPVREpgInfoTag::IMDBNumber() const
 {
-  return m_strIMDBNumber;
+  return m_strIMDBNumber.Get();
 }
 
 void CPVREpgInfoTag::SetGenre(int iGenreType, int iGenreSubType, const char* strGenre)
@@ -444,7 +532,7 @@ int CPVREpgInfoTag::GenreSubType() const
 
 const std::vector<std::string> CPVREpgInfoTag::Genre() const
 {
-  return m_genre;
+  return m_genre.Get();
 }
 
 CDateTime CPVREpgInfoTag::FirstAiredAsUTC() const
@@ -476,7 +564,7 @@ int CPVREpgInfoTag::SeriesNumber() const
 
 std::string CPVREpgInfoTag::SeriesLink() const
 {
-  return m_strSeriesLink;
+  return m_strSeriesLink.Get();
 }
 
 int CPVREpgInfoTag::EpisodeNumber() const
@@ -491,12 +579,12 @@ int CPVREpgInfoTag::EpisodePart() const
 
 std::string CPVREpgInfoTag::EpisodeName() const
 {
-  return m_strEpisodeName;
+  return m_strEpisodeName.Get();
 }
 
 std::string CPVREpgInfoTag::Icon() const
 {
-  return m_strIconPath;
+  return m_strIconPath.Get();
 }
 
 std::string CPVREpgInfoTag::Path() const
@@ -584,6 +672,8 @@ bool CPVREpgInfoTag::Update(const CPVREpgInfoTag& tag, bool bUpdateBroadcastId /
     m_channelData = tag.m_channelData;
   }
 
+  m_iContentHash = tag.m_iContentHash;
+
   if (bChanged)
     UpdatePath();
 
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "XBDateTime.h"
+#include "pvr/epg/EpgStringPool.h"
 #include "threads/CriticalSection.h"
 #include "utils/ISerializable.h"
 
@@ -132,6 +133,13 @@ namespace PVR
      */
     int DatabaseID() const;
 
+    /*!
+     * @brief Get the hash of the event data as provided by the client. Used to detect events that
+     * did not change since the last EPG update, so they neither need to be updated nor persisted.
+     * @return The hash, 0 if unknown.
+     */
+    uint64_t ContentHash() const;
+
     /*!
      * @brief Get the unique ID of the channel associated with this event.
      * @return The unique channel ID.
@@ -432,6 +440,12 @@ namespace PVR
      */
     void UpdatePath();
 
+    /*!
+     * @brief Calculate the hash of the event data as provided by the client.
+     * @return The hash.
+     */
+    uint64_t CalculateContentHash() const;
+
     /*!
      * @brief Get current time, taking timeshifting into account.
      * @return The playing time.
@@ -447,25 +461,26 @@ namespace PVR
     int m_iEpisodeNumber = 0; /*!< episode number */
     int m_iEpisodePart = 0; /*!< episode part number */
     unsigned int m_iUniqueBroadcastID = 0; /*!< unique broadcast ID */
-    std::string m_strTitle; /*!< title */
-    std::string m_strPlotOutline; /*!< plot outline */
-    std::string m_strPlot; /*!< plot */
-    std::string m_strOriginalTitle; /*!< original title */
-    std::vector<std::string> m_cast; /*!< cast */
-    std::vector<std::string> m_directors; /*!< director(s) */
-    std::vector<std::string> m_writers; /*!< writer(s) */
+    CPVREpgString m_strTitle; /*!< title */
+    CPVREpgString m_strPlotOutline; /*!< plot outline */
+    CPVREpgString m_strPlot; /*!< plot */
+    CPVREpgString m_strOriginalTitle; /*!< original title */
+    CPVREpgStringList m_cast; /*!< cast */
+    CPVREpgStringList m_directors; /*!< director(s) */
+    CPVREpgStringList m_writers; /*!< writer(s) */
     int m_iYear = 0; /*!< year */
-    std::string m_strIMDBNumber; /*!< imdb number */
-    std::vector<std::string> m_genre; /*!< genre */
-    std::string m_strEpisodeName; /*!< episode name */
-    std::string m_strIconPath; /*!< the path to the icon */
+    CPVREpgString m_strIMDBNumber; /*!< imdb number */
+    CPVREpgStringList m_genre; /*!< genre */
+    CPVREpgString m_strEpisodeName; /*!< episode name */
+    CPVREpgString m_strIconPath; /*!< the path to the icon */
     std::string m_strFileNameAndPath; /*!< the filename and path */
     CDateTime m_startTime; /*!< event start time */
     CDateTime m_endTime; /*!< event end time */
     CDateTime m_firstAired; /*!< first airdate */
     unsigned int m_iFlags = 0; /*!< the flags applicable to this EPG entry */
-    std::string m_strSeriesLink; /*!< series link */
+    CPVREpgString m_strSeriesLink; /*!< series link */
     bool m_bIsGapTag = false;
+    uint64_t m_iContentHash = 0; /*!< hash of the event data as provided by the client */
 
     mutable CCriticalSection m_critSection;
     std::shared_ptr<CPVREpgChannelData> m_channelData;
@@ -35,6 +35,7 @@ CPVREpgSearchFilter::CPVREpgSearchFilter(bool bRadio)
 void CPVREpgSearchFilter::Reset()
 {
   m_strSearchTerm.clear();
+  m_textSearch.reset();
   m_bIsCaseSensitive = false;
   m_bSearchInDescription = false;
   m_iGenreType = EPG_SEARCH_UNSET;
@@ -106,20 +107,29 @@ void CPVREpgSearchFilter::SetSearchPhrase(const std::string& strSearchPhrase)
   m_strSearchTerm = "\"";
   m_strSearchTerm.append(strSearchPhrase);
   m_strSearchTerm.append("\"");
+  m_textSearch.reset();
+}
+
+std::shared_ptr<CTextSearch> CPVREpgSearchFilter::GetTextSearch() const
+{
+  if (!m_textSearch && !m_strSearchTerm.empty())
+    m_textSearch = std::make_shared<CTextSearch>(m_strSearchTerm, m_bIsCaseSensitive, SEARCH_DEFAULT_OR);
+
+  return m_textSearch;
 }
 
 bool CPVREpgSearchFilter::MatchSearchTerm(const std::shared_ptr<CPVREpgInfoTag>& tag) const
 {
   bool bReturn(true);
 
-  if (!m_strSearchTerm.empty())
+  const std::shared_ptr<CTextSearch> search = GetTextSearch();
+  if (search)
   {
-    CTextSearch search(m_strSearchTerm, m_bIsCaseSensitive, SEARCH_DEFAULT_OR);
     bReturn = !CServiceBroker::GetPVRManager().IsParentalLocked(tag);
     if (bReturn)
-      bReturn = search.Search(tag->Title()) ||
-                search.Search(tag->PlotOutline()) ||
-                (m_bSearchInDescription && search.Search(tag->Plot()));
+      bReturn = search->Search(tag->Title()) ||
+                search->Search(tag->PlotOutline()) ||
+                (m_bSearchInDescription && search->Search(tag->Plot()));
   }
 
   return bReturn;
@@ -0,0 +1,268 @@
+/*
+ *  Copyright (C) 2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "EpgSearchIndex.h"
+
+#include "pvr/epg/EpgInfoTag.h"
+#include "utils/StringUtils.h"
+#include "utils/TextSearch.h"
+
+#include <algorithm>
+#include <iterator>
+
+using namespace PVR;
+
+namespace
+{
+  bool IsWordChar(unsigned char c)
+  {
+    // bytes of multibyte utf-8 characters are always part of a word
+    return c >= 0x80 || (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+  }
+
+  // split into lower case words. lower casing is the same as done by CTextSearch.
+  void Tokenize(std::string text, std::vector<std::string>& tokens)
+  {
+    StringUtils::ToLower(text);
+
+    auto it = text.cbegin();
+    while (it != text.cend())
+    {
+      const auto wordStart = std::find_if(it, text.cend(), IsWordChar);
+      it = std::find_if_not(wordStart, text.cend(), IsWordChar);
+      if (wordStart != it)
+        tokens.emplace_back(wordStart, it);
+    }
+  }
+
+  // sequences of up to that many bytes of the tokens are indexed
+  constexpr size_t MAX_GRAM_SIZE = 3;
+
+  uint32_t GetGramKey(const char* gram, size_t size)
+  {
+    uint32_t key = static_cast<uint32_t>(size) << 24;
+    for (size_t i = 0; i < size; ++i)
+      key |= static_cast<uint32_t>(static_cast<unsigned char>(gram[i])) << (8 * (2 - i));
+    return key;
+  }
+
+  void SortUnique(std::vector<unsigned int>& list)
+  {
+    std::sort(list.begin(), list.end());
+    list.erase(std::unique(list.begin(), list.end()), list.end());
+  }
+} // unnamed namespace
+
+unsigned int CPVREpgSearchIndex::GetTokenId(const std::string& token)
+{
+  const auto it = m_tokenIds.find(token);
+  if (it != m_tokenIds.end())
+    return it->second;
+
+  const unsigned int id = m_tokens.size();
+  m_tokenIds.insert({token, id});
+  m_tokens.emplace_back(token);
+  m_postings.emplace_back();
+
+  std::vector<uint32_t> grams;
+  for (size_t size = 1; size <= MAX_GRAM_SIZE && size <= token.size(); ++size)
+  {
+    for (size_t pos = 0; pos + size <= token.size(); ++pos)
+      grams.emplace_back(GetGramKey(token.data() + pos, size));
+  }
+  std::sort(grams.begin(), grams.end());
+  grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+
+  for (uint32_t gram : grams)
+    m_gramTokens[gram].emplace_back(id);
+
+  return id;
+}
+
+void CPVREpgSearchIndex::Add(const std::shared_ptr<CPVREpgInfoTag>& tag)
+{
+  Remove(tag);
+
+  unsigned int slot;
+  if (!m_freeSlots.empty())
+  {
+    slot = m_freeSlots.back();
+    m_freeSlots.pop_back();
+    m_slots[slot] = tag;
+  }
+  else
+  {
+    slot = m_slots.size();
+    m_slots.emplace_back(tag);
+    m_slotTokens.emplace_back();
+  }
+  m_slotByTag.insert({tag.get(), slot});
+
+  std::vector<std::string> tokens;
+  Tokenize(tag->Title(), tokens);
+  Tokenize(tag->PlotOutline(), tokens);
+  Tokenize(tag->Plot(), tokens);
+
+  std::vector<unsigned int>& tokenIds = m_slotTokens[slot];
+  for (const auto& token : tokens)
+    tokenIds.emplace_back(GetTokenId(token));
+  SortUnique(tokenIds);
+
+  for (unsigned int id : tokenIds)
+    m_postings[id].emplace_back(slot);
+}
+
+void CPVREpgSearchIndex::Remove(const std::shared_ptr<CPVREpgInfoTag>& tag)
+{
+  const auto it = m_slotByTag.find(tag.get());
+  if (it == m_slotByTag.end())
+    return;
+
+  const unsigned int slot = it->second;
+  for (unsigned int id : m_slotTokens[slot])
+  {
+    SlotList& postings = m_postings[id];
+    const auto posting = std::find(postings.begin(), postings.end(), slot);
+    if (posting != postings.end())
+    {
+      *posting = postings.back();
+      postings.pop_back();
+    }
+  }
+
+  m_slotTokens[slot].clear();
+  m_slots[slot].reset();
+  m_freeSlots.emplace_back(slot);
+  m_slotByTag.erase(it);
+}
+
+void CPVREpgSearchIndex::GetTokenIds(const std::string& fragment,
+                                     std::vector<unsigned int>& tokenIds) const
+{
+  // a token containing the fragment contains all of its grams, so only the tokens of its rarest
+  // gram have to be checked. fragments up to the gram size are a gram themselves.
+  const std::vector<unsigned int>* rarest = nullptr;
+  const size_t gramSize = std::min(fragment.size(), MAX_GRAM_SIZE);
+  for (size_t pos = 0; pos + gramSize <= fragment.size(); ++pos)
+  {
+    const auto it = m_gramTokens.find(GetGramKey(fragment.data() + pos, gramSize));
+    if (it == m_gramTokens.end())
+      return;
+
+    if (!rarest || it->second.size() < rarest->size())
+      rarest = &it->second;
+  }
+
+  if (!rarest)
+    return;
+
+  for (unsigned int id : *rarest)
+  {
+    if (fragment.size() <= MAX_GRAM_SIZE || m_tokens[id].find(fragment) != std::string::npos)
+      tokenIds.emplace_back(id);
+  }
+}
+
+bool CPVREpgSearchIndex::GetCandidates(const std::string& term, SlotList& slots) const
+{
+  // all words of the term, a phrase for example, have to be contained in some word of the tag
+  std::vector<std::string> fragments;
+  Tokenize(term, fragments);
+  if (fragments.empty())
+    return false;
+
+  bool bFirst = true;
+  for (const auto& fragment : fragments)
+  {
+    std::vector<unsigned int> tokenIds;
+    GetTokenIds(fragment, tokenIds);
+
+    SlotList fragmentSlots;
+    for (unsigned int id : tokenIds)
+      fragmentSlots.insert(fragmentSlots.end(), m_postings[id].begin(), m_postings[id].end());
+    SortUnique(fragmentSlots);
+
+    if (bFirst)
+    {
+      slots = std::move(fragmentSlots);
+      bFirst = false;
+    }
+    else
+    {
+      SlotList intersection;
+      std::set_intersection(slots.begin(), slots.end(), fragmentSlots.begin(), fragmentSlots.end(),
+                            std::back_inserter(intersection));
+      slots = std::move(intersection);
+    }
+
+    if (slots.empty())
+      break;
+  }
+
+  return true;
+}
+
+bool CPVREpgSearchIndex::GetCandidates(const CTextSearch& search,
+                                       std::vector<std::shared_ptr<CPVREpgInfoTag>>& candidates) const
+{
+  bool bNarrowed = false;
+  SlotList slots;
+
+  // at least one of the OR terms must match
+  const std::vector<std::string>& orTerms = search.GetOrTerms();
+  if (!orTerms.empty())
+  {
+    bNarrowed = true;
+    for (const auto& term : orTerms)
+    {
+      SlotList termSlots;
+      if (!GetCandidates(term, termSlots))
+      {
+        bNarrowed = false;
+        break;
+      }
+
+      SlotList merged;
+      std::set_union(slots.begin(), slots.end(), termSlots.begin(), termSlots.end(),
+                     std::back_inserter(merged));
+      slots = std::move(merged);
+    }
+  }
+
+  // all of the AND terms must match
+  for (const auto& term : search.GetAndTerms())
+  {
+    SlotList termSlots;
+    if (!GetCandidates(term, termSlots))
+      continue;
+
+    if (bNarrowed)
+    {
+      SlotList intersection;
+      std::set_intersection(slots.begin(), slots.end(), termSlots.begin(), termSlots.end(),
+                            std::back_inserter(intersection));
+      slots = std::move(intersection);
+    }
+    else
+    {
+      slots = std::move(termSlots);
+      bNarrowed = true;
+    }
+  }
+
+  // NOT terms can only be checked on the full text
+
+  if (!bNarrowed)
+    return false;
+
+  candidates.reserve(candidates.size() + slots.size());
+  for (unsigned int slot : slots)
+    candidates.emplace_back(m_slots[slot]);
+
+  return true;
+}
@@ -0,0 +1,71 @@
+/*
+ *  Copyright (C) 2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class CTextSearch;
+
+namespace PVR
+{
+  class CPVREpgInfoTag;
+
+  /*!
+   * @brief Inverted index of the words in title, plot outline and plot of the tags of an EPG.
+   *
+   * CTextSearch matches terms as substrings, so the index returns the tags containing any word
+   * that contains a term. That is a superset of the matching tags, the candidates still have to
+   * be checked with the search itself.
+   */
+  class CPVREpgSearchIndex
+  {
+  public:
+    /*!
+     * @brief Add a tag to the index. A tag already in the index is indexed again.
+     * @param tag The tag.
+     */
+    void Add(const std::shared_ptr<CPVREpgInfoTag>& tag);
+
+    /*!
+     * @brief Remove a tag from the index.
+     * @param tag The tag.
+     */
+    void Remove(const std::shared_ptr<CPVREpgInfoTag>& tag);
+
+    /*!
+     * @brief Get the tags that may match the given search.
+     * @param search The search.
+     * @param candidates Filled with the candidates.
+     * @return False if the search can't be narrowed down by the index, for example if it only
+     * contains NOT terms. True otherwise.
+     */
+    bool GetCandidates(const CTextSearch& search,
+                       std::vector<std::shared_ptr<CPVREpgInfoTag>>& candidates) const;
+
+  private:
+    using SlotList = std::vector<unsigned int>;
+
+    bool GetCandidates(const std::string& term, SlotList& slots) const;
+    void GetTokenIds(const std::string& fragment, std::vector<unsigned int>& tokenIds) const;
+    unsigned int GetTokenId(const std::string& token);
+
+    std::vector<std::shared_ptr<CPVREpgInfoTag>> m_slots; /*!< indexed tags, nullptr for free slots */
+    std::vector<std::vector<unsigned int>> m_slotTokens; /*!< token ids of each slot */
+    std::vector<unsigned int> m_freeSlots;
+    std::unordered_map<const CPVREpgInfoTag*, unsigned int> m_slotByTag;
+    std::unordered_map<std::string, unsigned int> m_tokenIds;
+    std::vector<std::string> m_tokens; /*!< lower case words, by token id */
+    std::vector<SlotList> m_postings; /*!< slots containing each token, by token id */
+    std::unordered_map<uint32_t, std::vector<unsigned int>> m_gramTokens; /*!< ids of the tokens containing each 1 to 3 byte sequence */
+  };
+}
@@ -0,0 +1,139 @@
+/*
+ *  Copyright (C) 2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "EpgStringPool.h"
+
+#include "threads/SingleLock.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <functional>
+
+using namespace PVR;
+
+namespace
+{
+  // values are only dropped if the pool grew that much since the last time
+  constexpr size_t MIN_PRUNE_SIZE = 4096;
+
+  size_t GetSize(const std::string& value)
+  {
+    return value.size();
+  }
+
+  size_t GetSize(const std::vector<std::string>& value)
+  {
+    size_t size = 0;
+    for (const auto& entry : value)
+      size += entry.size();
+    return size;
+  }
+} // unnamed namespace
+
+template<>
+size_t CPVREpgStringPool::SHash<std::string>::operator()(
+    const std::shared_ptr<const std::string>& value) const
+{
+  return std::hash<std::string>()(*value);
+}
+
+template<>
+size_t CPVREpgStringPool::SHash<std::vector<std::string>>::operator()(
+    const std::shared_ptr<const std::vector<std::string>>& value) const
+{
+  size_t hash = value->size();
+  for (const auto& entry : *value)
+    hash ^= std::hash<std::string>()(entry) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  return hash;
+}
+
+CPVREpgStringPool& CPVREpgStringPool::GetInstance()
+{
+  static CPVREpgStringPool instance;
+  return instance;
+}
+
+std::shared_ptr<const std::string> CPVREpgStringPool::Get(const std::string& value)
+{
+  return Get(m_strings, value);
+}
+
+std::shared_ptr<const std::vector<std::string>> CPVREpgStringPool::Get(
+    const std::vector<std::string>& value)
+{
+  return Get(m_stringLists, value);
+}
+
+template<typename T>
+std::shared_ptr<const T> CPVREpgStringPool::Get(SValues<T>& pool, const T& value)
+{
+  if (value.empty())
+    return {};
+
+  // non-owning pointer to the value, only used for the lookup
+  const std::shared_ptr<const T> key(std::shared_ptr<const T>(), &value);
+
+  CSingleLock lock(m_critSection);
+  m_iRequests++;
+
+  const auto it = pool.values.find(key);
+  if (it != pool.values.end())
+  {
+    m_iHits++;
+    m_iSavedBytes += GetSize(value);
+    return *it;
+  }
+
+  if (pool.values.size() >= pool.nextPruneSize)
+    Prune(pool);
+
+  const auto pooled = std::make_shared<const T>(value);
+  pool.values.insert(pooled);
+  pool.bytes += GetSize(value);
+  return pooled;
+}
+
+template<typename T>
+void CPVREpgStringPool::Prune(SValues<T>& pool)
+{
+  // values only referenced by the pool can't be referenced again by anyone else than the pool
+  for (auto it = pool.values.begin(); it != pool.values.end();)
+  {
+    if (it->use_count() == 1)
+    {
+      pool.bytes -= GetSize(**it);
+      it = pool.values.erase(it);
+    }
+    else
+      ++it;
+  }
+
+  pool.nextPruneSize = std::max(MIN_PRUNE_SIZE, pool.values.size() * 2);
+}
+
+CPVREpgStringPool::SStatistics CPVREpgStringPool::GetStatistics() const
+{
+  CSingleLock lock(m_critSection);
+
+  SStatistics statistics;
+  statistics.requests = m_iRequests;
+  statistics.hits = m_iHits;
+  statistics.entries = m_strings.values.size() + m_stringLists.values.size();
+  statistics.bytes = m_strings.bytes + m_stringLists.bytes;
+  statistics.savedBytes = m_iSavedBytes;
+  return statistics;
+}
+
+void CPVREpgStringPool::LogStatistics() const
+{
+  const SStatistics statistics = GetStatistics();
+  CLog::LogFC(LOGDEBUG, LOGEPG,
+              "String pool: %zu values in %zu kB, %zu of %zu requests shared, %zu kB saved",
+              statistics.entries, statistics.bytes / 1024, statistics.hits, statistics.requests,
+              statistics.savedBytes / 1024);
+}
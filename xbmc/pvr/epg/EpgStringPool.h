@@ -0,0 +1,136 @@
+/*
+ *  Copyright (C) 2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace PVR
+{
+  /*!
+   * @brief Process wide pool of the texts of EPG tags.
+   *
+   * Guides repeat the same plots, genres, cast lists, icons and series links for many events on
+   * many channels. The pool keeps a single immutable copy of every distinct value, which is shared
+   * by all tags using it. Values no longer used by any tag are dropped when the pool grows.
+   */
+  class CPVREpgStringPool
+  {
+    friend class TestPVREpgStringPoolHelper;
+
+  public:
+    struct SStatistics
+    {
+      size_t requests = 0; /*!< number of values put into the pool */
+      size_t hits = 0; /*!< number of values that were already contained in the pool */
+      size_t entries = 0; /*!< number of distinct values currently contained in the pool */
+      size_t bytes = 0; /*!< size of the distinct values currently contained in the pool */
+      size_t savedBytes = 0; /*!< size of the values that did not have to be stored again */
+    };
+
+    static CPVREpgStringPool& GetInstance();
+
+    /*!
+     * @brief Get the pooled instance of a value.
+     * @param value The value.
+     * @return The pooled instance, nullptr for an empty value.
+     */
+    std::shared_ptr<const std::string> Get(const std::string& value);
+    std::shared_ptr<const std::vector<std::string>> Get(const std::vector<std::string>& value);
+
+    /*!
+     * @brief Get the usage statistics of the pool.
+     * @return The statistics.
+     */
+    SStatistics GetStatistics() const;
+
+    /*!
+     * @brief Log the usage statistics of the pool.
+     */
+    void LogStatistics() const;
+
+  private:
+    CPVREpgStringPool() = default;
+
+    template<typename T>
+    struct SHash
+    {
+      size_t operator()(const std::shared_ptr<const T>& value) const;
+    };
+
+    template<typename T>
+    struct SEqual
+    {
+      bool operator()(const std::shared_ptr<const T>& left,
+                      const std::shared_ptr<const T>& right) const
+      {
+        return *left == *right;
+      }
+    };
+
+    template<typename T>
+    struct SValues
+    {
+      std::unordered_set<std::shared_ptr<const T>, SHash<T>, SEqual<T>> values;
+      size_t nextPruneSize = 0; /*!< size at which unused values get dropped */
+      size_t bytes = 0;
+    };
+
+    template<typename T>
+    std::shared_ptr<const T> Get(SValues<T>& pool, const T& value);
+
+    template<typename T>
+    static void Prune(SValues<T>& pool);
+
+    mutable CCriticalSection m_critSection;
+    SValues<std::string> m_strings;
+    SValues<std::vector<std::string>> m_stringLists;
+    size_t m_iRequests = 0;
+    size_t m_iHits = 0;
+    size_t m_iSavedBytes = 0;
+  };
+
+  /*!
+   * @brief A value of an EPG tag, stored in the EPG string pool.
+   */
+  template<typename T>
+  class CPVREpgPooledValue
+  {
+  public:
+    CPVREpgPooledValue& operator=(const T& value)
+    {
+      m_value = CPVREpgStringPool::GetInstance().Get(value);
+      return *this;
+    }
+
+    const T& Get() const
+    {
+      static const T empty;
+      return m_value ? *m_value : empty;
+    }
+
+    bool operator==(const CPVREpgPooledValue& right) const
+    {
+      // equal values share the same instance, compare the values only as a fallback
+      return m_value == right.m_value || Get() == right.Get();
+    }
+
+    bool operator!=(const CPVREpgPooledValue& right) const { return !(*this == right); }
+
+  private:
+    std::shared_ptr<const T> m_value;
+  };
+
+  using CPVREpgString = CPVREpgPooledValue<std::string>;
+  using CPVREpgStringList = CPVREpgPooledValue<std::vector<std::string>>;
+}
@@ -0,0 +1,182 @@
+/*
+ *  Copyright (C) 2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "EpgUpdateScheduler.h"
+
+#include "pvr/epg/Epg.h"
+#include "pvr/epg/EpgChannelData.h"
+#include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "threads/Thread.h"
+#include "utils/log.h"
+
+#include <algorithm>
+
+using namespace PVR;
+
+class CPVREpgUpdateScheduler::CWorker : public CThread
+{
+public:
+  CWorker(CPVREpgUpdateScheduler& scheduler, int iClientId)
+    : CThread("EPGUpdater"), m_scheduler(scheduler), m_iClientId(iClientId)
+  {
+  }
+
+  ~CWorker() override { StopThread(); }
+
+protected:
+  void Process() override
+  {
+    std::shared_ptr<CPVREpg> epg;
+    while (!m_bStop && m_scheduler.GetNextEpg(m_iClientId, epg))
+    {
+      const unsigned int iStart = XbmcThreads::SystemClockMillis();
+      const bool bSuccess = m_scheduler.m_update(epg);
+      m_scheduler.UpdateDone(m_iClientId, epg, bSuccess, XbmcThreads::SystemClockMillis() - iStart);
+    }
+    m_scheduler.WorkerDone();
+  }
+
+private:
+  CPVREpgUpdateScheduler& m_scheduler;
+  const int m_iClientId;
+};
+
+CPVREpgUpdateScheduler::CPVREpgUpdateScheduler(unsigned int iMaxRequestsPerClient)
+  : m_iMaxRequestsPerClient(std::max(iMaxRequestsPerClient, 1u))
+{
+}
+
+CPVREpgUpdateScheduler::~CPVREpgUpdateScheduler()
+{
+  m_workers.clear();
+}
+
+void CPVREpgUpdateScheduler::Add(const std::shared_ptr<CPVREpg>& epg)
+{
+  const std::shared_ptr<CPVREpgChannelData> channelData = epg->GetChannelData();
+  const int iClientId = channelData ? channelData->ClientId() : -1;
+
+  CSingleLock lock(m_critSection);
+  m_clients[iClientId].queue.emplace_back(epg);
+}
+
+bool CPVREpgUpdateScheduler::Run(const UpdateFunction& update,
+                                 const InterruptFunction& interrupt,
+                                 const ProgressFunction& progress)
+{
+  const unsigned int iStartTime = XbmcThreads::SystemClockMillis();
+  m_update = update;
+
+  {
+    CSingleLock lock(m_critSection);
+    for (const auto& client : m_clients)
+    {
+      const size_t iWorkers = std::min<size_t>(m_iMaxRequestsPerClient, client.second.queue.size());
+      for (size_t i = 0; i < iWorkers; ++i)
+      {
+        m_workers.emplace_back(new CWorker(*this, client.first));
+        m_iRunningWorkers++;
+      }
+    }
+  }
+
+  for (const auto& worker : m_workers)
+    worker->Create();
+
+  bool bRunning = true;
+  while (bRunning)
+  {
+    m_doneEvent.WaitMSec(100);
+
+    std::vector<std::shared_ptr<CPVREpg>> done;
+    {
+      CSingleLock lock(m_critSection);
+      done.swap(m_done);
+      bRunning = m_iRunningWorkers > 0;
+    }
+
+    for (const auto& epg : done)
+      progress(epg);
+
+    if (bRunning && interrupt())
+    {
+      // updates in progress can't be aborted, but no more are started
+      CSingleLock lock(m_critSection);
+      m_bInterrupted = true;
+    }
+  }
+
+  m_workers.clear();
+
+  LogStatistics(iStartTime);
+
+  CSingleLock lock(m_critSection);
+  return !m_bInterrupted;
+}
+
+bool CPVREpgUpdateScheduler::GetNextEpg(int iClientId, std::shared_ptr<CPVREpg>& epg)
+{
+  CSingleLock lock(m_critSection);
+  std::deque<std::shared_ptr<CPVREpg>>& queue = m_clients[iClientId].queue;
+  if (m_bInterrupted || queue.empty())
+    return false;
+
+  epg = queue.front();
+  queue.pop_front();
+  return true;
+}
+
+void CPVREpgUpdateScheduler::UpdateDone(int iClientId,
+                                        const std::shared_ptr<CPVREpg>& epg,
+                                        bool bSuccess,
+                                        unsigned int iDuration)
+{
+  CSingleLock lock(m_critSection);
+  SClient& client = m_clients[iClientId];
+  client.iUpdates++;
+  client.iRequestTime += iDuration;
+  client.iEndTime = XbmcThreads::SystemClockMillis();
+
+  if (bSuccess)
+  {
+    m_updated.emplace_back(epg);
+  }
+  else
+  {
+    client.iFailures++;
+    m_failed.emplace_back(epg);
+  }
+
+  m_done.emplace_back(epg);
+  m_doneEvent.Set();
+}
+
+void CPVREpgUpdateScheduler::WorkerDone()
+{
+  CSingleLock lock(m_critSection);
+  m_iRunningWorkers--;
+  m_doneEvent.Set();
+}
+
+void CPVREpgUpdateScheduler::LogStatistics(unsigned int iStartTime) const
+{
+  CSingleLock lock(m_critSection);
+  for (const auto& client : m_clients)
+  {
+    const SClient& stats = client.second;
+    if (stats.iUpdates == 0)
+      continue;
+
+    const unsigned int iElapsed = std::max(stats.iEndTime - iStartTime, 1u);
+    CLog::LogFC(LOGDEBUG, LOGEPG,
+                "Client %d: updated %u EPGs (%u failed) in %u ms, %.1f EPGs/s, %u ms per request",
+                client.first, stats.iUpdates, stats.iFailures, iElapsed,
+                stats.iUpdates * 1000.0 / iElapsed, stats.iRequestTime / stats.iUpdates);
+  }
+}
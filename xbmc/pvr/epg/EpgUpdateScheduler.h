@@ -0,0 +1,103 @@
+/*
+ *  Copyright (C) 2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace PVR
+{
+  class CPVREpg;
+
+  /*!
+   * @brief Runs the updates of a set of EPGs concurrently.
+   *
+   * EPGs of different clients are updated in parallel, so a slow backend does not delay the
+   * others. The number of concurrent updates for EPGs of the same client is limited.
+   */
+  class CPVREpgUpdateScheduler
+  {
+  public:
+    using UpdateFunction = std::function<bool(const std::shared_ptr<CPVREpg>& epg)>;
+    using InterruptFunction = std::function<bool()>;
+    using ProgressFunction = std::function<void(const std::shared_ptr<CPVREpg>& epg)>;
+
+    /*!
+     * @brief Create a new scheduler.
+     * @param iMaxRequestsPerClient The maximum number of concurrent updates per client.
+     */
+    explicit CPVREpgUpdateScheduler(unsigned int iMaxRequestsPerClient);
+    ~CPVREpgUpdateScheduler();
+
+    /*!
+     * @brief Add an EPG to update.
+     * @param epg The EPG.
+     */
+    void Add(const std::shared_ptr<CPVREpg>& epg);
+
+    /*!
+     * @brief Update all EPGs added to the scheduler. Blocks until all updates are done.
+     * @param update The function to update an EPG, called on worker threads.
+     * @param interrupt Called on the calling thread, return true to skip all remaining updates.
+     * @param progress Called on the calling thread for every EPG whose update is done.
+     * @return False if the update was interrupted, true otherwise.
+     */
+    bool Run(const UpdateFunction& update,
+             const InterruptFunction& interrupt,
+             const ProgressFunction& progress);
+
+    /*!
+     * @brief Get the EPGs that were updated successfully.
+     * @return The EPGs.
+     */
+    const std::vector<std::shared_ptr<CPVREpg>>& GetUpdated() const { return m_updated; }
+
+    /*!
+     * @brief Get the EPGs whose update failed.
+     * @return The EPGs.
+     */
+    const std::vector<std::shared_ptr<CPVREpg>>& GetFailed() const { return m_failed; }
+
+  private:
+    class CWorker;
+
+    struct SClient
+    {
+      std::deque<std::shared_ptr<CPVREpg>> queue; /*!< EPGs not yet updated */
+      unsigned int iUpdates = 0; /*!< number of updates done */
+      unsigned int iFailures = 0; /*!< number of failed updates */
+      unsigned int iRequestTime = 0; /*!< sum of the durations of all updates, in ms */
+      unsigned int iEndTime = 0; /*!< time the last update was done */
+    };
+
+    bool GetNextEpg(int iClientId, std::shared_ptr<CPVREpg>& epg);
+    void UpdateDone(int iClientId, const std::shared_ptr<CPVREpg>& epg, bool bSuccess, unsigned int iDuration);
+    void WorkerDone();
+    void LogStatistics(unsigned int iStartTime) const;
+
+    const unsigned int m_iMaxRequestsPerClient;
+    UpdateFunction m_update;
+
+    mutable CCriticalSection m_critSection;
+    CEvent m_doneEvent;
+    std::map<int, SClient> m_clients;
+    std::vector<std::unique_ptr<CWorker>> m_workers;
+    unsigned int m_iRunningWorkers = 0;
+    bool m_bInterrupted = false;
+    std::vector<std::shared_ptr<CPVREpg>> m_done; /*!< EPGs done, but not yet reported as progress */
+    std::vector<std::shared_ptr<CPVREpg>> m_updated;
+    std::vector<std::shared_ptr<CPVREpg>> m_failed;
+  };
+}
@@ -0,0 +1,231 @@
+/*
+ *  Copyright (C) 2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "addons/kodi-addon-dev-kit/include/kodi/xbmc_epg_types.h"
+#include "pvr/epg/EpgInfoTag.h"
+#include "pvr/epg/EpgSearchIndex.h"
+#include "utils/TextSearch.h"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <stdio.h>
+
+#include <gtest/gtest.h>
+
+using namespace PVR;
+
+namespace
+{
+const char* WORDS[] = {"news",     "evening",  "weather", "sport",       "football", "Tatort",
+                       "Krimi",    "crime",    "quiz",    "show",        "music",    "concert",
+                       "nature",   "wildlife", "Africa",  "ocean",       "history",  "war",
+                       "comedy",   "drama",    "family",  "children",    "cartoon",  "Müller",
+                       "Straße",   "film",     "live",    "documentary", "magazine", "talk"};
+
+const char* SYLLABLES[] = {"ka", "lo", "mi", "ren", "sto", "vel", "da", "ur", "ton", "bri",
+                           "sa", "en", "qui", "ma", "ro", "tel", "fa", "nor", "li", "ga"};
+
+// one in ten words is a common one, the others are made up of two or three syllables. the
+// generator is used directly, the distributions differ between standard libraries.
+std::string CreateWord(std::mt19937& random)
+{
+  if (random() % 10 == 0)
+    return WORDS[random() % (sizeof(WORDS) / sizeof(WORDS[0]))];
+
+  std::string word;
+  for (int i = random() % 2; i < 3; ++i)
+    word += SYLLABLES[random() % (sizeof(SYLLABLES) / sizeof(SYLLABLES[0]))];
+  return word;
+}
+
+std::string CreateText(std::mt19937& random, int iWords)
+{
+  std::string text;
+  for (int i = 0; i < iWords; ++i)
+  {
+    if (!text.empty())
+      text += i % 5 == 0 ? ", " : " ";
+    text += CreateWord(random);
+  }
+  return text;
+}
+
+std::vector<std::shared_ptr<CPVREpgInfoTag>> CreateTags(unsigned int iCount)
+{
+  std::mt19937 random(42);
+  std::vector<std::shared_ptr<CPVREpgInfoTag>> tags;
+  for (unsigned int i = 0; i < iCount; ++i)
+  {
+    const std::string title = CreateText(random, 3);
+    const std::string plotOutline = CreateText(random, 8);
+    const std::string plot = CreateText(random, 30);
+
+    EPG_TAG data = {};
+    data.iUniqueBroadcastId = i + 1;
+    data.iUniqueChannelId = i % 100 + 1;
+    data.strTitle = title.c_str();
+    data.strPlotOutline = plotOutline.c_str();
+    data.strPlot = plot.c_str();
+    data.startTime = 1600000000 + i * 1800;
+    data.endTime = data.startTime + 1800;
+    tags.emplace_back(std::make_shared<CPVREpgInfoTag>(data, 1, nullptr, i % 100 + 1));
+  }
+  return tags;
+}
+
+// the same check as CPVREpgSearchFilter does for every tag
+bool Matches(const CTextSearch& search, const CPVREpgInfoTag& tag)
+{
+  return search.Search(tag.Title()) || search.Search(tag.PlotOutline()) ||
+         search.Search(tag.Plot());
+}
+
+class TestPVREpgSearchIndex : public ::testing::Test
+{
+protected:
+  TestPVREpgSearchIndex() : m_tags(CreateTags(20000))
+  {
+    for (const auto& tag : m_tags)
+      m_index.Add(tag);
+  }
+
+  // every tag found by the linear search has to be a candidate
+  void ExpectSuperset(const std::string& strSearchTerm,
+                      TextSearchDefault defaultSearchMode = SEARCH_DEFAULT_OR)
+  {
+    const CTextSearch search(strSearchTerm, false, defaultSearchMode);
+    std::vector<std::shared_ptr<CPVREpgInfoTag>> candidates;
+    ASSERT_TRUE(m_index.GetCandidates(search, candidates)) << strSearchTerm;
+    std::sort(candidates.begin(), candidates.end());
+
+    size_t matches = 0;
+    for (const auto& tag : m_tags)
+    {
+      if (!Matches(search, *tag))
+        continue;
+
+      matches++;
+      EXPECT_TRUE(std::binary_search(candidates.begin(), candidates.end(), tag))
+          << strSearchTerm << ": " << tag->Title();
+    }
+    EXPECT_GT(matches, 0u) << strSearchTerm;
+    EXPECT_LE(matches, candidates.size()) << strSearchTerm;
+  }
+
+  std::vector<std::shared_ptr<CPVREpgInfoTag>> m_tags;
+  CPVREpgSearchIndex m_index;
+};
+} // unnamed namespace
+
+TEST_F(TestPVREpgSearchIndex, Or)
+{
+  ExpectSuperset("news");
+  ExpectSuperset("news weather");
+  ExpectSuperset("NEWS or Krimi");
+  ExpectSuperset("wea");
+  ExpectSuperset("t");
+  ExpectSuperset("ller");
+  ExpectSuperset("storen");
+}
+
+TEST_F(TestPVREpgSearchIndex, And)
+{
+  ExpectSuperset("+ news + weather");
+  ExpectSuperset("news and sport");
+  ExpectSuperset("+ tator + krim");
+  ExpectSuperset("film and ocean");
+  ExpectSuperset("crime drama", SEARCH_DEFAULT_AND);
+}
+
+TEST_F(TestPVREpgSearchIndex, Not)
+{
+  // terms are NOT terms unless marked otherwise
+  ExpectSuperset("+ news sport", SEARCH_DEFAULT_NOT);
+  ExpectSuperset("and crime drama family", SEARCH_DEFAULT_NOT);
+  ExpectSuperset("| tatort or krimi music", SEARCH_DEFAULT_NOT);
+
+  // NOT terms alone can't be narrowed down by the index
+  const CTextSearch search("sport", false, SEARCH_DEFAULT_NOT);
+  ASSERT_FALSE(search.GetNotTerms().empty());
+  std::vector<std::shared_ptr<CPVREpgInfoTag>> candidates;
+  EXPECT_FALSE(m_index.GetCandidates(search, candidates));
+}
+
+TEST_F(TestPVREpgSearchIndex, Quoted)
+{
+  ExpectSuperset("\"evening news\"");
+  ExpectSuperset("\"news weather\"");
+  ExpectSuperset("\"s, w\"");
+  ExpectSuperset("\"ws eve\"");
+  ExpectSuperset("\"Straße\"", SEARCH_DEFAULT_AND);
+}
+
+TEST_F(TestPVREpgSearchIndex, RemovedTagsAreNoCandidates)
+{
+  const CTextSearch search("news", false, SEARCH_DEFAULT_OR);
+  std::vector<std::shared_ptr<CPVREpgInfoTag>> candidates;
+  ASSERT_TRUE(m_index.GetCandidates(search, candidates));
+  ASSERT_FALSE(candidates.empty());
+
+  const std::shared_ptr<CPVREpgInfoTag> removed = candidates.front();
+  m_index.Remove(removed);
+
+  candidates.clear();
+  ASSERT_TRUE(m_index.GetCandidates(search, candidates));
+  EXPECT_EQ(candidates.end(), std::find(candidates.begin(), candidates.end(), removed));
+}
+
+TEST_F(TestPVREpgSearchIndex, UnknownTermHasNoCandidates)
+{
+  const CTextSearch search("xylophone", false, SEARCH_DEFAULT_OR);
+  std::vector<std::shared_ptr<CPVREpgInfoTag>> candidates;
+  EXPECT_TRUE(m_index.GetCandidates(search, candidates));
+  EXPECT_TRUE(candidates.empty());
+}
+
+// Time of a search in a guide of 50000 tags, checking all tags against checking the candidates of
+// the index. Run with --gtest_also_run_disabled_tests.
+TEST(TestPVREpgSearchIndexBenchmark, DISABLED_SearchBenchmark)
+{
+  const auto tags = CreateTags(50000);
+  CPVREpgSearchIndex index;
+  for (const auto& tag : tags)
+    index.Add(tag);
+
+  for (const char* strSearchTerm : {"africa", "\"evening news\"", "tatort and krimi", "renka", "ea"})
+  {
+    const CTextSearch search(strSearchTerm, false, SEARCH_DEFAULT_OR);
+
+    auto start = std::chrono::steady_clock::now();
+    size_t linearMatches = 0;
+    for (const auto& tag : tags)
+    {
+      if (Matches(search, *tag))
+        linearMatches++;
+    }
+    const double linear =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    std::vector<std::shared_ptr<CPVREpgInfoTag>> candidates;
+    ASSERT_TRUE(index.GetCandidates(search, candidates));
+    size_t indexedMatches = 0;
+    for (const auto& tag : candidates)
+    {
+      if (Matches(search, *tag))
+        indexedMatches++;
+    }
+    const double indexed =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    EXPECT_EQ(linearMatches, indexedMatches);
+    printf("%s: %zu matches, linear %.2f ms, index %.2f ms (%zu candidates)\n", strSearchTerm,
+           linearMatches, linear, indexed, candidates.size());
+  }
+}
@@ -0,0 +1,167 @@
+/*
+ *  Copyright (C) 2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "pvr/epg/EpgStringPool.h"
+#include "threads/SingleLock.h"
+#include "utils/StringUtils.h"
+
+#include <chrono>
+#include <random>
+#include <stdio.h>
+
+#include <gtest/gtest.h>
+
+namespace PVR
+{
+// a pool of its own for every test, instead of the process wide instance
+class TestPVREpgStringPoolHelper
+{
+public:
+  std::shared_ptr<const std::string> Get(const std::string& value) { return m_pool.Get(value); }
+
+  std::shared_ptr<const std::vector<std::string>> Get(const std::vector<std::string>& value)
+  {
+    return m_pool.Get(value);
+  }
+
+  void Prune()
+  {
+    CSingleLock lock(m_pool.m_critSection);
+    CPVREpgStringPool::Prune(m_pool.m_strings);
+    CPVREpgStringPool::Prune(m_pool.m_stringLists);
+  }
+
+  CPVREpgStringPool::SStatistics GetStatistics() const { return m_pool.GetStatistics(); }
+
+private:
+  CPVREpgStringPool m_pool;
+};
+} // namespace PVR
+
+using namespace PVR;
+
+TEST(TestPVREpgStringPool, EqualValuesShareAnInstance)
+{
+  TestPVREpgStringPoolHelper pool;
+
+  const auto plot = pool.Get(std::string("A detective investigates."));
+  ASSERT_NE(nullptr, plot);
+  EXPECT_EQ(plot, pool.Get(std::string("A detective investigates.")));
+  EXPECT_NE(plot, pool.Get(std::string("a detective investigates.")));
+
+  const auto cast = pool.Get(std::vector<std::string>{"Jane Doe", "John Doe"});
+  ASSERT_NE(nullptr, cast);
+  EXPECT_EQ(cast, pool.Get(std::vector<std::string>{"Jane Doe", "John Doe"}));
+  EXPECT_NE(cast, pool.Get(std::vector<std::string>{"John Doe", "Jane Doe"}));
+
+  const CPVREpgStringPool::SStatistics statistics = pool.GetStatistics();
+  EXPECT_EQ(6u, statistics.requests);
+  EXPECT_EQ(2u, statistics.hits);
+  EXPECT_EQ(4u, statistics.entries);
+  EXPECT_EQ(25u + 16u, statistics.savedBytes);
+}
+
+TEST(TestPVREpgStringPool, EmptyValuesAreNotPooled)
+{
+  TestPVREpgStringPoolHelper pool;
+
+  EXPECT_EQ(nullptr, pool.Get(std::string()));
+  EXPECT_EQ(nullptr, pool.Get(std::vector<std::string>()));
+
+  const CPVREpgStringPool::SStatistics statistics = pool.GetStatistics();
+  EXPECT_EQ(0u, statistics.requests);
+  EXPECT_EQ(0u, statistics.entries);
+}
+
+TEST(TestPVREpgStringPool, PruneDropsUnusedValues)
+{
+  TestPVREpgStringPoolHelper pool;
+
+  const auto used = pool.Get(std::string("used"));
+  const auto usedList = pool.Get(std::vector<std::string>{"used"});
+  pool.Get(std::string("unused"));
+  pool.Get(std::vector<std::string>{"unused"});
+  ASSERT_EQ(4u, pool.GetStatistics().entries);
+
+  pool.Prune();
+  CPVREpgStringPool::SStatistics statistics = pool.GetStatistics();
+  EXPECT_EQ(2u, statistics.entries);
+  EXPECT_EQ(8u, statistics.bytes);
+
+  // the values still in use are kept, the others are stored again
+  EXPECT_EQ(used, pool.Get(std::string("used")));
+  EXPECT_EQ(usedList, pool.Get(std::vector<std::string>{"used"}));
+  pool.Get(std::string("unused"));
+  statistics = pool.GetStatistics();
+  EXPECT_EQ(2u, statistics.hits);
+  EXPECT_EQ(3u, statistics.entries);
+}
+
+TEST(TestPVREpgStringPool, PrunesWhenGrowing)
+{
+  TestPVREpgStringPoolHelper pool;
+
+  const auto used = pool.Get(std::string("used"));
+  for (int i = 0; i < 10000; ++i)
+    pool.Get(StringUtils::Format("unused {}", i));
+
+  const CPVREpgStringPool::SStatistics statistics = pool.GetStatistics();
+  EXPECT_LT(statistics.entries, 10000u);
+  EXPECT_EQ(used, pool.Get(std::string("used")));
+}
+
+// Memory of the texts of a synthetic guide of 100 channels over 14 days, where the events are
+// repeats of 2000 programmes, partly shown on several channels. Reports the bytes stored in the
+// pool against the bytes every tag would store on its own. Run with
+// --gtest_also_run_disabled_tests.
+TEST(TestPVREpgStringPool, DISABLED_GuideBenchmark)
+{
+  constexpr int CHANNELS = 100;
+  constexpr int EVENTS_PER_CHANNEL = 14 * 24;
+  constexpr int PROGRAMMES = 2000;
+
+  TestPVREpgStringPoolHelper pool;
+  std::mt19937 random(42);
+  std::vector<std::shared_ptr<const std::string>> strings;
+  std::vector<std::shared_ptr<const std::vector<std::string>>> lists;
+  size_t requestedBytes = 0;
+
+  const auto start = std::chrono::steady_clock::now();
+  for (int channel = 0; channel < CHANNELS; ++channel)
+  {
+    for (int event = 0; event < EVENTS_PER_CHANNEL; ++event)
+    {
+      const unsigned int programme = random() % PROGRAMMES;
+      const std::string plot = StringUtils::Format(
+          "Programme {} is about something that takes a few sentences to tell. The plot of an EPG "
+          "event usually is a few hundred bytes long, this one {} is no exception to that.",
+          programme, programme);
+      const std::string genre = StringUtils::Format("Genre {}", programme % 20);
+      const std::string icon =
+          StringUtils::Format("https://images.example.org/programmes/{}/poster.jpg", programme);
+      const std::vector<std::string> cast{StringUtils::Format("Actor {}", programme % 300),
+                                          StringUtils::Format("Actress {}", programme % 400)};
+
+      for (const auto& value : {plot, genre, icon})
+      {
+        strings.emplace_back(pool.Get(value));
+        requestedBytes += value.size();
+      }
+      lists.emplace_back(pool.Get(cast));
+      requestedBytes += cast[0].size() + cast[1].size();
+    }
+  }
+  const double milliseconds =
+      std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+  const CPVREpgStringPool::SStatistics statistics = pool.GetStatistics();
+  EXPECT_EQ(requestedBytes, statistics.bytes + statistics.savedBytes);
+  printf("%d events: %zu kB requested, %zu kB stored in %zu values, %zu kB saved, %.1f ms\n",
+         CHANNELS * EVENTS_PER_CHANNEL, requestedBytes / 1024, statistics.bytes / 1024,
+         statistics.entries, statistics.savedBytes / 1024, milliseconds);
+}
@@ -35,6 +35,7 @@
 #include "pvr/PVRManager.h"
 #include "pvr/PVRPlaybackState.h"
 #include "pvr/PVRStreamProperties.h"
+#include "pvr/PVRStreamPropertiesCache.h"
 #include "pvr/addons/PVRClient.h"
 #include "pvr/addons/PVRClientMenuHooks.h"
 #include "pvr/addons/PVRClients.h"
@@ -56,10 +57,13 @@
 #include "pvr/timers/PVRTimerInfoTag.h"
 #include "pvr/timers/PVRTimers.h"
 #include "pvr/windows/GUIWindowPVRSearch.h"
+#include "settings/AdvancedSettings.h"
 #include "settings/MediaSettings.h"
 #include "settings/Settings.h"
+#include "settings/SettingsComponent.h"
 #include "threads/IRunnable.h"
 #include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
 #include "utils/StringUtils.h"
 #include "utils/SystemInfo.h"
 #include "utils/URIUtils.h"
@@ -229,7 +233,8 @@ namespace PVR
       CSettings::SETTING_PVRPOWERMANAGEMENT_BACKENDIDLETIME,
       CSettings::SETTING_PVRREMINDERS_AUTOCLOSEDELAY,
       CSettings::SETTING_PVRREMINDERS_AUTORECORD
-    })
+    }),
+    m_streamPropertiesCache(new CPVRStreamPropertiesCache)
   {
   }
 
@@ -1219,7 +1224,17 @@ namespace PVR
       CPVRStreamProperties props;
 
       if (item->IsPVRChannel())
-        client->GetChannelStreamProperties(item->GetPVRChannelInfoTag(), props);
+      {
+        const std::shared_ptr<CPVRChannel> channel = item->GetPVRChannelInfoTag();
+        const unsigned int iStart = XbmcThreads::SystemClockMillis();
+        const bool bCached = m_streamPropertiesCache->Take(channel, props);
+        if (!bCached)
+          client->GetChannelStreamProperties(channel, props);
+
+        CLog::LogFC(LOGDEBUG, LOGPVR, "Obtained stream properties of channel '%s' in %u ms%s",
+                    channel->ChannelName().c_str(), XbmcThreads::SystemClockMillis() - iStart,
+                    bCached ? " (prefetched)" : "");
+      }
       else if (item->IsPVRRecording())
         client->GetRecordingStreamProperties(item->GetPVRRecordingInfoTag(), props);
       else if (item->IsEPG())
@@ -2233,6 +2248,11 @@ namespace PVR
       const std::shared_ptr<CPVRChannel> channel = item->GetPVRChannelInfoTag();
       m_channelNavigator.SetPlayingChannel(channel);
       SetSelectedItemPath(channel->IsRadio(), channel->Path());
+
+      if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_bPVRPredictiveZap)
+        m_streamPropertiesCache->Prefetch(
+            CServiceBroker::GetPVRManager().PlaybackState()->GetPlayingGroup(channel->IsRadio()),
+            channel);
     }
   }
 
@@ -2241,6 +2261,7 @@ namespace PVR
     if (item->HasPVRChannelInfoTag())
     {
       m_channelNavigator.ClearPlayingChannel();
+      m_streamPropertiesCache->Clear();
     }
   }
 
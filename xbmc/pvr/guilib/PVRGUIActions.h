@@ -38,6 +38,7 @@ namespace PVR
   };
 
   class CPVRRecording;
+  class CPVRStreamPropertiesCache;
   class CPVRTimerInfoTag;
 
   class CPVRChannelSwitchingInputHandler : public CPVRChannelNumberInputHandler
@@ -536,6 +537,7 @@ namespace PVR
     std::string m_selectedItemPathTV;
     std::string m_selectedItemPathRadio;
     mutable bool m_bReminderAnnouncementRunning = false;
+    const std::shared_ptr<CPVRStreamPropertiesCache> m_streamPropertiesCache;
   };
 
 } // namespace PVR
@@ -26,12 +26,38 @@
 #include "utils/log.h"
 #include "video/VideoDatabase.h"
 
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
 using namespace PVR;
 
+namespace
+{
+size_t GetClientDataHash(const PVR_RECORDING& recording)
+{
+  size_t hash = std::hash<std::string>()(recording.strRecordingId);
+  const auto combine = [&hash](size_t value) { hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2); };
+  for (const char* value : {recording.strTitle, recording.strEpisodeName, recording.strDirectory,
+                            recording.strPlotOutline, recording.strPlot,
+                            recording.strGenreDescription, recording.strChannelName,
+                            recording.strIconPath, recording.strThumbnailPath,
+                            recording.strFanartPath})
+    combine(std::hash<std::string>()(value));
+  for (int value : {recording.iSeriesNumber, recording.iEpisodeNumber, recording.iYear,
+                    recording.iDuration, recording.iPriority, recording.iLifetime,
+                    recording.iGenreType, recording.iGenreSubType, recording.iPlayCount,
+                    recording.iLastPlayedPosition, recording.iChannelUid,
+                    static_cast<int>(recording.bIsDeleted),
+                    static_cast<int>(recording.channelType)})
+    combine(std::hash<int>()(value));
+  combine(std::hash<time_t>()(recording.recordingTime));
+  combine(std::hash<unsigned int>()(recording.iEpgEventId));
+  return hash;
+}
+} // unnamed namespace
+
 CPVRRecordingUid::CPVRRecordingUid(int iClientId, const std::string& strRecordingId) :
   m_iClientId(iClientId),
   m_strRecordingId(strRecordingId)
@@ -94,6 +120,7 @@ CPVRRecording::CPVRRecording(const PVR_RECORDING& recording, unsigned int iClien
   m_bIsDeleted = recording.bIsDeleted;
   m_iEpgEventId = recording.iEpgEventId;
   m_iChannelUid = recording.iChannelUid;
+  m_iClientDataHash = GetClientDataHash(recording);
 
   SetGenre(recording.iGenreType, recording.iGenreSubType, recording.strGenreDescription);
   CVideoInfoTag::SetPlayCount(recording.iPlayCount);
@@ -212,6 +239,7 @@ void CPVRRecording::Reset()
   m_iEpisode = -1;
   m_iChannelUid = PVR_CHANNEL_INVALID_UID;
   m_bRadio = false;
+  m_iClientDataHash = 0;
 
   m_recordingTime.Reset();
   CVideoInfoTag::Reset();
@@ -327,6 +355,30 @@ void CPVRRecording::UpdateMetadata(CVideoDatabase& db)
   m_bGotMetaData = true;
 }
 
+void CPVRRecording::UpdateMetadata(const std::map<std::string, int>& playCounts,
+                                   const std::map<std::string, CBookmark>& resumePoints)
+{
+  if (m_bGotMetaData)
+    return;
+
+  const std::shared_ptr<CPVRClient> client = CServiceBroker::GetPVRManager().GetClient(m_iClientId);
+
+  if (!client || !client->GetClientCapabilities().SupportsRecordingsPlayCount())
+  {
+    const auto it = playCounts.find(m_strFileNameAndPath);
+    CVideoInfoTag::SetPlayCount(it != playCounts.end() ? it->second : 0);
+  }
+
+  if (!client || !client->GetClientCapabilities().SupportsRecordingsLastPlayedPosition())
+  {
+    const auto it = resumePoints.find(m_strFileNameAndPath);
+    if (it != resumePoints.end())
+      CVideoInfoTag::SetResumePoint(it->second);
+  }
+
+  m_bGotMetaData = true;
+}
+
 std::vector<PVR_EDL_ENTRY> CPVRRecording::GetEdl() const
 {
   std::vector<PVR_EDL_ENTRY> edls;
@@ -362,6 +414,7 @@ void CPVRRecording::Update(const CPVRRecording& tag)
   m_iEpgEventId = tag.m_iEpgEventId;
   m_iChannelUid = tag.m_iChannelUid;
   m_bRadio = tag.m_bRadio;
+  m_iClientDataHash = tag.m_iClientDataHash;
 
   CVideoInfoTag::SetPlayCount(tag.GetLocalPlayCount());
   CVideoInfoTag::SetResumePoint(tag.GetLocalResumePoint());
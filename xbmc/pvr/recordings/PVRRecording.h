@@ -29,6 +29,7 @@
 #include "video/Bookmark.h"
 #include "video/VideoInfoTag.h"
 
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -177,6 +178,21 @@ namespace PVR
      */
     void UpdateMetadata(CVideoDatabase& db);
 
+    /*!
+     * @brief Set the resume point and play count from values obtained from the database in bulk
+     * if the client doesn't handle it itself.
+     * @param playCounts Play counts, by file path.
+     * @param resumePoints Resume points, by file path.
+     */
+    void UpdateMetadata(const std::map<std::string, int>& playCounts,
+                        const std::map<std::string, CBookmark>& resumePoints);
+
+    /*!
+     * @brief Get a hash of the data the client transferred for this recording.
+     * @return The hash, equal for recordings the client transferred the same data for.
+     */
+    size_t ClientDataHash() const { return m_iClientDataHash; }
+
     /*!
      * @brief Update this tag with the contents of the given tag.
      * @param tag The new tag info.
@@ -327,6 +343,7 @@ namespace PVR
     int m_iGenreType = 0; /*!< genre type */
     int m_iGenreSubType = 0; /*!< genre subtype */
     mutable XbmcThreads::EndTime m_resumePointRefetchTimeout;
+    size_t m_iClientDataHash = 0; /*!< hash of the data transferred by the client */
 
     void UpdatePath();
   };
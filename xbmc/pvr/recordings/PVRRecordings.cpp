@@ -15,11 +15,15 @@
 #include "pvr/recordings/PVRRecording.h"
 #include "pvr/recordings/PVRRecordingsPath.h"
 #include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
 #include "utils/URIUtils.h"
 #include "utils/log.h"
 #include "video/VideoDatabase.h"
 
+#include <algorithm>
+#include <map>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -33,12 +37,142 @@ CPVRRecordings::~CPVRRecordings()
     m_database->Close();
 }
 
-void CPVRRecordings::UpdateFromClients()
+namespace
 {
+// below this number of recordings, looking up their metadata one by one is faster than in bulk
+constexpr size_t BULK_METADATA_THRESHOLD = 16;
+} // unnamed namespace
+
+bool CPVRRecordings::UpdateFromClients()
+{
+  // obtain the recordings without holding the lock, so the current ones stay readable meanwhile
+  CPVRRecordings newRecordings;
+  std::vector<int> failedClients;
+  std::vector<int> failedClientsDeleted;
+  CServiceBroker::GetPVRManager().Clients()->GetRecordings(&newRecordings, false, failedClients);
+  CServiceBroker::GetPVRManager().Clients()->GetRecordings(&newRecordings, true, failedClientsDeleted);
+
+  // each call resets its list of failed clients; a client failing either call keeps its recordings
+  for (int iClientId : failedClientsDeleted)
+  {
+    if (std::find(failedClients.begin(), failedClients.end(), iClientId) == failedClients.end())
+      failedClients.emplace_back(iClientId);
+  }
+
+  return UpdateEntries(newRecordings, failedClients);
+}
+
+bool CPVRRecordings::UpdateEntries(const CPVRRecordings& newRecordings,
+                                   const std::vector<int>& failedClients)
+{
+  const unsigned int iStart = XbmcThreads::SystemClockMillis();
+
+  // only new recordings and those whose client data changed need to be updated
+  std::vector<std::shared_ptr<CPVRRecording>> changedRecordings;
+  {
+    CSingleLock lock(m_critSection);
+    for (const auto& newRecording : newRecordings.m_recordings)
+    {
+      const auto it = m_recordings.find(newRecording.first);
+      if (it == m_recordings.end() ||
+          it->second->ClientDataHash() != newRecording.second->ClientDataHash())
+        changedRecordings.emplace_back(newRecording.second);
+    }
+  }
+
+  UpdateMetadata(changedRecordings);
+
   CSingleLock lock(m_critSection);
-  Unload();
-  CServiceBroker::GetPVRManager().Clients()->GetRecordings(this, false);
-  CServiceBroker::GetPVRManager().Clients()->GetRecordings(this, true);
+  for (const auto& recording : changedRecordings)
+  {
+    const CPVRRecordingUid uid(recording->m_iClientId, recording->m_strRecordingId);
+    const auto it = m_recordings.find(uid);
+    if (it == m_recordings.end())
+    {
+      recording->m_iRecordingId = ++m_iLastId;
+      m_recordings.insert(std::make_pair(uid, recording));
+      m_recordingsSnapshot.Invalidate();
+    }
+    else
+    {
+      it->second->Update(*recording);
+    }
+  }
+
+  size_t iRemoved = 0;
+  for (auto it = m_recordings.begin(); it != m_recordings.end();)
+  {
+    if (newRecordings.m_recordings.find(it->first) == newRecordings.m_recordings.end() &&
+        std::find(failedClients.begin(), failedClients.end(), it->second->ClientID()) == failedClients.end())
+    {
+      it = m_recordings.erase(it);
+      m_recordingsSnapshot.Invalidate();
+      ++iRemoved;
+    }
+    else
+    {
+      ++it;
+    }
+  }
+
+  m_bDeletedTVRecordings = false;
+  m_bDeletedRadioRecordings = false;
+  m_iTVRecordings = 0;
+  m_iRadioRecordings = 0;
+  for (const auto& recording : m_recordings)
+  {
+    if (recording.second->IsRadio())
+    {
+      ++m_iRadioRecordings;
+      m_bDeletedRadioRecordings |= recording.second->IsDeleted();
+    }
+    else
+    {
+      ++m_iTVRecordings;
+      m_bDeletedTVRecordings |= recording.second->IsDeleted();
+    }
+  }
+
+  CLog::LogFC(LOGDEBUG, LOGPVR,
+              "Updated recordings in %u ms: %zu received, %zu new or changed, %zu removed",
+              XbmcThreads::SystemClockMillis() - iStart, newRecordings.m_recordings.size(),
+              changedRecordings.size(), iRemoved);
+
+  return !changedRecordings.empty() || iRemoved > 0;
+}
+
+void CPVRRecordings::UpdateMetadata(const std::vector<std::shared_ptr<CPVRRecording>>& recordings)
+{
+  if (recordings.empty())
+    return;
+
+  // the recordings are not yet visible to others, use a database connection of our own, so the
+  // lock is not needed
+  CVideoDatabase db;
+  if (!db.Open())
+  {
+    CLog::LogF(LOGERROR, "Failed to open the video database");
+    return;
+  }
+
+  if (recordings.size() < BULK_METADATA_THRESHOLD)
+  {
+    for (const auto& recording : recordings)
+      recording->UpdateMetadata(db);
+  }
+  else
+  {
+    std::map<std::string, int> playCounts;
+    std::map<std::string, CBookmark> resumePoints;
+    if (db.GetPlayCountsAndResumePoints(CPVRRecordingsPath::PATH_RECORDINGS, playCounts,
+                                        resumePoints))
+    {
+      for (const auto& recording : recordings)
+        recording->UpdateMetadata(playCounts, resumePoints);
+    }
+  }
+
+  db.Close();
 }
 
 int CPVRRecordings::Load()
@@ -56,6 +190,7 @@ void CPVRRecordings::Unload()
   m_iTVRecordings = 0;
   m_iRadioRecordings = 0;
   m_recordings.clear();
+  m_recordingsSnapshot.Invalidate();
 }
 
 void CPVRRecordings::Update()
@@ -67,13 +202,14 @@ void CPVRRecordings::Update()
   lock.Leave();
 
   CLog::LogFC(LOGDEBUG, LOGPVR, "Updating recordings");
-  UpdateFromClients();
+  const bool bChanged = UpdateFromClients();
 
   lock.Enter();
   m_bIsUpdating = false;
   lock.Leave();
 
-  CServiceBroker::GetPVRManager().PublishEvent(PVREvent::RecordingsInvalidated);
+  if (bChanged)
+    CServiceBroker::GetPVRManager().PublishEvent(PVREvent::RecordingsInvalidated);
 }
 
 int CPVRRecordings::GetNumTVRecordings() const
@@ -102,15 +238,15 @@ bool CPVRRecordings::HasDeletedRadioRecordings() const
 
 std::vector<std::shared_ptr<CPVRRecording>> CPVRRecordings::GetAll() const
 {
-  std::vector<std::shared_ptr<CPVRRecording>> recordings;
-
-  CSingleLock lock(m_critSection);
-  for (const auto& recordingEntry : m_recordings)
-  {
-    recordings.emplace_back(recordingEntry.second);
-  }
-
-  return recordings;
+  return *m_recordingsSnapshot.Get(m_critSection, [this]() {
+    std::vector<std::shared_ptr<CPVRRecording>> recordings;
+    recordings.reserve(m_recordings.size());
+    for (const auto& recordingEntry : m_recordings)
+    {
+      recordings.emplace_back(recordingEntry.second);
+    }
+    return recordings;
+  });
 }
 
 std::shared_ptr<CPVRRecording> CPVRRecordings::GetById(unsigned int iId) const
@@ -182,9 +318,9 @@ void CPVRRecordings::UpdateFromClient(const std::shared_ptr<CPVRRecording>& tag)
   {
     newTag = std::shared_ptr<CPVRRecording>(new CPVRRecording);
     newTag->Update(*tag);
-    newTag->UpdateMetadata(GetVideoDatabase());
     newTag->m_iRecordingId = ++m_iLastId;
     m_recordings.insert(std::make_pair(CPVRRecordingUid(newTag->m_iClientId, newTag->m_strRecordingId), newTag));
+    m_recordingsSnapshot.Invalidate();
     if (newTag->IsRadio())
       ++m_iRadioRecordings;
     else
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "pvr/PVRItemsSnapshot.h"
 #include "threads/CriticalSection.h"
 
 #include <map>
@@ -85,10 +86,21 @@ namespace PVR
      */
     std::shared_ptr<CPVRRecording> GetRecordingForEpgTag(const std::shared_ptr<CPVREpgInfoTag>& epgTag) const;
 
+  protected:
+    /*!
+     * @brief Merge the given recordings into the current ones. Recordings whose client data did
+     * not change are left as they are, recordings of failed clients are kept.
+     * @param newRecordings The recordings obtained from the clients.
+     * @param failedClients The ids of the clients the recordings could not be obtained from.
+     * @return True if any recording was added, changed or removed, false otherwise.
+     */
+    bool UpdateEntries(const CPVRRecordings& newRecordings, const std::vector<int>& failedClients);
+
   private:
     mutable CCriticalSection m_critSection;
     bool m_bIsUpdating = false;
     std::map<CPVRRecordingUid, std::shared_ptr<CPVRRecording>> m_recordings;
+    mutable CPVRItemsSnapshot<CPVRRecording> m_recordingsSnapshot{"Recordings"}; /*!< copy of m_recordings, must be invalidated whenever m_recordings changes */
     unsigned int m_iLastId = 0;
     std::unique_ptr<CVideoDatabase> m_database;
     bool m_bDeletedTVRecordings = false;
@@ -96,7 +108,17 @@ namespace PVR
     unsigned int m_iTVRecordings = 0;
     unsigned int m_iRadioRecordings = 0;
 
-    void UpdateFromClients();
+    /*!
+     * @brief Get the recordings from the clients and merge them into the current ones.
+     * @return True if any recording was added, changed or removed, false otherwise.
+     */
+    bool UpdateFromClients();
+
+    /*!
+     * @brief Get the resume points and play counts of the given recordings from the database.
+     * @param recordings The recordings.
+     */
+    void UpdateMetadata(const std::vector<std::shared_ptr<CPVRRecording>>& recordings);
 
     /*!
      * @brief Get/Open the video database.
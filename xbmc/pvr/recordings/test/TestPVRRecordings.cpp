@@ -0,0 +1,74 @@
+/*
+ *  Copyright (C) 2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "pvr/recordings/PVRRecording.h"
+#include "pvr/recordings/PVRRecordings.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace PVR;
+
+namespace
+{
+class CTestPVRRecordings : public CPVRRecordings
+{
+public:
+  void Add(int iClientId, const std::string& strRecordingId)
+  {
+    const std::shared_ptr<CPVRRecording> recording = std::make_shared<CPVRRecording>();
+    recording->m_iClientId = iClientId;
+    recording->m_strRecordingId = strRecordingId;
+    UpdateFromClient(recording);
+  }
+
+  using CPVRRecordings::UpdateEntries;
+};
+} // unnamed namespace
+
+TEST(TestPVRRecordings, UpdateEntriesRemovesMissingRecordings)
+{
+  CTestPVRRecordings recordings;
+  recordings.Add(1, "a");
+  recordings.Add(1, "b");
+
+  CTestPVRRecordings newRecordings;
+  newRecordings.Add(1, "a");
+
+  EXPECT_TRUE(recordings.UpdateEntries(newRecordings, {}));
+  EXPECT_TRUE(recordings.GetById(1, "a"));
+  EXPECT_FALSE(recordings.GetById(1, "b"));
+  EXPECT_EQ(1, recordings.GetNumTVRecordings());
+
+  // nothing changed
+  EXPECT_FALSE(recordings.UpdateEntries(newRecordings, {}));
+}
+
+TEST(TestPVRRecordings, UpdateEntriesKeepsRecordingsOfFailedClients)
+{
+  CTestPVRRecordings recordings;
+  recordings.Add(1, "a");
+  recordings.Add(1, "deleted");
+  recordings.Add(2, "b");
+  recordings.Add(2, "c");
+
+  // client 1 failed to deliver its recordings, but delivered its deleted recordings
+  CTestPVRRecordings newRecordings;
+  newRecordings.Add(1, "deleted");
+  newRecordings.Add(2, "b");
+
+  EXPECT_TRUE(recordings.UpdateEntries(newRecordings, {1}));
+  EXPECT_TRUE(recordings.GetById(1, "a"));
+  EXPECT_TRUE(recordings.GetById(1, "deleted"));
+  EXPECT_TRUE(recordings.GetById(2, "b"));
+  EXPECT_FALSE(recordings.GetById(2, "c"));
+  EXPECT_EQ(3, recordings.GetNumTVRecordings());
+}
@@ -12,9 +12,34 @@
 #include "pvr/epg/EpgInfoTag.h"
 #include "pvr/timers/PVRTimerInfoTag.h"
 #include "utils/RegExp.h"
+#include "utils/StringUtils.h"
+
+#include <algorithm>
+#include <cstring>
 
 using namespace PVR;
 
+namespace
+{
+  bool IsPlainAsciiText(const std::string& str)
+  {
+    return !str.empty() &&
+           std::none_of(str.begin(), str.end(), [](char c) {
+             return static_cast<unsigned char>(c) >= 0x80 || std::strchr("\\^$.|?*+()[]{}", c) != nullptr;
+           });
+  }
+
+  // length of the title keys of the rule index; search texts must be at least this long to be keyed
+  constexpr size_t TITLE_KEY_LENGTH = 3;
+
+  int GetWeekdayIndex(const CDateTime& localTime)
+  {
+    // 0 = monday ... 6 = sunday, like the PVR_WEEKDAY_* bits
+    const int iDayOfWeek = localTime.GetDayOfWeek();
+    return iDayOfWeek == 0 ? 6 : iDayOfWeek - 1;
+  }
+} // unnamed namespace
+
 CPVRTimerRuleMatcher::CPVRTimerRuleMatcher(const std::shared_ptr<CPVRTimerInfoTag>& timerRule, const CDateTime& start)
 : m_timerRule(timerRule),
   m_start(CPVRTimerInfoTag::ConvertUTCToLocalTime(start))
@@ -177,25 +202,128 @@ bool CPVRTimerRuleMatcher::MatchSearchText(const std::shared_ptr<CPVREpgInfoTag>
   if (m_timerRule->GetTimerType()->SupportsEpgFulltextMatch() &&
       m_timerRule->m_bFullTextEpgSearch)
   {
-    if (!m_textSearch)
-    {
-      m_textSearch.reset(new CRegExp(true /* case insensitive */));
-      m_textSearch->RegComp(m_timerRule->m_strEpgSearchString);
-    }
-    return m_textSearch->RegFind(epgTag->Title()) >= 0 ||
-           m_textSearch->RegFind(epgTag->EpisodeName()) >= 0 ||
-           m_textSearch->RegFind(epgTag->PlotOutline()) >= 0 ||
-           m_textSearch->RegFind(epgTag->Plot()) >= 0;
+    return FindSearchText(epgTag->Title()) ||
+           FindSearchText(epgTag->EpisodeName()) ||
+           FindSearchText(epgTag->PlotOutline()) ||
+           FindSearchText(epgTag->Plot());
   }
   else if (m_timerRule->GetTimerType()->SupportsEpgTitleMatch())
   {
-    if (!m_textSearch)
+    return FindSearchText(epgTag->Title());
+  }
+  else
+    return true;
+}
+
+bool CPVRTimerRuleMatcher::FindSearchText(const std::string& text) const
+{
+  if (!m_textSearch && m_strPlainSearchText.empty())
+  {
+    // most search strings are just words; no need to run a regular expression for them
+    if (IsPlainAsciiText(m_timerRule->m_strEpgSearchString))
+    {
+      m_strPlainSearchText = m_timerRule->m_strEpgSearchString;
+      StringUtils::ToLower(m_strPlainSearchText);
+    }
+    else
     {
       m_textSearch.reset(new CRegExp(true /* case insensitive */));
       m_textSearch->RegComp(m_timerRule->m_strEpgSearchString);
     }
-    return m_textSearch->RegFind(epgTag->Title()) >= 0;
   }
+
+  if (m_textSearch)
+    return m_textSearch->RegFind(text) >= 0;
+
+  std::string lowerCaseText(text);
+  StringUtils::ToLower(lowerCaseText);
+  return lowerCaseText.find(m_strPlainSearchText) != std::string::npos;
+}
+
+void CPVRTimerRuleMatcherIndex::Add(const std::shared_ptr<CPVRTimerRuleMatcher>& matcher)
+{
+  // same rules as CPVRTimerRuleMatcher::MatchChannel and MatchDayOfWeek
+  const std::shared_ptr<CPVRTimerInfoTag> rule = matcher->GetTimerRule();
+  const std::shared_ptr<CPVRTimerType> type = rule->GetTimerType();
+
+  WeekdayBuckets* buckets = nullptr;
+  if ((type->SupportsAnyChannel() && rule->m_iClientChannelUid == PVR_CHANNEL_INVALID_UID) ||
+      !type->SupportsChannels())
+    buckets = &m_anyChannelMatchers;
+  else if (rule->m_iClientChannelUid != PVR_CHANNEL_INVALID_UID)
+    buckets = &m_channelMatchers[{rule->m_iClientId, rule->m_iClientChannelUid}];
   else
-    return true;
+    return; // rule requires a channel, but has none
+
+  // same rules as CPVRTimerRuleMatcher::MatchSearchText and FindSearchText. A rule searching a
+  // plain text in the title only can only match titles containing the start of its search text.
+  std::string strTitleKey;
+  if (type->SupportsEpgTitleMatch() &&
+      !(type->SupportsEpgFulltextMatch() && rule->m_bFullTextEpgSearch) &&
+      rule->m_strEpgSearchString.size() >= TITLE_KEY_LENGTH &&
+      IsPlainAsciiText(rule->m_strEpgSearchString))
+  {
+    strTitleKey = rule->m_strEpgSearchString.substr(0, TITLE_KEY_LENGTH);
+    StringUtils::ToLower(strTitleKey);
+  }
+
+  const unsigned int iWeekdays = type->SupportsWeekdays() ? rule->m_iWeekdays : PVR_WEEKDAY_ALLDAYS;
+  for (int i = 0; i < 7; ++i)
+  {
+    if (iWeekdays & (1 << i))
+    {
+      if (strTitleKey.empty())
+        (*buckets)[i].m_matchers.emplace_back(matcher);
+      else
+        (*buckets)[i].m_titleMatchers[strTitleKey].emplace_back(matcher);
+    }
+  }
+
+  m_iSize++;
+}
+
+void CPVRTimerRuleMatcherIndex::GetCandidates(const std::shared_ptr<CPVREpgInfoTag>& epgTag,
+                                              std::vector<std::shared_ptr<CPVRTimerRuleMatcher>>& matchers) const
+{
+  const int iWeekday = GetWeekdayIndex(CPVRTimerInfoTag::ConvertUTCToLocalTime(epgTag->StartAsUTC()));
+
+  const auto it = m_channelMatchers.find({epgTag->ClientID(), epgTag->UniqueChannelID()});
+  const Bucket* channelBucket = it != m_channelMatchers.end() ? &it->second[iWeekday] : nullptr;
+  const Bucket& anyChannelBucket = m_anyChannelMatchers[iWeekday];
+
+  // distinct keys of the title, so that every matcher is returned only once
+  std::vector<std::string> titleKeys;
+  if ((channelBucket && !channelBucket->m_titleMatchers.empty()) ||
+      !anyChannelBucket.m_titleMatchers.empty())
+  {
+    std::string strTitle = epgTag->Title();
+    StringUtils::ToLower(strTitle);
+    for (size_t i = 0; i + TITLE_KEY_LENGTH <= strTitle.size(); ++i)
+      titleKeys.emplace_back(strTitle.substr(i, TITLE_KEY_LENGTH));
+
+    std::sort(titleKeys.begin(), titleKeys.end());
+    titleKeys.erase(std::unique(titleKeys.begin(), titleKeys.end()), titleKeys.end());
+  }
+
+  if (channelBucket)
+    GetCandidates(*channelBucket, titleKeys, matchers);
+
+  GetCandidates(anyChannelBucket, titleKeys, matchers);
+}
+
+void CPVRTimerRuleMatcherIndex::GetCandidates(const Bucket& bucket,
+                                              const std::vector<std::string>& titleKeys,
+                                              Matchers& matchers)
+{
+  matchers.insert(matchers.end(), bucket.m_matchers.begin(), bucket.m_matchers.end());
+
+  if (bucket.m_titleMatchers.empty())
+    return;
+
+  for (const auto& key : titleKeys)
+  {
+    const auto it = bucket.m_titleMatchers.find(key);
+    if (it != bucket.m_titleMatchers.end())
+      matchers.insert(matchers.end(), it->second.begin(), it->second.end());
+  }
 }
@@ -10,7 +10,12 @@
 
 #include "XBDateTime.h"
 
+#include <array>
+#include <map>
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 class CRegExp;
 
@@ -39,9 +44,55 @@ namespace PVR
     bool MatchEnd(const std::shared_ptr<CPVREpgInfoTag>& epgTag) const;
     bool MatchDayOfWeek(const std::shared_ptr<CPVREpgInfoTag>& epgTag) const;
     bool MatchSearchText(const std::shared_ptr<CPVREpgInfoTag>& epgTag) const;
+    bool FindSearchText(const std::string& text) const;
 
     const std::shared_ptr<CPVRTimerInfoTag> m_timerRule;
     CDateTime m_start;
     mutable std::unique_ptr<CRegExp> m_textSearch;
+    mutable std::string m_strPlainSearchText; /*!< lower case search text, if it is no regular expression */
+  };
+
+  /*!
+   * @brief Index of timer rule matchers by channel and weekday, to test an EPG tag only against
+   * the rules that may match it. Rules matching a plain search text against the title only are
+   * further indexed by the first characters of their search text, which every matching title
+   * contains.
+   */
+  class CPVRTimerRuleMatcherIndex
+  {
+  public:
+    /*!
+     * @brief Add a matcher to the index. Matchers that can't match any tag are dropped.
+     * @param matcher The matcher.
+     */
+    void Add(const std::shared_ptr<CPVRTimerRuleMatcher>& matcher);
+
+    /*!
+     * @brief Get the matchers whose channel and weekday fit the given tag.
+     * @param epgTag The tag.
+     * @param matchers Filled with the matchers; still to be checked with CPVRTimerRuleMatcher::Matches.
+     */
+    void GetCandidates(const std::shared_ptr<CPVREpgInfoTag>& epgTag,
+                       std::vector<std::shared_ptr<CPVRTimerRuleMatcher>>& matchers) const;
+
+    size_t Size() const { return m_iSize; }
+
+  private:
+    using Matchers = std::vector<std::shared_ptr<CPVRTimerRuleMatcher>>;
+
+    struct Bucket
+    {
+      Matchers m_matchers; /*!< candidates for every tag */
+      std::map<std::string, Matchers> m_titleMatchers; /*!< by the title key of their search text */
+    };
+    using WeekdayBuckets = std::array<Bucket, 7>;
+
+    static void GetCandidates(const Bucket& bucket,
+                              const std::vector<std::string>& titleKeys,
+                              Matchers& matchers);
+
+    std::map<std::pair<int, int>, WeekdayBuckets> m_channelMatchers; /*!< by client id and channel uid */
+    WeekdayBuckets m_anyChannelMatchers;
+    size_t m_iSize = 0;
   };
 }
@@ -22,11 +22,14 @@
 #include "pvr/timers/PVRTimerRuleMatcher.h"
 #include "settings/Settings.h"
 #include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
 #include "utils/log.h"
 
 #include <algorithm>
+#include <functional>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -76,6 +79,8 @@ void CPVRTimersContainer::InsertEntry(const std::shared_ptr<CPVRTimerInfoTag>& n
   {
     it->second.emplace_back(newTimer);
   }
+
+  m_timersSnapshot.Invalidate();
 }
 
 CPVRTimers::CPVRTimers()
@@ -114,6 +119,7 @@ void CPVRTimers::Unload()
   // remove all tags
   CSingleLock lock(m_critSection);
   m_tags.clear();
+  m_timersSnapshot.Invalidate();
 }
 
 bool CPVRTimers::Update()
@@ -191,6 +197,7 @@ void CPVRTimers::RemoveEntry(const std::shared_ptr<CPVRTimerInfoTag>& tag)
                                       tag->m_iClientIndex == timer->m_iClientIndex;
                                     }),
                      it->second.end());
+    m_timersSnapshot.Invalidate();
 
     if (it->second.empty())
       m_tags.erase(it);
@@ -290,6 +297,7 @@ bool CPVRTimers::UpdateEntries(const CPVRTimersContainer& timers, const std::vec
         timerNotifications.emplace_back(timer->m_iClientId, timer->GetDeletedNotificationText());
 
         it2 = it->second.erase(it2);
+        m_timersSnapshot.Invalidate();
 
         bChanged = true;
         bAddedOrDeleted = true;
@@ -306,6 +314,7 @@ bool CPVRTimers::UpdateEntries(const CPVRTimersContainer& timers, const std::vec
 
         /* remove timer for now, reinsert later */
         it2 = it->second.erase(it2);
+        m_timersSnapshot.Invalidate();
 
         bChanged = true;
         bAddedOrDeleted = true;
@@ -416,51 +425,48 @@ namespace
     return matches;
   }
 
-  void AddTimerRuleToEpgMap(const std::shared_ptr<CPVRTimerInfoTag>& timer,
-                            const CDateTime& now,
-                            std::map<std::shared_ptr<CPVREpg>, std::vector<std::shared_ptr<CPVRTimerRuleMatcher>>>& epgMap,
-                            bool& bFetchedAllEpgs)
+  void AddTimerRuleToIndex(const std::shared_ptr<CPVRTimerInfoTag>& timer,
+                           const CDateTime& now,
+                           std::set<std::shared_ptr<CPVREpg>>& epgs,
+                           CPVRTimerRuleMatcherIndex& index,
+                           bool& bFetchedAllEpgs)
   {
     const std::shared_ptr<CPVRChannel> channel = timer->Channel();
     if (channel)
     {
       const std::shared_ptr<CPVREpg> epg = channel->GetEPG();
-      if (epg)
-      {
-        const std::shared_ptr<CPVRTimerRuleMatcher> matcher = std::make_shared<CPVRTimerRuleMatcher>(timer, now);
-        auto it = epgMap.find(epg);
-        if (it == epgMap.end())
-          epgMap.insert({epg, {matcher}});
-        else
-          it->second.emplace_back(matcher);
-      }
+      if (!epg)
+        return;
+
+      epgs.insert(epg);
     }
-    else
+    else if (!bFetchedAllEpgs)
     {
       // rule matches "any channel" => we need to check all channels
-      if (!bFetchedAllEpgs)
-      {
-        const std::vector<std::shared_ptr<CPVREpg>> epgs = CServiceBroker::GetPVRManager().EpgContainer().GetAllEpgs();
-        for (const auto& epg : epgs)
-        {
-          const std::shared_ptr<CPVRTimerRuleMatcher> matcher = std::make_shared<CPVRTimerRuleMatcher>(timer, now);
-          auto it = epgMap.find(epg);
-          if (it == epgMap.end())
-            epgMap.insert({epg, {matcher}});
-          else
-            it->second.emplace_back(matcher);
-        }
-        bFetchedAllEpgs = true;
-      }
-      else
-      {
-        for (auto& epgMapEntry : epgMap)
-        {
-          const std::shared_ptr<CPVRTimerRuleMatcher> matcher = std::make_shared<CPVRTimerRuleMatcher>(timer, now);
-          epgMapEntry.second.emplace_back(matcher);
-        }
-      }
+      const std::vector<std::shared_ptr<CPVREpg>> allEpgs = CServiceBroker::GetPVRManager().EpgContainer().GetAllEpgs();
+      epgs.insert(allEpgs.begin(), allEpgs.end());
+      bFetchedAllEpgs = true;
     }
+
+    index.Add(std::make_shared<CPVRTimerRuleMatcher>(timer, now));
+  }
+
+  size_t GetEpgTagMatchHash(const std::shared_ptr<CPVREpgInfoTag>& tag)
+  {
+    // covers everything CPVRTimerRuleMatcher::Matches looks at
+    time_t start, end;
+    tag->StartAsUTC().GetAsTime(start);
+    tag->EndAsUTC().GetAsTime(end);
+
+    size_t hash = std::hash<time_t>()(start);
+    const auto combine = [&hash](size_t value) { hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2); };
+    combine(std::hash<time_t>()(end));
+    combine(std::hash<std::string>()(tag->Title()));
+    combine(std::hash<std::string>()(tag->EpisodeName()));
+    combine(std::hash<std::string>()(tag->PlotOutline()));
+    combine(std::hash<std::string>()(tag->Plot()));
+    combine(std::hash<std::string>()(tag->SeriesLink()));
+    return hash;
   }
 } // unnamed namespace
 
@@ -471,7 +477,8 @@ bool CPVRTimers::UpdateEntries(int iMaxNotificationDelay)
   bool bChanged = false;
   const CDateTime now = CDateTime::GetUTCDateTime();
   bool bFetchedAllEpgs = false;
-  std::map<std::shared_ptr<CPVREpg>, std::vector<std::shared_ptr<CPVRTimerRuleMatcher>>> epgMap;
+  std::set<std::shared_ptr<CPVREpg>> ruleEpgs;
+  CPVRTimerRuleMatcherIndex ruleIndex;
 
   CSingleLock lock(m_critSection);
 
@@ -550,7 +557,7 @@ bool CPVRTimers::UpdateEntries(int iMaxNotificationDelay)
           if (timer->IsEpgBased())
           {
             if (m_bReminderRulesUpdatePending)
-              AddTimerRuleToEpgMap(timer, now, epgMap, bFetchedAllEpgs);
+              AddTimerRuleToIndex(timer, now, ruleEpgs, ruleIndex, bFetchedAllEpgs);
           }
           else
           {
@@ -592,6 +599,7 @@ bool CPVRTimers::UpdateEntries(int iMaxNotificationDelay)
           parent->UpdateChildState(timer, false);
 
         it2 = it->second.erase(it2);
+        m_timersSnapshot.Invalidate();
       }
       else
       {
@@ -606,27 +614,72 @@ bool CPVRTimers::UpdateEntries(int iMaxNotificationDelay)
   }
 
   // create new children of local epg-based reminder timer rules
-  for (const auto& epgMapEntry : epgMap)
+  if (ruleIndex.Size() > 0)
   {
-    const auto epgTags = epgMapEntry.first->GetTags();
-    for (const auto& epgTag : epgTags)
-    {
-      if (GetTimerForEpgTag(epgTag))
-        continue;
+    const unsigned int iStart = XbmcThreads::SystemClockMillis();
+
+    // tags that matched none of the rules and didn't change since can't match now
+    if (m_iReminderRulesVersion != m_iUnmatchedEpgTagsRulesVersion ||
+        ruleIndex.Size() != m_iUnmatchedEpgTagsRulesCount)
+      m_unmatchedEpgTags.clear();
 
-      for (const auto& matcher : epgMapEntry.second)
+    std::map<std::pair<int, unsigned int>, size_t> unmatchedEpgTags;
+    std::vector<std::shared_ptr<CPVRTimerRuleMatcher>> matchers;
+    size_t iTags = 0;
+    size_t iSkipped = 0;
+
+    for (const auto& epg : ruleEpgs)
+    {
+      const auto epgTags = epg->GetTags();
+      for (const auto& epgTag : epgTags)
       {
-        if (!matcher->Matches(epgTag))
+        iTags++;
+
+        const std::pair<int, unsigned int> key(epgTag->EpgID(), epgTag->UniqueBroadcastID());
+        const size_t iHash = GetEpgTagMatchHash(epgTag);
+        const auto it = m_unmatchedEpgTags.find(key);
+        if (it != m_unmatchedEpgTags.end() && it->second == iHash)
+        {
+          unmatchedEpgTags.insert({key, iHash});
+          iSkipped++;
           continue;
+        }
 
-        const std::shared_ptr<CPVRTimerInfoTag> childTimer = CPVRTimerInfoTag::CreateReminderFromEpg(epgTag, matcher->GetTimerRule());
-        if (childTimer)
+        matchers.clear();
+        ruleIndex.GetCandidates(epgTag, matchers);
+
+        bool bMatched = false;
+        for (const auto& matcher : matchers)
         {
-          bChanged = true;
-          childTimersToInsert.emplace_back(std::make_pair(matcher->GetTimerRule(), childTimer)); // remember and insert/save later
+          if (!matcher->Matches(epgTag))
+            continue;
+
+          if (!bMatched)
+          {
+            bMatched = true;
+            if (GetTimerForEpgTag(epgTag))
+              break;
+          }
+
+          const std::shared_ptr<CPVRTimerInfoTag> childTimer = CPVRTimerInfoTag::CreateReminderFromEpg(epgTag, matcher->GetTimerRule());
+          if (childTimer)
+          {
+            bChanged = true;
+            childTimersToInsert.emplace_back(std::make_pair(matcher->GetTimerRule(), childTimer)); // remember and insert/save later
+          }
         }
+
+        if (!bMatched)
+          unmatchedEpgTags.insert({key, iHash});
       }
     }
+
+    m_unmatchedEpgTags = std::move(unmatchedEpgTags);
+    m_iUnmatchedEpgTagsRulesVersion = m_iReminderRulesVersion;
+    m_iUnmatchedEpgTagsRulesCount = ruleIndex.Size();
+
+    CLog::LogFC(LOGDEBUG, LOGPVR, "Matched %zu reminder rules against %zu epg tags (%zu unchanged) in %u ms",
+                ruleIndex.Size(), iTags, iSkipped, XbmcThreads::SystemClockMillis() - iStart);
   }
 
   // reinsert timers with changed timer start
@@ -992,6 +1045,7 @@ bool CPVRTimers::UpdateTimer(const std::shared_ptr<CPVRTimerInfoTag>& tag)
 bool CPVRTimers::AddLocalTimer(const std::shared_ptr<CPVRTimerInfoTag>& tag, bool bNotify)
 {
   CSingleLock lock(m_critSection);
+  m_iReminderRulesVersion++;
 
   const std::shared_ptr<CPVRTimerInfoTag> persistedTimer = PersistAndUpdateLocalTimer(tag, nullptr);
   bool bReturn = !!persistedTimer;
@@ -1041,6 +1095,7 @@ bool CPVRTimers::AddLocalTimer(const std::shared_ptr<CPVRTimerInfoTag>& tag, boo
 bool CPVRTimers::DeleteLocalTimer(const std::shared_ptr<CPVRTimerInfoTag>& tag, bool bNotify)
 {
   CSingleLock lock(m_critSection);
+  m_iReminderRulesVersion++;
 
   RemoveEntry(tag);
 
@@ -1058,6 +1113,7 @@ bool CPVRTimers::DeleteLocalTimer(const std::shared_ptr<CPVRTimerInfoTag>& tag,
         {
           tag->UpdateChildState(timer, false);
           it2 = it->second.erase(it2);
+          m_timersSnapshot.Invalidate();
           timer->DeleteFromDatabase();
         }
         else
@@ -1294,18 +1350,17 @@ void CPVRTimers::UpdateChannels()
 
 std::vector<std::shared_ptr<CPVRTimerInfoTag>> CPVRTimers::GetAll() const
 {
-  std::vector<std::shared_ptr<CPVRTimerInfoTag>> timers;
-
-  CSingleLock lock(m_critSection);
-  for (const auto& tagsEntry : m_tags)
-  {
-    for (const auto& timer : tagsEntry.second)
+  return *m_timersSnapshot.Get(m_critSection, [this]() {
+    std::vector<std::shared_ptr<CPVRTimerInfoTag>> timers;
+    for (const auto& tagsEntry : m_tags)
     {
-      timers.emplace_back(timer);
+      for (const auto& timer : tagsEntry.second)
+      {
+        timers.emplace_back(timer);
+      }
     }
-  }
-
-  return timers;
+    return timers;
+  });
 }
 
 std::shared_ptr<CPVRTimerInfoTag> CPVRTimers::GetById(unsigned int iTimerId) const
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "XBDateTime.h"
+#include "pvr/PVRItemsSnapshot.h"
 #include "pvr/settings/PVRSettings.h"
 #include "threads/Thread.h"
 
@@ -60,6 +61,7 @@ namespace PVR
     mutable CCriticalSection m_critSection;
     unsigned int m_iLastId = 0;
     MapTags m_tags;
+    mutable CPVRItemsSnapshot<CPVRTimerInfoTag> m_timersSnapshot{"Timers"}; /*!< copy of all timers in m_tags, must be invalidated whenever m_tags changes */
   };
 
   class CPVRTimers : public CPVRTimersContainer, private CThread
@@ -297,5 +299,10 @@ namespace PVR
     CPVRSettings m_settings;
     std::queue<std::shared_ptr<CPVRTimerInfoTag>> m_remindersToAnnounce;
     bool m_bReminderRulesUpdatePending = false;
+
+    unsigned int m_iReminderRulesVersion = 0; /*!< changed whenever local timers are added or deleted */
+    std::map<std::pair<int, unsigned int>, size_t> m_unmatchedEpgTags; /*!< epg id and broadcast uid of tags matching no reminder rule, with their content hash */
+    unsigned int m_iUnmatchedEpgTagsRulesVersion = 0;
+    size_t m_iUnmatchedEpgTagsRulesCount = 0;
   };
 }
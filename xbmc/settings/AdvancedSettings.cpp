@@ -332,6 +332,8 @@ void CAdvancedSettings::Initialize()
   m_bEpgDisplayUpdatePopup = true; /* Display a progress popup while updating EPG data from clients */
   m_bEpgDisplayIncrementalUpdatePopup = false; /* Display a progress popup while doing incremental EPG updates, but
                                                   only if 'displayupdatepopup' is also enabled. */
+  m_iEpgMaxConcurrentRequestsPerClient = 1; /* EPGs of different clients are updated in parallel, but only this many
+                                               EPGs of the same client at a time */
 
   m_bEdlMergeShortCommBreaks = false;      // Off by default
   m_iEdlMaxCommBreakLength = 8 * 30 + 10;  // Just over 8 * 30 second commercial break.
@@ -380,6 +382,9 @@ void CAdvancedSettings::Initialize()
   m_iPVRNumericChannelSwitchTimeout = 2000;
   m_iPVRTimeshiftThreshold = 10;
   m_bPVRTimeshiftSimpleOSD = true;
+  m_bPVRPredictiveZap = false;
+  m_iPVRTimeshiftBufferSize = 0;
+  m_iPVRTimeshiftBufferMemory = 16;
 
   m_cacheMemSize = 1024 * 1024 * 20; // 20 MiB
   m_cacheBufferMode = CACHE_BUFFER_MODE_INTERNET; // Default (buffer all internet streams/filesystems)
@@ -387,9 +392,14 @@ void CAdvancedSettings::Initialize()
   // the following setting determines the readRate of a player data
   // as multiply of the default data read rate
   m_cacheReadFactor = 4.0f;
+  // number of parallel connections used to fill the cache from http sources
+  m_cacheParallelConnections = 1;
 
   m_addonPackageFolderSize = 200;
 
+  // number of python sub-interpreters created ahead of time, 0 to create them on demand
+  m_pythonInterpreterPoolSize = 0;
+
   m_jsonOutputCompact = true;
   m_jsonTcpPort = 9090;
 
@@ -825,8 +835,13 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetUInt(pElement, "buffermode", m_cacheBufferMode, 0, 4);
     XMLUtils::GetUInt(pElement, "chunksize", m_cacheChunkSize, 256, 1024 * 1024);
     XMLUtils::GetFloat(pElement, "readfactor", m_cacheReadFactor);
+    XMLUtils::GetUInt(pElement, "parallelconnections", m_cacheParallelConnections, 1, 8);
   }
 
+  pElement = pRootElement->FirstChildElement("python");
+  if (pElement)
+    XMLUtils::GetUInt(pElement, "interpreterpool", m_pythonInterpreterPoolSize, 0, 8);
+
   pElement = pRootElement->FirstChildElement("jsonrpc");
   if (pElement)
   {
@@ -906,6 +921,7 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetInt(pElement, "updateemptytagsinterval", m_iEpgUpdateEmptyTagsInterval);
     XMLUtils::GetBoolean(pElement, "displayupdatepopup", m_bEpgDisplayUpdatePopup);
     XMLUtils::GetBoolean(pElement, "displayincrementalupdatepopup", m_bEpgDisplayIncrementalUpdatePopup);
+    XMLUtils::GetInt(pElement, "maxconcurrentrequestsperclient", m_iEpgMaxConcurrentRequestsPerClient, 1, 16);
   }
 
   // EDL commercial break handling
@@ -1089,6 +1105,9 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetInt(pPVR, "numericchannelswitchtimeout", m_iPVRNumericChannelSwitchTimeout, 50, 60000);
     XMLUtils::GetInt(pPVR, "timeshiftthreshold", m_iPVRTimeshiftThreshold, 0, 60);
     XMLUtils::GetBoolean(pPVR, "timeshiftsimpleosd", m_bPVRTimeshiftSimpleOSD);
+    XMLUtils::GetBoolean(pPVR, "predictivezap", m_bPVRPredictiveZap);
+    XMLUtils::GetInt(pPVR, "timeshiftbuffersize", m_iPVRTimeshiftBufferSize, 0, 65536);
+    XMLUtils::GetInt(pPVR, "timeshiftbuffermemory", m_iPVRTimeshiftBufferMemory, 1, 1024);
   }
 
   TiXmlElement* pDatabase = pRootElement->FirstChildElement("videodatabase");
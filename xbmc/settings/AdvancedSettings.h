@@ -275,6 +275,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     int m_iEpgUpdateEmptyTagsInterval; // seconds
     bool m_bEpgDisplayUpdatePopup;
     bool m_bEpgDisplayIncrementalUpdatePopup;
+    int m_iEpgMaxConcurrentRequestsPerClient;
 
     // EDL Commercial Break
     bool m_bEdlMergeShortCommBreaks;
@@ -316,6 +317,9 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     int m_iPVRNumericChannelSwitchTimeout; /*!< @brief time in msecs after that a channel switch occurs after entering a channel number, if confirmchannelswitch is disabled */
     int m_iPVRTimeshiftThreshold; /*!< @brief time diff between current playing time and timeshift buffer end, in seconds, before a playing stream is displayed as timeshifting. */
     bool m_bPVRTimeshiftSimpleOSD; /*!< @brief use simple timeshift OSD (with progress only for the playing event instead of progress for the whole ts buffer). */
+    bool m_bPVRPredictiveZap; /*!< @brief obtain the stream properties of the channels next to the playing channel in advance and reuse the detected stream format to speed up channel switching. */
+    int m_iPVRTimeshiftBufferSize; /*!< @brief size in MB of the timeshift buffer for live streams the backend can neither pause nor seek. 0 disables the buffer. */
+    int m_iPVRTimeshiftBufferMemory; /*!< @brief size in MB of the part of the timeshift buffer held in memory, the rest is spilled to disk. */
     DatabaseSettings m_databaseMusic; // advanced music database setup
     DatabaseSettings m_databaseVideo; // advanced video database setup
     DatabaseSettings m_databaseTV;    // advanced tv database setup
@@ -330,6 +334,9 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     unsigned int m_cacheBufferMode;
     unsigned int m_cacheChunkSize;
     float m_cacheReadFactor;
+    unsigned int m_cacheParallelConnections;
+
+    unsigned int m_pythonInterpreterPoolSize;
 
     bool m_jsonOutputCompact;
     unsigned int m_jsonTcpPort;
@@ -11,18 +11,56 @@
 #include "Setting.h"
 #include "SettingDefinitions.h"
 #include "SettingSection.h"
+#include "threads/SystemClock.h"
 #include "utils/StringUtils.h"
 #include "utils/XBMCTinyXML.h"
 #include "utils/log.h"
 
 #include <algorithm>
 #include <map>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 
 const uint32_t CSettingsManager::Version = 2;
 const uint32_t CSettingsManager::MinimumSupportedVersion = 0;
 
+// Child elements of a settings node by tag name and <setting> elements by id,
+// so that deserializing doesn't search the whole node for every setting.
+struct CSettingsManager::SettingElementIndex
+{
+  explicit SettingElementIndex(const TiXmlNode* node)
+  {
+    for (auto element = node->FirstChildElement(); element != nullptr; element = element->NextSiblingElement())
+    {
+      // first match wins, like FirstChildElement()
+      children.emplace(element->ValueStr(), element);
+
+      if (element->ValueStr() == SETTING_XML_ELM_SETTING)
+      {
+        const auto id = element->Attribute(SETTING_XML_ATTR_ID);
+        if (id != nullptr)
+          settings.emplace(id, element);
+      }
+    }
+  }
+
+  const TiXmlElement* GetChild(const std::string& tag) const
+  {
+    const auto it = children.find(tag);
+    return it != children.end() ? it->second : nullptr;
+  }
+
+  const TiXmlElement* GetSetting(const std::string& id) const
+  {
+    const auto it = settings.find(id);
+    return it != settings.end() ? it->second : nullptr;
+  }
+
+  std::unordered_map<std::string, const TiXmlElement*> children;
+  std::unordered_map<std::string, const TiXmlElement*> settings;
+};
+
 bool ParseSettingIdentifier(const std::string& settingId, std::string& categoryTag, std::string& settingTag)
 {
   static const std::string Separator = ".";
@@ -814,12 +852,15 @@ bool CSettingsManager::Deserialize(const TiXmlNode *node, bool &updated, std::ma
 
   CSharedLock lock(m_settingsCritical);
 
+  const auto start = XbmcThreads::SystemClockMillis();
+  const SettingElementIndex index(node);
+
   // TODO: ideally this would be done by going through all <setting> elements
   // in node but as long as we have to support the v1- format that's not possible
   for (auto& setting : m_settings)
   {
     bool settingUpdated = false;
-    if (LoadSetting(node, setting.second.setting, settingUpdated))
+    if (LoadSetting(node, setting.second.setting, settingUpdated, &index))
     {
       updated |= settingUpdated;
       if (loadedSettings != nullptr)
@@ -827,6 +868,9 @@ bool CSettingsManager::Deserialize(const TiXmlNode *node, bool &updated, std::ma
     }
   }
 
+  CLog::Log(LOGDEBUG, "CSettingsManager: loaded values of %zu settings in %u ms", m_settings.size(),
+            XbmcThreads::SystemClockMillis() - start);
+
   return true;
 }
 
@@ -1090,7 +1134,7 @@ bool CSettingsManager::Load(const TiXmlNode *settings)
   return ok;
 }
 
-bool CSettingsManager::LoadSetting(const TiXmlNode *node, SettingPtr setting, bool &updated)
+bool CSettingsManager::LoadSetting(const TiXmlNode *node, SettingPtr setting, bool &updated, const SettingElementIndex* index /* = nullptr */)
 {
   updated = false;
 
@@ -1109,25 +1153,40 @@ bool CSettingsManager::LoadSetting(const TiXmlNode *node, SettingPtr setting, bo
   std::string categoryTag, settingTag;
   if (ParseSettingIdentifier(settingId, categoryTag, settingTag))
   {
-    auto categoryNode = node;
-    if (!categoryTag.empty())
-      categoryNode = node->FirstChild(categoryTag);
+    if (index != nullptr)
+    {
+      if (categoryTag.empty())
+        settingElement = index->GetChild(settingTag);
+      else if (const auto categoryElement = index->GetChild(categoryTag))
+        settingElement = categoryElement->FirstChildElement(settingTag);
+    }
+    else
+    {
+      auto categoryNode = node;
+      if (!categoryTag.empty())
+        categoryNode = node->FirstChild(categoryTag);
 
-    if (categoryNode != nullptr)
-      settingElement = categoryNode->FirstChildElement(settingTag);
+      if (categoryNode != nullptr)
+        settingElement = categoryNode->FirstChildElement(settingTag);
+    }
   }
 
   if (settingElement == nullptr)
   {
     // check if the setting is stored using its full setting identifier (v2+)
-    settingElement = node->FirstChildElement(SETTING_XML_ELM_SETTING);
-    while (settingElement != nullptr)
+    if (index != nullptr)
+      settingElement = index->GetSetting(settingId);
+    else
     {
-      const auto id = settingElement->Attribute(SETTING_XML_ATTR_ID);
-      if (id != nullptr && settingId.compare(id) == 0)
-        break;
+      settingElement = node->FirstChildElement(SETTING_XML_ELM_SETTING);
+      while (settingElement != nullptr)
+      {
+        const auto id = settingElement->Attribute(SETTING_XML_ATTR_ID);
+        if (id != nullptr && settingId.compare(id) == 0)
+          break;
 
-      settingElement = settingElement->NextSiblingElement(SETTING_XML_ELM_SETTING);
+        settingElement = settingElement->NextSiblingElement(SETTING_XML_ELM_SETTING);
+      }
     }
   }
 
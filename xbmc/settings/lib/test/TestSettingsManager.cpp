@@ -0,0 +1,161 @@
+/*
+ *  Copyright (C) 2020 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "settings/lib/Setting.h"
+#include "settings/lib/SettingsManager.h"
+#include "utils/StringUtils.h"
+#include "utils/XBMCTinyXML.h"
+
+#include <chrono>
+#include <memory>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+// setting definitions of count settings of every type, internal so they don't need a control
+std::string GetDefinitions(int count)
+{
+  std::string xml = "<settings version=\"2\"><section id=\"test\"><category id=\"test\">"
+                    "<group id=\"1\">";
+  for (int i = 0; i < count; ++i)
+  {
+    xml += StringUtils::Format("<setting id=\"category.int%d\" type=\"integer\"><level>4</level>"
+                               "<default>0</default></setting>",
+                               i);
+    xml += StringUtils::Format("<setting id=\"category.bool%d\" type=\"boolean\"><level>4</level>"
+                               "<default>false</default></setting>",
+                               i);
+    xml += StringUtils::Format("<setting id=\"category.string%d\" type=\"string\"><level>4</level>"
+                               "<default>default</default></setting>",
+                               i);
+    xml += StringUtils::Format("<setting id=\"number%d\" type=\"number\"><level>4</level>"
+                               "<default>0.0</default></setting>",
+                               i);
+  }
+  xml += "</group></category></section></settings>";
+  return xml;
+}
+
+// stored values in all the layouts the settings manager reads: integers by their full
+// identifier (v2), booleans below their category (v1), strings in both layouts and numbers
+// without a category. Every third setting has no stored value, some values are duplicated.
+std::string GetValues(int count)
+{
+  std::string category;
+  std::string xml = "<settings version=\"2\">";
+  for (int i = 0; i < count; ++i)
+  {
+    if (i % 3 == 2)
+      continue;
+
+    xml += StringUtils::Format("<setting id=\"category.int%d\"%s>%d</setting>", i,
+                               i % 3 == 1 ? " default=\"true\"" : "", i + 1);
+    xml += StringUtils::Format("<setting id=\"category.string%d\">v2 %d</setting>", i, i);
+    xml += StringUtils::Format("<number%d>%d.5</number%d>", i, i, i);
+    category += StringUtils::Format("<bool%d>true</bool%d>", i, i);
+    category += StringUtils::Format("<string%d>v1 %d</string%d>", i, i, i);
+  }
+  xml += "<category>" + category + "</category>";
+  // later duplicates are ignored, also the ones in another element of the same category
+  xml += "<setting id=\"category.int0\">1000</setting>";
+  xml += "<category><bool2>true</bool2></category>";
+  xml += "</settings>";
+  return xml;
+}
+
+class TestSettingsManager : public ::testing::Test
+{
+protected:
+  std::unique_ptr<CSettingsManager> CreateManager(int count)
+  {
+    CXBMCTinyXML definitions;
+    definitions.Parse(GetDefinitions(count));
+
+    std::unique_ptr<CSettingsManager> manager(new CSettingsManager()); // C++14 - Replace with std::make_unique
+    EXPECT_TRUE(manager->Initialize(definitions.RootElement()));
+    manager->SetInitialized();
+    return manager;
+  }
+
+  std::vector<std::string> GetSettingIds(int count)
+  {
+    std::vector<std::string> ids;
+    for (int i = 0; i < count; ++i)
+    {
+      ids.emplace_back(StringUtils::Format("category.int%d", i));
+      ids.emplace_back(StringUtils::Format("category.bool%d", i));
+      ids.emplace_back(StringUtils::Format("category.string%d", i));
+      ids.emplace_back(StringUtils::Format("number%d", i));
+    }
+    return ids;
+  }
+};
+} // unnamed namespace
+
+TEST_F(TestSettingsManager, DeserializedValuesMatchLookup)
+{
+  const int count = 30;
+  CXBMCTinyXML values;
+  values.Parse(GetValues(count));
+
+  // all settings at once, through the element index
+  std::unique_ptr<CSettingsManager> indexed = CreateManager(count);
+  bool updated = false;
+  EXPECT_TRUE(indexed->Load(values.RootElement(), updated, false));
+
+  // one setting at a time, by searching the values
+  std::unique_ptr<CSettingsManager> searched = CreateManager(count);
+  for (const auto& id : GetSettingIds(count))
+    searched->LoadSetting(values.RootElement(), id);
+
+  for (const auto& id : GetSettingIds(count))
+  {
+    const std::shared_ptr<CSetting> setting = indexed->GetSetting(id);
+    ASSERT_NE(nullptr, setting) << id;
+    EXPECT_EQ(searched->GetSetting(id)->ToString(), setting->ToString()) << id;
+  }
+
+  EXPECT_EQ(1, indexed->GetInt("category.int0"));
+  EXPECT_EQ(0, indexed->GetInt("category.int1"));
+  EXPECT_EQ(4, indexed->GetInt("category.int3"));
+  EXPECT_TRUE(indexed->GetBool("category.bool0"));
+  EXPECT_FALSE(indexed->GetBool("category.bool2"));
+  EXPECT_FALSE(indexed->GetBool("category.bool5"));
+  EXPECT_EQ("v1 0", indexed->GetString("category.string0"));
+  EXPECT_EQ("default", indexed->GetString("category.string2"));
+  EXPECT_DOUBLE_EQ(3.5, indexed->GetNumber("number3"));
+}
+
+// Time to load the values of 4000 settings, all at once as on startup and one at a time by
+// searching the stored values as before. Run with --gtest_also_run_disabled_tests.
+TEST_F(TestSettingsManager, DISABLED_DeserializeBenchmark)
+{
+  const int count = 1000;
+  CXBMCTinyXML values;
+  values.Parse(GetValues(count));
+
+  std::unique_ptr<CSettingsManager> indexed = CreateManager(count);
+  auto start = std::chrono::steady_clock::now();
+  bool updated = false;
+  EXPECT_TRUE(indexed->Load(values.RootElement(), updated, false));
+  const double indexedTime =
+      std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+  std::unique_ptr<CSettingsManager> searched = CreateManager(count);
+  start = std::chrono::steady_clock::now();
+  for (const auto& id : GetSettingIds(count))
+    searched->LoadSetting(values.RootElement(), id);
+  const double searchedTime =
+      std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+  printf("%d settings: indexed %.1f ms, searched %.1f ms\n", count * 4, indexedTime, searchedTime);
+}
@@ -26,6 +26,11 @@ public:
   bool Search(const std::string &strHaystack) const;
   bool IsValid(void) const;
 
+  bool IsCaseSensitive(void) const { return m_bCaseSensitive; }
+  const std::vector<std::string>& GetAndTerms(void) const { return m_AND; }
+  const std::vector<std::string>& GetOrTerms(void) const { return m_OR; }
+  const std::vector<std::string>& GetNotTerms(void) const { return m_NOT; }
+
 private:
   static void GetAndCutNextTerm(std::string &strSearchTerm, std::string &strNextTerm);
   void ExtractSearchTerms(const std::string &strSearchTerm, TextSearchDefault defaultSearchMode);
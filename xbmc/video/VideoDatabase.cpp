@@ -5792,6 +5792,57 @@ bool CVideoDatabase::GetPlayCounts(const std::string &strPath, CFileItemList &it
   return false;
 }
 
+bool CVideoDatabase::GetPlayCountsAndResumePoints(const std::string& strPath,
+                                                  std::map<std::string, int>& playCounts,
+                                                  std::map<std::string, CBookmark>& resumePoints)
+{
+  try
+  {
+    if (nullptr == m_pDB)
+      return false;
+    if (nullptr == m_pDS)
+      return false;
+
+    const std::string sql = PrepareSQL(
+      "SELECT"
+      "  path.strPath, files.strFilename, files.playCount,"
+      "  bookmark.timeInSeconds, bookmark.totalTimeInSeconds, bookmark.playerState "
+      "FROM files"
+      "  INNER JOIN path ON"
+      "    files.idPath = path.idPath"
+      "  LEFT JOIN bookmark ON"
+      "    files.idFile = bookmark.idFile AND bookmark.type = %i "
+      "WHERE path.strPath LIKE '%s%%'", (int)CBookmark::RESUME, strPath.c_str());
+
+    if (!m_pDS->query(sql))
+      return false;
+
+    while (!m_pDS->eof())
+    {
+      std::string path;
+      ConstructPath(path, m_pDS->fv(0).get_asString(), m_pDS->fv(1).get_asString());
+      playCounts[path] = m_pDS->fv(2).get_asInt();
+
+      if (!m_pDS->fv(3).get_isNull())
+      {
+        CBookmark& resumePoint = resumePoints[path];
+        resumePoint.timeInSeconds = m_pDS->fv(3).get_asDouble();
+        resumePoint.totalTimeInSeconds = m_pDS->fv(4).get_asDouble();
+        resumePoint.playerState = m_pDS->fv(5).get_asString();
+        resumePoint.type = CBookmark::RESUME;
+      }
+      m_pDS->next();
+    }
+    m_pDS->close();
+    return true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s failed", __FUNCTION__);
+  }
+  return false;
+}
+
 int CVideoDatabase::GetPlayCount(int iFileId)
 {
   if (iFileId < 0)
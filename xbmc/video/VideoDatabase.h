@@ -15,6 +15,7 @@
 #include "utils/SortUtils.h"
 #include "video/VideoDbUrl.h"
 
+#include <map>
 #include <memory>
 #include <set>
 #include <utility>
@@ -471,6 +472,16 @@ public:
    */
   bool GetPlayCounts(const std::string &path, CFileItemList &items);
 
+  /*! \brief Get the playcounts and resume points of all files below a path in a single query
+   \param path the path, matched as prefix of the paths of the files
+   \param playCounts the playcounts of the files, by file path
+   \param resumePoints the resume points of the files that have one, by file path
+   \sa GetPlayCount, GetResumeBookMark, GetPlayCounts
+   */
+  bool GetPlayCountsAndResumePoints(const std::string& path,
+                                    std::map<std::string, int>& playCounts,
+                                    std::map<std::string, CBookmark>& resumePoints);
+
   void UpdateMovieTitle(int idMovie, const std::string& strNewMovieTitle, VIDEODB_CONTENT_TYPE iType=VIDEODB_CONTENT_MOVIES);
   bool UpdateVideoSortTitle(int idDb, const std::string& strNewSortTitle, VIDEODB_CONTENT_TYPE iType = VIDEODB_CONTENT_MOVIES);
 
@@ -41,6 +41,36 @@
 using namespace XFILE;
 using namespace VIDEO;
 
+namespace
+{
+bool IsExtractionSupported(const CFileItem& item)
+{
+  if (item.IsLiveTV()
+  // Due to a pvr addon api design flaw (no support for multiple concurrent streams
+  // per addon instance), pvr recording thumbnail extraction does not work (reliably).
+  ||  URIUtils::IsPVRRecording(item.GetDynPath())
+  ||  URIUtils::IsUPnP(item.GetPath())
+  ||  URIUtils::IsBluray(item.GetPath())
+  ||  item.IsBDFile()
+  ||  item.IsDVD()
+  ||  item.IsDiscImage()
+  ||  item.IsDVDFile(false, true)
+  ||  item.IsInternetStream()
+  ||  item.IsDiscStub()
+  ||  item.IsPlayList())
+    return false;
+
+  // For HTTP/FTP we only allow extraction when on a LAN
+  if (URIUtils::IsRemote(item.GetPath()) &&
+     !URIUtils::IsOnLAN(item.GetPath())  &&
+     (URIUtils::IsFTP(item.GetPath())    ||
+      URIUtils::IsHTTP(item.GetPath())))
+    return false;
+
+  return true;
+}
+} // namespace
+
 CThumbExtractor::CThumbExtractor(const CFileItem& item,
                                  const std::string& listpath,
                                  bool thumb,
@@ -78,26 +108,7 @@ bool CThumbExtractor::operator==(const CJob* job) const
 
 bool CThumbExtractor::DoWork()
 {
-  if (m_item.IsLiveTV()
-  // Due to a pvr addon api design flaw (no support for multiple concurrent streams
-  // per addon instance), pvr recording thumbnail extraction does not work (reliably).
-  ||  URIUtils::IsPVRRecording(m_item.GetDynPath())
-  ||  URIUtils::IsUPnP(m_item.GetPath())
-  ||  URIUtils::IsBluray(m_item.GetPath())
-  ||  m_item.IsBDFile()
-  ||  m_item.IsDVD()
-  ||  m_item.IsDiscImage()
-  ||  m_item.IsDVDFile(false, true)
-  ||  m_item.IsInternetStream()
-  ||  m_item.IsDiscStub()
-  ||  m_item.IsPlayList())
-    return false;
-
-  // For HTTP/FTP we only allow extraction when on a LAN
-  if (URIUtils::IsRemote(m_item.GetPath()) &&
-     !URIUtils::IsOnLAN(m_item.GetPath())  &&
-     (URIUtils::IsFTP(m_item.GetPath())    ||
-      URIUtils::IsHTTP(m_item.GetPath())))
+  if (!IsExtractionSupported(m_item))
     return false;
 
   bool result=false;
@@ -174,6 +185,50 @@ bool CThumbExtractor::DoWork()
   return false;
 }
 
+CThumbBatchExtractor::CThumbBatchExtractor(const CFileItem& item,
+                                           const std::vector<std::pair<int64_t, std::string>>& targets)
+  : m_item(item), m_targets(targets)
+{
+}
+
+bool CThumbBatchExtractor::operator==(const CJob* job) const
+{
+  if (strcmp(job->GetType(), GetType()) == 0)
+  {
+    const CThumbBatchExtractor* jobExtract = dynamic_cast<const CThumbBatchExtractor*>(job);
+    if (jobExtract && jobExtract->m_item.GetPath() == m_item.GetPath() &&
+        jobExtract->m_targets == m_targets)
+      return true;
+  }
+  return false;
+}
+
+bool CThumbBatchExtractor::DoWork()
+{
+  if (m_targets.empty() || !IsExtractionSupported(m_item))
+    return false;
+
+  CLog::Log(LOGDEBUG, "%s - trying to extract %u thumbs from video file %s", __FUNCTION__,
+            static_cast<unsigned int>(m_targets.size()), CURL::GetRedacted(m_item.GetPath()).c_str());
+
+  std::vector<CDVDFileInfo::ThumbRequest> requests(m_targets.size());
+  for (size_t i = 0; i < m_targets.size(); ++i)
+  {
+    requests[i].pos = m_targets[i].first;
+    requests[i].details.file = CTextureCache::GetCacheFile(m_targets[i].second) + ".jpg";
+  }
+
+  if (CDVDFileInfo::ExtractThumbs(m_item, requests) == 0)
+    return false;
+
+  for (size_t i = 0; i < m_targets.size(); ++i)
+  {
+    if (requests[i].extracted)
+      CTextureCache::GetInstance().AddCachedTexture(m_targets[i].second, requests[i].details);
+  }
+  return true;
+}
+
 CVideoThumbLoader::CVideoThumbLoader() :
   CThumbLoader(), CJobQueue(true, 1, CJob::PRIORITY_LOW_PAUSABLE)
 {
@@ -56,6 +56,35 @@ public:
   bool m_fillStreamDetails; ///< fill in stream details?
 };
 
+/*!
+ \ingroup thumbs,jobs
+ \brief Job extracting thumbs at several positions of a video file
+
+ The file is opened once and all positions are decoded in a single pass, e.g. for chapter thumbs.
+ */
+class CThumbBatchExtractor : public CJob
+{
+public:
+  CThumbBatchExtractor(const CFileItem& item,
+                       const std::vector<std::pair<int64_t, std::string>>& targets);
+  ~CThumbBatchExtractor() override = default;
+
+  /*!
+   \brief Work function that extracts the thumbs.
+   */
+  bool DoWork() override;
+
+  const char* GetType() const override
+  {
+    return kJobTypeMediaFlags;
+  }
+
+  bool operator==(const CJob* job) const override;
+
+  CFileItem m_item;
+  std::vector<std::pair<int64_t, std::string>> m_targets; ///< positions in ms and thumbpaths
+};
+
 class CVideoThumbLoader : public CThumbLoader, public CJobQueue
 {
 public:
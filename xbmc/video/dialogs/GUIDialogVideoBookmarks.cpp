@@ -261,6 +261,8 @@ void CGUIDialogVideoBookmarks::OnRefreshList()
   }
 
   // add chapters if around
+  std::vector<std::pair<int64_t, std::string>> chapterThumbs;
+  std::vector<unsigned int> chapterThumbIndexes;
   for (int i = 1; i <= g_application.GetAppPlayer().GetChapterCount(); ++i)
   {
     std::string chapterName;
@@ -283,10 +285,8 @@ void CGUIDialogVideoBookmarks::OnRefreshList()
       item->SetArt("thumb", cachefile);
     else if (i > m_jobsStarted && CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(CSettings::SETTING_MYVIDEOS_EXTRACTCHAPTERTHUMBS))
     {
-      CFileItem item(m_filePath, false);
-      CJob* job = new CThumbExtractor(item, m_filePath, true, chapterPath, pos * 1000, false);
-      AddJob(job);
-      m_mapJobsChapter[job] = i;
+      chapterThumbs.emplace_back(pos * 1000, chapterPath);
+      chapterThumbIndexes.push_back(i);
       m_jobsStarted++;
     }
 
@@ -296,6 +296,15 @@ void CGUIDialogVideoBookmarks::OnRefreshList()
     items.push_back(item);
   }
 
+  // extract all missing chapter thumbs in one pass over the file
+  if (!chapterThumbs.empty())
+  {
+    CJob* job = new CThumbBatchExtractor(CFileItem(m_filePath, false), chapterThumbs);
+    m_mapJobsChapter[job] = chapterThumbIndexes;
+    if (!AddJob(job))
+      m_mapJobsChapter.erase(job);
+  }
+
   // sort items by resume point
   std::sort(items.begin(), items.end(), [](const CFileItemPtr &item1, const CFileItemPtr &item2) {
     return item1->GetProperty("resumepoint").asDouble() < item2->GetProperty("resumepoint").asDouble();
@@ -565,9 +574,11 @@ void CGUIDialogVideoBookmarks::OnJobComplete(unsigned int jobID,
     MAPJOBSCHAPS::iterator iter = m_mapJobsChapter.find(job);
     if (iter != m_mapJobsChapter.end())
     {
-      unsigned int chapterIdx = (*iter).second;
-      CGUIMessage m(GUI_MSG_REFRESH_LIST, GetID(), 0, 1, chapterIdx);
-      CApplicationMessenger::GetInstance().SendGUIMessage(m);
+      for (unsigned int chapterIdx : iter->second)
+      {
+        CGUIMessage m(GUI_MSG_REFRESH_LIST, GetID(), 0, 1, chapterIdx);
+        CApplicationMessenger::GetInstance().SendGUIMessage(m);
+      }
       m_mapJobsChapter.erase(iter);
     }
   }